@@ -0,0 +1,205 @@
+#include "AlooCaptiveDns.h"
+#include "AlooLog.h"
+#include <lwip/sockets.h>
+#include <string.h>
+
+static const char TAG[] = "CaptiveDns";
+
+//--------------------------------------------------------------------------
+// DNS Wire Format
+//--------------------------------------------------------------------------
+namespace {
+
+const size_t DNS_HEADER_SIZE = 12;
+
+// Header flag bytes of an answer.
+const uint8_t FLAG_QR = 0x80;   // Byte 2: response
+const uint8_t FLAG_AA = 0x04;   // Byte 2: authoritative
+const uint8_t FLAG_RD = 0x01;   // Byte 2: recursion desired, echoed
+const uint8_t FLAG_RA = 0x80;   // Byte 3: recursion available
+
+const uint8_t RCODE_NOERROR = 0;
+const uint8_t RCODE_NXDOMAIN = 3;
+const uint8_t RCODE_NOTIMP = 4;
+
+const uint16_t QTYPE_A = 1;
+const uint16_t QTYPE_AAAA = 28;
+const uint16_t QTYPE_SVCB = 64;
+const uint16_t QTYPE_HTTPS = 65;
+
+// Returns the offset just past an uncompressed question name, or 0 if malformed.
+size_t skipQuestionName(const uint8_t* buf, size_t length, size_t pos) {
+  while (pos < length) {
+    uint8_t n = buf[pos];
+    if (n == 0) return pos + 1;
+    if (n & 0xC0) return 0;  // Queries do not compress the question
+    pos += n + 1;
+  }
+  return 0;
+}
+
+WiFiDnsQueryType queryType(uint16_t qtype) {
+  switch (qtype) {
+    case QTYPE_A: return WiFiDnsQueryType::A;
+    case QTYPE_AAAA: return WiFiDnsQueryType::AAAA;
+    case QTYPE_SVCB:
+    case QTYPE_HTTPS: return WiFiDnsQueryType::HTTPS;
+    default: return WiFiDnsQueryType::OTHER;
+  }
+}
+
+}  // namespace
+
+//--------------------------------------------------------------------------
+// AlooCaptiveDns
+//--------------------------------------------------------------------------
+
+AlooCaptiveDns::AlooCaptiveDns()
+  : _fd(-1),
+    _answer{},
+    _windowStart(0),
+    _windowQueries(0),
+    _lastSecond(0),
+    _peakPerSecond(0) {}
+
+AlooCaptiveDns::~AlooCaptiveDns() {
+  stop();
+}
+
+bool AlooCaptiveDns::start(const IPAddress& ip, uint16_t port) {
+  stop();
+  // The answer record is the same for every query: a pointer to the question
+  // name at offset 12, type A, class IN, the TTL, and the address.
+  static const uint8_t prefix[] = {
+    0xC0, 0x0C, 0x00, 0x01, 0x00, 0x01,
+    (uint8_t)(ALOO_DNS_TTL >> 24), (uint8_t)(ALOO_DNS_TTL >> 16), (uint8_t)(ALOO_DNS_TTL >> 8), (uint8_t)ALOO_DNS_TTL,
+    0x00, 0x04
+  };
+  memcpy(_answer, prefix, sizeof(prefix));
+  for (size_t i = 0; i < 4; i++) _answer[sizeof(prefix) + i] = ip[i];
+
+  int fd = socket(AF_INET, SOCK_DGRAM, 0);
+  if (fd < 0) {
+    ALOO_LOGE(TAG, "Failed to open the DNS socket (%d).", errno);
+    return false;
+  }
+  struct sockaddr_in local = {};
+  local.sin_family = AF_INET;
+  local.sin_port = htons(port);
+  local.sin_addr.s_addr = htonl(INADDR_ANY);
+  if (bind(fd, (struct sockaddr*)&local, sizeof(local)) != 0) {
+    ALOO_LOGE(TAG, "Failed to bind port %u (%d).", (unsigned)port, errno);
+    close(fd);
+    return false;
+  }
+  // serve() waits in select(); reads must not block once the queue is drained.
+  fcntl(fd, F_SETFL, fcntl(fd, F_GETFL, 0) | O_NONBLOCK);
+  _fd = fd;
+  _windowStart = millis();
+  _windowQueries = 0;
+  return true;
+}
+
+void AlooCaptiveDns::stop() {
+  if (_fd < 0) return;
+  close(_fd);
+  _fd = -1;
+  _lastSecond = 0;
+}
+
+size_t AlooCaptiveDns::serve(uint32_t timeoutMs) {
+  if (_fd < 0) {
+    delay(timeoutMs);
+    return 0;
+  }
+  fd_set readSet;
+  FD_ZERO(&readSet);
+  FD_SET(_fd, &readSet);
+  struct timeval timeout;
+  timeout.tv_sec = timeoutMs / 1000;
+  timeout.tv_usec = (timeoutMs % 1000) * 1000;
+
+  size_t answered = 0;
+  if (select(_fd + 1, &readSet, nullptr, nullptr, &timeout) > 0) {
+    // Drain the whole queue before sleeping again.
+    for (;;) {
+      struct sockaddr_in from;
+      socklen_t fromLength = sizeof(from);
+      int length = recvfrom(_fd, _packet, sizeof(_packet), 0, (struct sockaddr*)&from, &fromLength);
+      if (length <= 0) break;
+      size_t responseLength = respond((size_t)length);
+      if (!responseLength) {
+        _dropped.increment();
+        continue;
+      }
+      sendto(_fd, _packet, responseLength, 0, (struct sockaddr*)&from, fromLength);
+      answered++;
+    }
+  }
+  rollWindow(answered);
+  return answered;
+}
+
+/**
+ * @brief Turns the query in _packet into its answer, in place.
+ * @return Length of the answer, or 0 to drop the packet.
+ */
+size_t AlooCaptiveDns::respond(size_t length) {
+  uint8_t* p = _packet;
+  if (length < DNS_HEADER_SIZE || (p[2] & FLAG_QR)) return 0;
+  uint8_t opcode = (p[2] >> 3) & 0x0F;
+  uint16_t questions = (uint16_t)((p[4] << 8) | p[5]);
+
+  size_t end = 0;
+  uint16_t qtype = 0;
+  uint8_t rcode = RCODE_NOTIMP;
+  if (opcode == 0 && questions == 1) {
+    end = skipQuestionName(p, length, DNS_HEADER_SIZE);
+    if (!end || end + 4 > length) return 0;
+    qtype = (uint16_t)((p[end] << 8) | p[end + 1]);
+    end += 4;
+    WiFiDnsQueryType type = queryType(qtype);
+    _queries[(size_t)type].increment();
+    rcode = type == WiFiDnsQueryType::OTHER ? RCODE_NXDOMAIN : RCODE_NOERROR;
+  } else if (opcode != 0) {
+    // Answer with the header alone; anything after it is dropped.
+    end = DNS_HEADER_SIZE;
+    questions = 0;
+  } else {
+    return 0;
+  }
+
+  p[2] = FLAG_QR | FLAG_AA | (p[2] & (FLAG_RD | 0x78));
+  p[3] = FLAG_RA | rcode;
+  p[4] = 0;
+  p[5] = (uint8_t)questions;
+  // Answer, authority and additional counts; EDNS records are not echoed.
+  memset(p + 6, 0, 6);
+  if (qtype != QTYPE_A || rcode != RCODE_NOERROR) return end;
+  if (end + ANSWER_SIZE > MAX_PACKET) return 0;
+  memcpy(p + end, _answer, ANSWER_SIZE);
+  p[7] = 1;
+  return end + ANSWER_SIZE;
+}
+
+void AlooCaptiveDns::rollWindow(size_t answered) {
+  _windowQueries += answered;
+  uint32_t now = millis();
+  uint32_t elapsed = now - _windowStart;
+  if (elapsed < 1000) return;
+  // A window that ran much longer than a second saw no traffic at its end.
+  uint32_t rate = elapsed < 2000 ? _windowQueries : 0;
+  _lastSecond = rate;
+  if (rate > _peakPerSecond) _peakPerSecond = rate;
+  _windowStart = now;
+  _windowQueries = 0;
+}
+
+WiFiCaptiveDnsStats AlooCaptiveDns::stats() const {
+  WiFiCaptiveDnsStats out;
+  for (size_t i = 0; i < (size_t)WiFiDnsQueryType::COUNT; i++) out.queries[i] = _queries[i].value();
+  out.dropped = _dropped.value();
+  out.lastSecond = _lastSecond;
+  out.peakPerSecond = _peakPerSecond;
+  return out;
+}
@@ -0,0 +1,88 @@
+#ifndef ALOO_CAPTIVE_DNS_H
+#define ALOO_CAPTIVE_DNS_H
+
+#include <Arduino.h>
+#include <atomic>
+#include "AlooMetrics.h"
+
+// TTL of the captive A answer, in seconds.
+#ifndef ALOO_DNS_TTL
+#define ALOO_DNS_TTL 60
+#endif
+
+//========================================================================
+// Query Types and Statistics
+//========================================================================
+enum class WiFiDnsQueryType : uint8_t {
+  A,        // Answered with the portal address
+  AAAA,     // Answered empty (NOERROR, no records), so the client falls back to A at once
+  HTTPS,    // HTTPS/SVCB records, answered empty
+  OTHER,    // Answered NXDOMAIN
+  COUNT
+};
+
+struct WiFiCaptiveDnsStats {
+  uint32_t queries[(size_t)WiFiDnsQueryType::COUNT];
+  uint32_t dropped;          // Malformed packets and non-query opcodes
+  uint32_t lastSecond;       // Queries answered in the last full second
+  uint32_t peakPerSecond;    // Highest lastSecond seen since construction
+};
+
+//========================================================================
+// AlooCaptiveDns
+//========================================================================
+/**
+ * @brief Captive-portal DNS responder.
+ *
+ * Every name resolves to the portal address. serve() blocks on the socket
+ * until a query arrives, then answers every queued query before it returns,
+ * so a phone's burst of connectivity-check lookups is answered in one wake-up
+ * instead of one packet per poll. An answer is the query itself with its
+ * header flags and counts patched and, for A queries, a prebuilt answer
+ * record appended; nothing is parsed beyond the question.
+ *
+ * start(), stop() and serve() are meant for one task at a time (the caller
+ * parks the serving task around start/stop); stats() may be called from any
+ * task.
+ */
+class AlooCaptiveDns {
+public:
+  AlooCaptiveDns();
+  ~AlooCaptiveDns();
+
+  /**
+   * @brief Opens the UDP socket and builds the answer for ip.
+   * @return false (and a logged error) if the socket could not be bound.
+   */
+  bool start(const IPAddress& ip, uint16_t port = 53);
+  void stop();
+  bool isRunning() const { return _fd >= 0; }
+
+  /**
+   * @brief Waits up to timeoutMs for a query, then answers all queued queries.
+   * @return Number of queries answered.
+   */
+  size_t serve(uint32_t timeoutMs);
+
+  WiFiCaptiveDnsStats stats() const;
+
+private:
+  static const size_t MAX_PACKET = 512;
+  static const size_t ANSWER_SIZE = 16;
+
+  int _fd;
+  uint8_t _answer[ANSWER_SIZE];     // Name pointer, type, class, TTL, length and address
+  uint8_t _packet[MAX_PACKET];
+
+  AlooCounter _queries[(size_t)WiFiDnsQueryType::COUNT];
+  AlooCounter _dropped;
+  uint32_t _windowStart;            // millis() when the current one-second window began
+  uint32_t _windowQueries;
+  std::atomic<uint32_t> _lastSecond;
+  std::atomic<uint32_t> _peakPerSecond;
+
+  size_t respond(size_t length);
+  void rollWindow(size_t answered);
+};
+
+#endif // ALOO_CAPTIVE_DNS_H
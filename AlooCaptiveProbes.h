@@ -0,0 +1,72 @@
+#ifndef ALOO_CAPTIVE_PROBES_H
+#define ALOO_CAPTIVE_PROBES_H
+
+#include "AlooWifiManager.h"
+
+//========================================================================
+// Captive Portal Probe Routes
+//========================================================================
+// Connectivity checks that operating systems send right after joining a
+// network. Any answer other than the expected one makes the OS open its
+// captive portal window, so all of them get the same prebuilt redirect; the
+// table only needs to recognise a probe and tell which OS sent it.
+//
+// Routes are keyed on an FNV-1a hash of the lowercased host followed by the
+// path, computed at compile time, and a hash hit is confirmed against the
+// stored strings. The WebServer picks a handler before it reads the Host
+// header, so the path alone decides whether a request is a probe; host and
+// path together then identify the OS. Probes for "/" are left out: they
+// already land on the portal page.
+
+constexpr uint32_t captiveHashStep(uint32_t hash, const char* s) {
+  return *s ? captiveHashStep((hash ^ (uint8_t)(*s >= 'A' && *s <= 'Z' ? *s + 32 : *s)) * 16777619u, s + 1) : hash;
+}
+
+constexpr uint32_t captivePathHash(const char* path) {
+  return captiveHashStep(2166136261u, path);
+}
+
+constexpr uint32_t captiveProbeHash(const char* host, const char* path) {
+  return captiveHashStep(captiveHashStep(2166136261u, host), path);
+}
+
+struct CaptiveProbeRoute {
+  uint32_t hash;       // captiveProbeHash(host, path)
+  uint32_t pathHash;   // captivePathHash(path)
+  const char* host;
+  const char* path;
+  WiFiProbeOs os;
+};
+
+#define ALOO_CAPTIVE_PROBE(host, path, os) \
+  { captiveProbeHash(host, path), captivePathHash(path), host, path, WiFiProbeOs::os }
+
+static const CaptiveProbeRoute captiveProbeRoutes[] = {
+  // Apple (iOS, macOS)
+  ALOO_CAPTIVE_PROBE("captive.apple.com", "/hotspot-detect.html", APPLE),
+  ALOO_CAPTIVE_PROBE("www.apple.com", "/library/test/success.html", APPLE),
+  ALOO_CAPTIVE_PROBE("captive.apple.com", "/library/test/success.html", APPLE),
+  // Android
+  ALOO_CAPTIVE_PROBE("connectivitycheck.gstatic.com", "/generate_204", ANDROID),
+  ALOO_CAPTIVE_PROBE("connectivitycheck.android.com", "/generate_204", ANDROID),
+  ALOO_CAPTIVE_PROBE("clients1.google.com", "/generate_204", ANDROID),
+  ALOO_CAPTIVE_PROBE("play.googleapis.com", "/generate_204", ANDROID),
+  ALOO_CAPTIVE_PROBE("www.google.com", "/gen_204", ANDROID),
+  ALOO_CAPTIVE_PROBE("connectivity.samsung.com.cn", "/generate_204", ANDROID),
+  // ChromeOS and Chrome
+  ALOO_CAPTIVE_PROBE("clients3.google.com", "/generate_204", CHROMEOS),
+  ALOO_CAPTIVE_PROBE("www.gstatic.com", "/generate_204", CHROMEOS),
+  ALOO_CAPTIVE_PROBE("google.com", "/generate_204", CHROMEOS),
+  // Windows
+  ALOO_CAPTIVE_PROBE("www.msftconnecttest.com", "/connecttest.txt", WINDOWS),
+  ALOO_CAPTIVE_PROBE("ipv6.msftconnecttest.com", "/connecttest.txt", WINDOWS),
+  ALOO_CAPTIVE_PROBE("www.msftconnecttest.com", "/redirect", WINDOWS),
+  ALOO_CAPTIVE_PROBE("www.msftncsi.com", "/ncsi.txt", WINDOWS),
+  // Firefox
+  ALOO_CAPTIVE_PROBE("detectportal.firefox.com", "/success.txt", FIREFOX),
+  ALOO_CAPTIVE_PROBE("detectportal.firefox.com", "/canonical.html", FIREFOX),
+};
+
+#undef ALOO_CAPTIVE_PROBE
+
+#endif // ALOO_CAPTIVE_PROBES_H
@@ -0,0 +1,139 @@
+#ifndef ALOO_JSON_WRITER_H
+#define ALOO_JSON_WRITER_H
+
+#include <Arduino.h>
+
+//========================================================================
+// AlooJsonWriter
+//========================================================================
+/**
+ * @brief Minimal streaming JSON writer over a caller-provided buffer.
+ *
+ * Output is accumulated in the fixed buffer and handed to the flush callback
+ * whenever it fills up (and on flush()), so arbitrarily long documents are
+ * produced without any heap allocation. Without a flush callback the output
+ * is truncated at capacity and can be read back through data()/length().
+ * Strings are escaped per RFC 8259.
+ * Commas are inserted automatically; nesting depth is limited to 32.
+ */
+class AlooJsonWriter {
+public:
+  typedef void (*FlushCallback)(void* context, const char* data, size_t length);
+
+  AlooJsonWriter(char* buffer, size_t capacity, FlushCallback flush, void* context)
+    : _buffer(buffer), _capacity(capacity), _length(0), _flush(flush), _context(context),
+      _depth(0), _hasItems(0), _afterKey(false) {}
+
+  ~AlooJsonWriter() { flush(); }
+
+  void beginObject() { separator(); put('{'); push(); }
+  void endObject()   { pop(); put('}'); }
+  void beginArray()  { separator(); put('['); push(); }
+  void endArray()    { pop(); put(']'); }
+
+  void key(const char* name) {
+    separator();
+    writeString(name);
+    put(':');
+    _afterKey = true;
+  }
+
+  void value(const char* str)      { separator(); writeString(str); }
+  void value(bool b)               { separator(); write(b ? "true" : "false"); }
+  void value(int number)           { writeSigned(number); }
+  void value(long number)          { writeSigned(number); }
+  void value(unsigned number)      { writeUnsigned(number); }
+  void value(unsigned long number) { writeUnsigned(number); }
+
+  const char* data() const { return _buffer; }
+  size_t length() const { return _length; }
+
+  /**
+   * @brief Hands buffered output to the flush callback.
+   */
+  void flush() {
+    if (!_flush) return;
+    if (_length) _flush(_context, _buffer, _length);
+    _length = 0;
+  }
+
+private:
+  char* _buffer;
+  size_t _capacity;
+  size_t _length;
+  FlushCallback _flush;
+  void* _context;
+  uint8_t _depth;
+  uint32_t _hasItems;  // Bit n set once the container at depth n has an element
+  bool _afterKey;
+
+  void push() {
+    _depth++;
+    _hasItems &= ~(1UL << (_depth & 31));
+  }
+  void pop() {
+    if (_depth) _depth--;
+  }
+
+  // Emits the comma between container elements (values directly after a key take none).
+  void separator() {
+    if (_afterKey) {
+      _afterKey = false;
+      return;
+    }
+    uint32_t bit = 1UL << (_depth & 31);
+    if (_depth && (_hasItems & bit)) put(',');
+    _hasItems |= bit;
+  }
+
+  void put(char c) {
+    if (_length == _capacity) {
+      if (!_flush) return;
+      flush();
+    }
+    _buffer[_length++] = c;
+  }
+  void write(const char* str) {
+    while (*str) put(*str++);
+  }
+  void write(const char* str, int length) {
+    for (int i = 0; i < length; i++) put(str[i]);
+  }
+
+  void writeSigned(long number) {
+    char digits[21];
+    separator();
+    write(digits, snprintf(digits, sizeof(digits), "%ld", number));
+  }
+  void writeUnsigned(unsigned long number) {
+    char digits[21];
+    separator();
+    write(digits, snprintf(digits, sizeof(digits), "%lu", number));
+  }
+
+  void writeString(const char* str) {
+    static const char hex[] = "0123456789abcdef";
+    put('"');
+    for (; *str; str++) {
+      uint8_t c = (uint8_t)*str;
+      switch (c) {
+        case '"':  put('\\'); put('"'); break;
+        case '\\': put('\\'); put('\\'); break;
+        case '\n': put('\\'); put('n'); break;
+        case '\r': put('\\'); put('r'); break;
+        case '\t': put('\\'); put('t'); break;
+        default:
+          if (c < 0x20) {
+            write("\\u00");
+            put(hex[c >> 4]);
+            put(hex[c & 0x0F]);
+          } else {
+            put((char)c);
+          }
+      }
+    }
+    put('"');
+  }
+};
+
+#endif // ALOO_JSON_WRITER_H
@@ -0,0 +1,209 @@
+#include "AlooLog.h"
+#include <stdarg.h>
+
+//--------------------------------------------------------------------------
+// Ring Buffer State
+//--------------------------------------------------------------------------
+// Each slot carries a sequence word: 2*seq+1 while record seq is being
+// written, 2*seq+2 once it is published. Producers claim a sequence with one
+// fetch_add on the head; the drain task is the only consumer and owns the tail.
+namespace {
+
+struct LogSlot {
+  std::atomic<uint32_t> state;
+  AlooLogRecord record;
+};
+
+LogSlot logSlots[ALOO_LOG_RING_SLOTS];
+std::atomic<uint32_t> logHead(0);
+uint32_t logTail = 0;
+std::atomic<uint32_t> logDropped(0);
+std::atomic<bool> logDraining(false);
+
+AlooSerialLogSink defaultSerialSink(Serial);
+AlooLogSink* logSinks[ALOO_LOG_MAX_SINKS] = { &defaultSerialSink };
+TaskHandle_t drainTaskHandle = nullptr;
+#ifdef ALOO_WM_STATIC_ALLOCATION
+StaticTask_t drainTaskStorage;
+StackType_t drainTaskStack[ALOO_LOG_TASK_STACK_SIZE / sizeof(StackType_t)];
+#endif
+
+const char LEVEL_LETTERS[] = "-EWIDV";
+
+}  // namespace
+
+//--------------------------------------------------------------------------
+// AlooLog
+//--------------------------------------------------------------------------
+
+void AlooLog::begin(UBaseType_t priority, BaseType_t core) {
+  if (drainTaskHandle) return;
+#ifdef ALOO_WM_STATIC_ALLOCATION
+  drainTaskHandle = xTaskCreateStaticPinnedToCore(drainTask, "AlooLogTask", ALOO_LOG_TASK_STACK_SIZE, nullptr,
+                                                  priority, drainTaskStack, &drainTaskStorage, core);
+#else
+  BaseType_t result = xTaskCreatePinnedToCore(drainTask, "AlooLogTask", ALOO_LOG_TASK_STACK_SIZE, nullptr,
+                                              priority, &drainTaskHandle, core);
+  if (result != pdPASS) {
+    drainTaskHandle = nullptr;
+  }
+#endif
+}
+
+void AlooLog::write(uint8_t level, const char* tag, const char* format, ...) {
+  uint32_t seq = logHead.fetch_add(1, std::memory_order_relaxed);
+  LogSlot& slot = logSlots[seq % ALOO_LOG_RING_SLOTS];
+  slot.state.store(2 * seq + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+
+  AlooLogRecord& record = slot.record;
+  record.timestampMs = millis();
+  record.level = level;
+  record.tag = tag;
+  va_list args;
+  va_start(args, format);
+  int n = vsnprintf(record.text, sizeof(record.text), format, args);
+  va_end(args);
+  size_t length = n < 0 ? 0 : min((size_t)n, sizeof(record.text) - 1);
+  // Lines are terminated by the sinks.
+  while (length && (record.text[length - 1] == '\n' || record.text[length - 1] == '\r')) length--;
+  record.text[length] = '\0';
+  record.length = length;
+
+  slot.state.store(2 * seq + 2, std::memory_order_release);
+  if (drainTaskHandle) xTaskNotifyGive(drainTaskHandle);
+}
+
+bool AlooLog::addSink(AlooLogSink* sink) {
+  for (size_t i = 0; i < ALOO_LOG_MAX_SINKS; i++) {
+    if (logSinks[i] == sink) return true;
+  }
+  for (size_t i = 0; i < ALOO_LOG_MAX_SINKS; i++) {
+    if (!logSinks[i]) {
+      logSinks[i] = sink;
+      return true;
+    }
+  }
+  return false;
+}
+
+void AlooLog::removeSink(AlooLogSink* sink) {
+  for (size_t i = 0; i < ALOO_LOG_MAX_SINKS; i++) {
+    if (logSinks[i] == sink) logSinks[i] = nullptr;
+  }
+}
+
+AlooSerialLogSink& AlooLog::serialSink() {
+  return defaultSerialSink;
+}
+
+void AlooLog::flush() {
+  drain();
+}
+
+uint32_t AlooLog::droppedCount() {
+  return logDropped.load(std::memory_order_relaxed);
+}
+
+void AlooLog::drainTask(void* param) {
+  for (;;) {
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    drain();
+  }
+}
+
+/**
+ * @brief Hands every published record to the sinks. A record still being
+ *        written ends the pass; the producer's notification starts the next.
+ */
+void AlooLog::drain() {
+  // Serialize the drain task with flush() callers.
+  bool expected = false;
+  while (!logDraining.compare_exchange_weak(expected, true, std::memory_order_acquire)) {
+    expected = false;
+    vTaskDelay(1);
+  }
+
+  AlooLogRecord record;
+  for (;;) {
+    uint32_t head = logHead.load(std::memory_order_acquire);
+    if (logTail == head) break;
+    if (head - logTail > ALOO_LOG_RING_SLOTS) {
+      // Producers lapped the reader; the oldest records are gone.
+      logDropped.fetch_add(head - ALOO_LOG_RING_SLOTS - logTail, std::memory_order_relaxed);
+      logTail = head - ALOO_LOG_RING_SLOTS;
+    }
+
+    LogSlot& slot = logSlots[logTail % ALOO_LOG_RING_SLOTS];
+    uint32_t published = 2 * logTail + 2;
+    uint32_t state = slot.state.load(std::memory_order_acquire);
+    if ((int32_t)(state - published) < 0) break;  // Claimed but not yet written
+    if (state == published) {
+      memcpy(&record, &slot.record, sizeof(record));
+      std::atomic_thread_fence(std::memory_order_acquire);
+      state = slot.state.load(std::memory_order_relaxed);
+    }
+    logTail++;
+    if (state != published) {
+      // Overwritten by a newer record while we were reading.
+      logDropped.fetch_add(1, std::memory_order_relaxed);
+      continue;
+    }
+    for (size_t i = 0; i < ALOO_LOG_MAX_SINKS; i++) {
+      AlooLogSink* sink = logSinks[i];
+      if (sink) sink->write(record);
+    }
+  }
+
+  logDraining.store(false, std::memory_order_release);
+}
+
+//--------------------------------------------------------------------------
+// Sinks
+//--------------------------------------------------------------------------
+
+void AlooSerialLogSink::write(const AlooLogRecord& record) {
+  _out.printf("[%6lu][%c][%s] %s\r\n", (unsigned long)record.timestampMs,
+              LEVEL_LETTERS[record.level <= ALOO_LOG_LEVEL_VERBOSE ? record.level : 0],
+              record.tag, record.text);
+}
+
+void AlooMemoryLogSink::write(const AlooLogRecord& record) {
+  portENTER_CRITICAL(&_lock);
+  memcpy(&_records[_next], &record, sizeof(record));
+  _next = (_next + 1) % CAPACITY;
+  if (_count < CAPACITY) _count++;
+  portEXIT_CRITICAL(&_lock);
+}
+
+void AlooMemoryLogSink::dump(Print& out) {
+  AlooLogRecord record;
+  for (size_t i = 0; i < CAPACITY; i++) {
+    // Copy one record at a time so the critical section stays short.
+    portENTER_CRITICAL(&_lock);
+    bool valid = i < _count;
+    if (valid) {
+      memcpy(&record, &_records[(_next + CAPACITY - _count + i) % CAPACITY], sizeof(record));
+    }
+    portEXIT_CRITICAL(&_lock);
+    if (!valid) break;
+    out.printf("[%6lu][%c][%s] %s\r\n", (unsigned long)record.timestampMs,
+               LEVEL_LETTERS[record.level <= ALOO_LOG_LEVEL_VERBOSE ? record.level : 0],
+               record.tag, record.text);
+  }
+}
+
+void AlooUdpLogSink::write(const AlooLogRecord& record) {
+  if (WiFi.status() != WL_CONNECTED) return;
+  // Syslog severities for ERROR..VERBOSE; local0 facility (16 * 8).
+  static const uint8_t severities[] = { 7, 3, 4, 6, 7, 7 };
+  uint8_t severity = severities[record.level <= ALOO_LOG_LEVEL_VERBOSE ? record.level : 0];
+  char packet[ALOO_LOG_LINE_MAX + 64];
+  int n = snprintf(packet, sizeof(packet), "<%u>1 - %s %s - - - %s",
+                   128 + severity, _hostname, record.tag, record.text);
+  if (n <= 0) return;
+  if (_udp.beginPacket(_collector, _port)) {
+    _udp.write(reinterpret_cast<const uint8_t*>(packet), min((size_t)n, sizeof(packet) - 1));
+    _udp.endPacket();
+  }
+}
@@ -0,0 +1,191 @@
+#ifndef ALOO_LOG_H
+#define ALOO_LOG_H
+
+#include <Arduino.h>
+#include <WiFi.h>
+#include <WiFiUdp.h>
+#include <atomic>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+//========================================================================
+// Log Levels and Compile-Time Filter
+//========================================================================
+#define ALOO_LOG_LEVEL_NONE    0
+#define ALOO_LOG_LEVEL_ERROR   1
+#define ALOO_LOG_LEVEL_WARN    2
+#define ALOO_LOG_LEVEL_INFO    3
+#define ALOO_LOG_LEVEL_DEBUG   4
+#define ALOO_LOG_LEVEL_VERBOSE 5
+
+// Highest level compiled in. Calls above it expand to nothing, arguments
+// included, so they must not have side effects.
+#ifndef ALOO_WM_LOG_LEVEL
+#define ALOO_WM_LOG_LEVEL ALOO_LOG_LEVEL_INFO
+#endif
+
+// Ring buffer geometry: records queued between a log call and the drain task.
+#ifndef ALOO_LOG_RING_SLOTS
+#define ALOO_LOG_RING_SLOTS 32
+#endif
+#ifndef ALOO_LOG_LINE_MAX
+#define ALOO_LOG_LINE_MAX 96
+#endif
+#ifndef ALOO_LOG_MAX_SINKS
+#define ALOO_LOG_MAX_SINKS 4
+#endif
+#ifndef ALOO_LOG_TASK_STACK_SIZE
+#define ALOO_LOG_TASK_STACK_SIZE 3072
+#endif
+
+#if ALOO_WM_LOG_LEVEL >= ALOO_LOG_LEVEL_ERROR
+#define ALOO_LOGE(tag, format, ...) AlooLog::write(ALOO_LOG_LEVEL_ERROR, tag, format, ##__VA_ARGS__)
+#else
+#define ALOO_LOGE(tag, format, ...) do {} while (0)
+#endif
+#if ALOO_WM_LOG_LEVEL >= ALOO_LOG_LEVEL_WARN
+#define ALOO_LOGW(tag, format, ...) AlooLog::write(ALOO_LOG_LEVEL_WARN, tag, format, ##__VA_ARGS__)
+#else
+#define ALOO_LOGW(tag, format, ...) do {} while (0)
+#endif
+#if ALOO_WM_LOG_LEVEL >= ALOO_LOG_LEVEL_INFO
+#define ALOO_LOGI(tag, format, ...) AlooLog::write(ALOO_LOG_LEVEL_INFO, tag, format, ##__VA_ARGS__)
+#else
+#define ALOO_LOGI(tag, format, ...) do {} while (0)
+#endif
+#if ALOO_WM_LOG_LEVEL >= ALOO_LOG_LEVEL_DEBUG
+#define ALOO_LOGD(tag, format, ...) AlooLog::write(ALOO_LOG_LEVEL_DEBUG, tag, format, ##__VA_ARGS__)
+#else
+#define ALOO_LOGD(tag, format, ...) do {} while (0)
+#endif
+#if ALOO_WM_LOG_LEVEL >= ALOO_LOG_LEVEL_VERBOSE
+#define ALOO_LOGV(tag, format, ...) AlooLog::write(ALOO_LOG_LEVEL_VERBOSE, tag, format, ##__VA_ARGS__)
+#else
+#define ALOO_LOGV(tag, format, ...) do {} while (0)
+#endif
+
+//========================================================================
+// Log Record and Sinks
+//========================================================================
+struct AlooLogRecord {
+  uint32_t timestampMs;     // millis() at the log call
+  uint8_t level;            // ALOO_LOG_LEVEL_*
+  const char* tag;          // Must point to static storage
+  uint16_t length;
+  char text[ALOO_LOG_LINE_MAX];  // Null-terminated, truncated to fit
+};
+
+/**
+ * @brief Destination for drained log records. write() is only ever called
+ *        from the drain task, so sinks need no locking of their own.
+ */
+class AlooLogSink {
+public:
+  virtual ~AlooLogSink() {}
+  virtual void write(const AlooLogRecord& record) = 0;
+};
+
+/**
+ * @brief Prints "[millis][L][tag] text" lines to a Print (Serial by default).
+ */
+class AlooSerialLogSink : public AlooLogSink {
+public:
+  explicit AlooSerialLogSink(Print& out) : _out(out) {}
+  void write(const AlooLogRecord& record) override;
+
+private:
+  Print& _out;
+};
+
+/**
+ * @brief Keeps the most recent records in RAM, e.g. for a diagnostics page or
+ *        a post-mortem dump. dump() may be called from any task.
+ */
+class AlooMemoryLogSink : public AlooLogSink {
+public:
+  static const size_t CAPACITY = 16;
+
+  AlooMemoryLogSink() : _next(0), _count(0), _lock(portMUX_INITIALIZER_UNLOCKED) {}
+  void write(const AlooLogRecord& record) override;
+
+  /**
+   * @brief Prints the retained records, oldest first.
+   */
+  void dump(Print& out);
+
+private:
+  AlooLogRecord _records[CAPACITY];
+  size_t _next;
+  size_t _count;
+  portMUX_TYPE _lock;
+};
+
+/**
+ * @brief Sends each record as an RFC 5424 syslog datagram (facility local0)
+ *        to a collector on the local network. Records are skipped while the
+ *        station is not connected.
+ */
+class AlooUdpLogSink : public AlooLogSink {
+public:
+  AlooUdpLogSink(const IPAddress& collector, uint16_t port = 514, const char* hostname = "esp32")
+    : _collector(collector), _port(port), _hostname(hostname) {}
+  void write(const AlooLogRecord& record) override;
+
+private:
+  WiFiUDP _udp;
+  IPAddress _collector;
+  uint16_t _port;
+  const char* _hostname;
+};
+
+//========================================================================
+// AlooLog
+//========================================================================
+/**
+ * @brief Leveled logging through a lock-free ring buffer.
+ *
+ * write() formats straight into a ring slot claimed with one atomic add and
+ * returns; it never blocks on a UART or a socket, so it is safe on hot paths
+ * and in the WiFi event callback. A low-priority drain task hands records to
+ * the registered sinks. When producers outrun the drain task, the oldest
+ * records are dropped and counted. Records logged before begin() are kept
+ * until the drain task starts.
+ */
+class AlooLog {
+public:
+  /**
+   * @brief Starts the drain task. Safe to call more than once.
+   */
+  static void begin(UBaseType_t priority = 1, BaseType_t core = tskNO_AFFINITY);
+
+  static void write(uint8_t level, const char* tag, const char* format, ...)
+      __attribute__((format(printf, 3, 4)));
+
+  /**
+   * @brief Registers a sink; sinks must outlive the logger. Configure sinks
+   *        during setup, before heavy logging starts.
+   */
+  static bool addSink(AlooLogSink* sink);
+  static void removeSink(AlooLogSink* sink);
+
+  /**
+   * @brief The Serial sink registered by default.
+   */
+  static AlooSerialLogSink& serialSink();
+
+  /**
+   * @brief Drains pending records on the calling task, e.g. before a restart.
+   */
+  static void flush();
+
+  /**
+   * @brief Number of records lost because the ring buffer overflowed.
+   */
+  static uint32_t droppedCount();
+
+private:
+  static void drainTask(void* param);
+  static void drain();
+};
+
+#endif // ALOO_LOG_H
@@ -0,0 +1,184 @@
+#ifndef ALOO_METRICS_H
+#define ALOO_METRICS_H
+
+#include <Arduino.h>
+#include <atomic>
+#include <stdarg.h>
+
+// Upper bound on finite buckets per histogram; an implicit +Inf bucket follows.
+#ifndef ALOO_METRICS_MAX_BUCKETS
+#define ALOO_METRICS_MAX_BUCKETS 12
+#endif
+
+//========================================================================
+// AlooCounter
+//========================================================================
+/**
+ * @brief Monotonic counter. An increment is a single relaxed atomic add, so
+ *        it is safe from any task, including the WiFi event callback.
+ */
+class AlooCounter {
+public:
+  AlooCounter() : _value(0) {}
+
+  void increment(uint32_t by = 1) { _value.fetch_add(by, std::memory_order_relaxed); }
+  uint32_t value() const { return _value.load(std::memory_order_relaxed); }
+
+private:
+  std::atomic<uint32_t> _value;
+};
+
+//========================================================================
+// AlooHistogram
+//========================================================================
+/**
+ * @brief Fixed-bucket histogram in the Prometheus model.
+ *
+ * Bounds are ascending inclusive upper limits set once with setBounds(); the
+ * array must outlive the histogram. observe() walks at most
+ * ALOO_METRICS_MAX_BUCKETS bounds and does three relaxed atomic adds, with no
+ * locking or allocation. A snapshot taken while observations are in flight
+ * may be off by those observations.
+ */
+class AlooHistogram {
+public:
+  struct Snapshot {
+    const uint32_t* bounds;
+    uint8_t boundCount;
+    uint32_t buckets[ALOO_METRICS_MAX_BUCKETS + 1];  // Per bucket, not cumulative; the last is +Inf
+    uint32_t count;
+    uint64_t sum;
+  };
+
+  AlooHistogram() : _bounds(nullptr), _boundCount(0), _count(0), _sum(0) {
+    for (size_t i = 0; i <= ALOO_METRICS_MAX_BUCKETS; i++) _buckets[i].store(0, std::memory_order_relaxed);
+  }
+
+  void setBounds(const uint32_t* bounds, size_t count) {
+    _bounds = bounds;
+    _boundCount = (uint8_t)(count < ALOO_METRICS_MAX_BUCKETS ? count : ALOO_METRICS_MAX_BUCKETS);
+  }
+
+  void observe(uint32_t value) {
+    uint8_t i = 0;
+    while (i < _boundCount && value > _bounds[i]) i++;
+    _buckets[i].fetch_add(1, std::memory_order_relaxed);
+    _count.fetch_add(1, std::memory_order_relaxed);
+    _sum.fetch_add(value, std::memory_order_relaxed);
+  }
+
+  void snapshot(Snapshot& out) const {
+    out.bounds = _bounds;
+    out.boundCount = _boundCount;
+    for (size_t i = 0; i <= ALOO_METRICS_MAX_BUCKETS; i++) {
+      out.buckets[i] = _buckets[i].load(std::memory_order_relaxed);
+    }
+    out.count = _count.load(std::memory_order_relaxed);
+    out.sum = _sum.load(std::memory_order_relaxed);
+  }
+
+private:
+  const uint32_t* _bounds;
+  uint8_t _boundCount;
+  std::atomic<uint32_t> _buckets[ALOO_METRICS_MAX_BUCKETS + 1];
+  std::atomic<uint32_t> _count;
+  std::atomic<uint64_t> _sum;
+};
+
+//========================================================================
+// AlooScopedTimer
+//========================================================================
+/**
+ * @brief Records the lifetime of the enclosing scope, in microseconds, into a histogram.
+ */
+class AlooScopedTimer {
+public:
+  explicit AlooScopedTimer(AlooHistogram& histogram) : _histogram(histogram), _start(micros()) {}
+  ~AlooScopedTimer() { _histogram.observe((uint32_t)(micros() - _start)); }
+
+private:
+  AlooHistogram& _histogram;
+  unsigned long _start;
+};
+
+//========================================================================
+// AlooPrometheusWriter
+//========================================================================
+/**
+ * @brief Streams metrics in the Prometheus text exposition format (0.0.4).
+ *
+ * Works like AlooJsonWriter: output is accumulated in a caller-provided
+ * buffer and handed to the flush callback whenever it fills up. Label sets
+ * are passed preformatted, e.g. "route=\"/status\"", or null for none.
+ */
+class AlooPrometheusWriter {
+public:
+  typedef void (*FlushCallback)(void* context, const char* data, size_t length);
+
+  AlooPrometheusWriter(char* buffer, size_t capacity, FlushCallback flush, void* context)
+    : _buffer(buffer), _capacity(capacity), _length(0), _flush(flush), _context(context) {}
+
+  ~AlooPrometheusWriter() { flush(); }
+
+  void family(const char* name, const char* type, const char* help) {
+    line("# HELP %s %s\n# TYPE %s %s\n", name, help, name, type);
+  }
+
+  void sample(const char* name, const char* labels, uint32_t value) {
+    if (labels) {
+      line("%s{%s} %lu\n", name, labels, (unsigned long)value);
+    } else {
+      line("%s %lu\n", name, (unsigned long)value);
+    }
+  }
+
+  void histogram(const char* name, const char* labels, const AlooHistogram& histogram) {
+    AlooHistogram::Snapshot snap;
+    histogram.snapshot(snap);
+    const char* sep = labels ? "," : "";
+    if (!labels) labels = "";
+    unsigned long cumulative = 0;
+    for (uint8_t i = 0; i < snap.boundCount; i++) {
+      cumulative += snap.buckets[i];
+      line("%s_bucket{%s%sle=\"%lu\"} %lu\n", name, labels, sep, (unsigned long)snap.bounds[i], cumulative);
+    }
+    cumulative += snap.buckets[snap.boundCount];
+    line("%s_bucket{%s%sle=\"+Inf\"} %lu\n", name, labels, sep, cumulative);
+    const char* open = *labels ? "{" : "";
+    const char* close = *labels ? "}" : "";
+    line("%s_sum%s%s%s %llu\n", name, open, labels, close, (unsigned long long)snap.sum);
+    line("%s_count%s%s%s %lu\n", name, open, labels, close, (unsigned long)snap.count);
+  }
+
+  /**
+   * @brief Hands buffered output to the flush callback.
+   */
+  void flush() {
+    if (_length) _flush(_context, _buffer, _length);
+    _length = 0;
+  }
+
+private:
+  char* _buffer;
+  size_t _capacity;
+  size_t _length;
+  FlushCallback _flush;
+  void* _context;
+
+  // Formats one or more lines, flushing first if they would not fit.
+  __attribute__((format(printf, 2, 3))) void line(const char* format, ...) {
+    char text[192];
+    va_list args;
+    va_start(args, format);
+    int n = vsnprintf(text, sizeof(text), format, args);
+    va_end(args);
+    if (n <= 0) return;
+    size_t length = (size_t)n < sizeof(text) ? (size_t)n : sizeof(text) - 1;
+    if (_length + length > _capacity) flush();
+    if (length > _capacity) return;
+    memcpy(_buffer + _length, text, length);
+    _length += length;
+  }
+};
+
+#endif // ALOO_METRICS_H
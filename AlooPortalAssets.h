@@ -0,0 +1,411 @@
+// Generated by tools/embed_portal_assets.py from portal/. Do not edit.
+#ifndef ALOO_PORTAL_ASSETS_H
+#define ALOO_PORTAL_ASSETS_H
+
+#include "AlooWifiManager.h"
+
+// portal/connect.html (608 bytes, 364 gzipped)
+static const uint8_t portalConnectHtml[] PROGMEM = {
+  0x3c, 0x21, 0x44, 0x4f, 0x43, 0x54, 0x59, 0x50, 0x45, 0x20, 0x68, 0x74, 0x6d, 0x6c, 0x3e, 0x0a,
+  0x3c, 0x68, 0x74, 0x6d, 0x6c, 0x3e, 0x0a, 0x3c, 0x68, 0x65, 0x61, 0x64, 0x3e, 0x0a, 0x20, 0x20,
+  0x3c, 0x6d, 0x65, 0x74, 0x61, 0x20, 0x63, 0x68, 0x61, 0x72, 0x73, 0x65, 0x74, 0x3d, 0x27, 0x55,
+  0x54, 0x46, 0x2d, 0x38, 0x27, 0x3e, 0x0a, 0x20, 0x20, 0x3c, 0x74, 0x69, 0x74, 0x6c, 0x65, 0x3e,
+  0x53, 0x65, 0x6c, 0x65, 0x63, 0x74, 0x20, 0x57, 0x69, 0x46, 0x69, 0x20, 0x4e, 0x65, 0x74, 0x77,
+  0x6f, 0x72, 0x6b, 0x3c, 0x2f, 0x74, 0x69, 0x74, 0x6c, 0x65, 0x3e, 0x0a, 0x20, 0x20, 0x3c, 0x6c,
+  0x69, 0x6e, 0x6b, 0x20, 0x72, 0x65, 0x6c, 0x3d, 0x27, 0x73, 0x74, 0x79, 0x6c, 0x65, 0x73, 0x68,
+  0x65, 0x65, 0x74, 0x27, 0x20, 0x68, 0x72, 0x65, 0x66, 0x3d, 0x27, 0x2f, 0x73, 0x74, 0x79, 0x6c,
+  0x65, 0x2e, 0x63, 0x73, 0x73, 0x3f, 0x76, 0x3d, 0x65, 0x61, 0x66, 0x61, 0x37, 0x66, 0x37, 0x32,
+  0x39, 0x65, 0x61, 0x62, 0x62, 0x33, 0x31, 0x36, 0x27, 0x3e, 0x0a, 0x3c, 0x2f, 0x68, 0x65, 0x61,
+  0x64, 0x3e, 0x0a, 0x3c, 0x62, 0x6f, 0x64, 0x79, 0x3e, 0x0a, 0x20, 0x20, 0x3c, 0x68, 0x31, 0x3e,
+  0x53, 0x65, 0x6c, 0x65, 0x63, 0x74, 0x20, 0x57, 0x69, 0x46, 0x69, 0x20, 0x4e, 0x65, 0x74, 0x77,
+  0x6f, 0x72, 0x6b, 0x3c, 0x2f, 0x68, 0x31, 0x3e, 0x0a, 0x20, 0x20, 0x3c, 0x64, 0x69, 0x76, 0x20,
+  0x69, 0x64, 0x3d, 0x27, 0x6e, 0x65, 0x74, 0x77, 0x6f, 0x72, 0x6b, 0x73, 0x27, 0x3e, 0x3c, 0x2f,
+  0x64, 0x69, 0x76, 0x3e, 0x0a, 0x20, 0x20, 0x3c, 0x66, 0x6f, 0x72, 0x6d, 0x20, 0x69, 0x64, 0x3d,
+  0x27, 0x77, 0x69, 0x66, 0x69, 0x46, 0x6f, 0x72, 0x6d, 0x27, 0x20, 0x61, 0x63, 0x74, 0x69, 0x6f,
+  0x6e, 0x3d, 0x27, 0x2f, 0x73, 0x75, 0x62, 0x6d, 0x69, 0x74, 0x27, 0x20, 0x6d, 0x65, 0x74, 0x68,
+  0x6f, 0x64, 0x3d, 0x27, 0x50, 0x4f, 0x53, 0x54, 0x27, 0x3e, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x53,
+  0x53, 0x49, 0x44, 0x3a, 0x20, 0x3c, 0x69, 0x6e, 0x70, 0x75, 0x74, 0x20, 0x74, 0x79, 0x70, 0x65,
+  0x3d, 0x27, 0x74, 0x65, 0x78, 0x74, 0x27, 0x20, 0x69, 0x64, 0x3d, 0x27, 0x73, 0x73, 0x69, 0x64,
+  0x27, 0x20, 0x6e, 0x61, 0x6d, 0x65, 0x3d, 0x27, 0x73, 0x73, 0x69, 0x64, 0x27, 0x3e, 0x3c, 0x62,
+  0x72, 0x3e, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x50, 0x61, 0x73, 0x73, 0x77, 0x6f, 0x72, 0x64, 0x3a,
+  0x20, 0x3c, 0x69, 0x6e, 0x70, 0x75, 0x74, 0x20, 0x74, 0x79, 0x70, 0x65, 0x3d, 0x27, 0x70, 0x61,
+  0x73, 0x73, 0x77, 0x6f, 0x72, 0x64, 0x27, 0x20, 0x69, 0x64, 0x3d, 0x27, 0x70, 0x61, 0x73, 0x73,
+  0x77, 0x6f, 0x72, 0x64, 0x27, 0x20, 0x6e, 0x61, 0x6d, 0x65, 0x3d, 0x27, 0x70, 0x61, 0x73, 0x73,
+  0x77, 0x6f, 0x72, 0x64, 0x27, 0x3e, 0x3c, 0x62, 0x72, 0x3e, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x3c,
+  0x69, 0x6e, 0x70, 0x75, 0x74, 0x20, 0x74, 0x79, 0x70, 0x65, 0x3d, 0x27, 0x63, 0x68, 0x65, 0x63,
+  0x6b, 0x62, 0x6f, 0x78, 0x27, 0x20, 0x6f, 0x6e, 0x63, 0x6c, 0x69, 0x63, 0x6b, 0x3d, 0x27, 0x74,
+  0x6f, 0x67, 0x67, 0x6c, 0x65, 0x50, 0x61, 0x73, 0x73, 0x77, 0x6f, 0x72, 0x64, 0x28, 0x29, 0x27,
+  0x3e, 0x20, 0x53, 0x68, 0x6f, 0x77, 0x20, 0x50, 0x61, 0x73, 0x73, 0x77, 0x6f, 0x72, 0x64, 0x3c,
+  0x62, 0x72, 0x3e, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x3c, 0x69, 0x6e, 0x70, 0x75, 0x74, 0x20, 0x74,
+  0x79, 0x70, 0x65, 0x3d, 0x27, 0x73, 0x75, 0x62, 0x6d, 0x69, 0x74, 0x27, 0x20, 0x76, 0x61, 0x6c,
+  0x75, 0x65, 0x3d, 0x27, 0x43, 0x6f, 0x6e, 0x6e, 0x65, 0x63, 0x74, 0x27, 0x3e, 0x0a, 0x20, 0x20,
+  0x3c, 0x2f, 0x66, 0x6f, 0x72, 0x6d, 0x3e, 0x0a, 0x20, 0x20, 0x3c, 0x73, 0x63, 0x72, 0x69, 0x70,
+  0x74, 0x20, 0x73, 0x72, 0x63, 0x3d, 0x27, 0x2f, 0x73, 0x63, 0x72, 0x69, 0x70, 0x74, 0x2e, 0x6a,
+  0x73, 0x3f, 0x76, 0x3d, 0x65, 0x62, 0x31, 0x36, 0x30, 0x32, 0x61, 0x63, 0x31, 0x38, 0x37, 0x65,
+  0x34, 0x30, 0x64, 0x37, 0x27, 0x3e, 0x3c, 0x2f, 0x73, 0x63, 0x72, 0x69, 0x70, 0x74, 0x3e, 0x0a,
+  0x3c, 0x2f, 0x62, 0x6f, 0x64, 0x79, 0x3e, 0x0a, 0x3c, 0x2f, 0x68, 0x74, 0x6d, 0x6c, 0x3e, 0x0a,
+};
+static const uint8_t portalConnectHtmlGz[] PROGMEM = {
+  0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0x6d, 0x52, 0xcb, 0x4e, 0xc3, 0x30,
+  0x10, 0xbc, 0xf3, 0x15, 0xcb, 0xc9, 0x70, 0xa0, 0x69, 0x0a, 0x6a, 0x0a, 0x72, 0xc2, 0xa1, 0xa5,
+  0x12, 0x17, 0x5a, 0x29, 0x45, 0x88, 0xa3, 0xe3, 0x6c, 0x1a, 0x13, 0x27, 0x8e, 0x62, 0xf7, 0xf5,
+  0xf7, 0x38, 0x76, 0x1f, 0x02, 0xf5, 0x14, 0xef, 0xcc, 0xee, 0xec, 0x63, 0x42, 0x6f, 0x67, 0x8b,
+  0xe9, 0xea, 0x7b, 0xf9, 0x06, 0xa5, 0xa9, 0x65, 0x72, 0x43, 0x4f, 0x1f, 0x64, 0x79, 0x72, 0x03,
+  0x40, 0x6b, 0x34, 0x0c, 0x78, 0xc9, 0x3a, 0x8d, 0x26, 0x26, 0x9f, 0xab, 0xf9, 0xc3, 0x84, 0x38,
+  0xc2, 0x08, 0x23, 0x31, 0x49, 0x51, 0x22, 0x37, 0xf0, 0x25, 0xe6, 0x02, 0x3e, 0xd0, 0xec, 0x54,
+  0x57, 0xd1, 0xc0, 0x53, 0x7d, 0x92, 0x14, 0x4d, 0x05, 0x1d, 0xca, 0x98, 0x68, 0x73, 0x90, 0xa8,
+  0x4b, 0x44, 0x43, 0xa0, 0xec, 0xb0, 0x88, 0x49, 0xe0, 0xa0, 0x01, 0xd7, 0xfa, 0x75, 0x1b, 0x23,
+  0x2b, 0x58, 0x54, 0x44, 0xa3, 0x67, 0x64, 0x59, 0xf6, 0x18, 0x8e, 0x6d, 0x0f, 0x1a, 0xf8, 0x21,
+  0x68, 0xa6, 0xf2, 0x83, 0x53, 0x2b, 0xc3, 0xeb, 0xfd, 0x2c, 0xde, 0xd3, 0xb9, 0xd8, 0x82, 0xc8,
+  0x63, 0xd2, 0x78, 0x5c, 0x93, 0x84, 0x06, 0x16, 0x73, 0x5c, 0xa1, 0xba, 0xda, 0x91, 0x3b, 0x51,
+  0x88, 0xb9, 0x0d, 0x08, 0x30, 0x6e, 0x84, 0x6a, 0xfa, 0x39, 0x36, 0x59, 0x2d, 0xec, 0x58, 0x76,
+  0xd5, 0x52, 0xd9, 0x94, 0xe5, 0x22, 0x5d, 0xb9, 0x1d, 0x01, 0xd2, 0xf4, 0x7d, 0xf6, 0x02, 0x54,
+  0x34, 0xed, 0xc6, 0x80, 0x39, 0xb4, 0x18, 0x13, 0x83, 0x7b, 0x9b, 0xdb, 0x4b, 0x69, 0x2d, 0x72,
+  0x02, 0x0d, 0xab, 0xf1, 0xf8, 0x4e, 0x68, 0xd6, 0xf9, 0xba, 0x25, 0xd3, 0xda, 0xce, 0x90, 0xff,
+  0xab, 0x6d, 0x8f, 0xb0, 0xaf, 0xbf, 0x44, 0x5e, 0xe3, 0x1c, 0x5f, 0x74, 0xfe, 0x54, 0xf3, 0x12,
+  0x79, 0x95, 0xa9, 0x3d, 0x01, 0xd5, 0x70, 0x29, 0x78, 0x65, 0x87, 0x51, 0xeb, 0xb5, 0xc4, 0x53,
+  0xb7, 0xbb, 0x7b, 0x92, 0x40, 0x5a, 0xaa, 0xdd, 0xb9, 0xff, 0x75, 0xa1, 0xd3, 0xc2, 0x5b, 0x26,
+  0x37, 0x36, 0x9c, 0xaa, 0xa6, 0xb1, 0x47, 0xf5, 0xb6, 0x06, 0xfd, 0xa5, 0xdc, 0x4b, 0xf3, 0x4e,
+  0xb4, 0x06, 0x74, 0xc7, 0xfb, 0x1b, 0xb9, 0x60, 0xf0, 0xe3, 0xbc, 0xca, 0xc2, 0xf1, 0x70, 0xc4,
+  0x78, 0x38, 0x89, 0xf0, 0x69, 0x98, 0x47, 0xfd, 0x9d, 0x3d, 0xdf, 0x9b, 0xe6, 0xdd, 0xb2, 0xa6,
+  0xb8, 0x1f, 0xe9, 0x17, 0xab, 0xcb, 0xbd, 0x7f, 0x60, 0x02, 0x00, 0x00,
+};
+
+// portal/index.html (339 bytes, 249 gzipped)
+static const uint8_t portalIndexHtml[] PROGMEM = {
+  0x3c, 0x21, 0x44, 0x4f, 0x43, 0x54, 0x59, 0x50, 0x45, 0x20, 0x68, 0x74, 0x6d, 0x6c, 0x3e, 0x0a,
+  0x3c, 0x68, 0x74, 0x6d, 0x6c, 0x3e, 0x0a, 0x3c, 0x68, 0x65, 0x61, 0x64, 0x3e, 0x0a, 0x20, 0x20,
+  0x3c, 0x6d, 0x65, 0x74, 0x61, 0x20, 0x63, 0x68, 0x61, 0x72, 0x73, 0x65, 0x74, 0x3d, 0x27, 0x55,
+  0x54, 0x46, 0x2d, 0x38, 0x27, 0x3e, 0x0a, 0x20, 0x20, 0x3c, 0x74, 0x69, 0x74, 0x6c, 0x65, 0x3e,
+  0x45, 0x53, 0x50, 0x33, 0x32, 0x20, 0x57, 0x69, 0x46, 0x69, 0x20, 0x53, 0x65, 0x74, 0x75, 0x70,
+  0x3c, 0x2f, 0x74, 0x69, 0x74, 0x6c, 0x65, 0x3e, 0x0a, 0x20, 0x20, 0x3c, 0x6c, 0x69, 0x6e, 0x6b,
+  0x20, 0x72, 0x65, 0x6c, 0x3d, 0x27, 0x73, 0x74, 0x79, 0x6c, 0x65, 0x73, 0x68, 0x65, 0x65, 0x74,
+  0x27, 0x20, 0x68, 0x72, 0x65, 0x66, 0x3d, 0x27, 0x2f, 0x73, 0x74, 0x79, 0x6c, 0x65, 0x2e, 0x63,
+  0x73, 0x73, 0x3f, 0x76, 0x3d, 0x65, 0x61, 0x66, 0x61, 0x37, 0x66, 0x37, 0x32, 0x39, 0x65, 0x61,
+  0x62, 0x62, 0x33, 0x31, 0x36, 0x27, 0x3e, 0x0a, 0x3c, 0x2f, 0x68, 0x65, 0x61, 0x64, 0x3e, 0x0a,
+  0x3c, 0x62, 0x6f, 0x64, 0x79, 0x3e, 0x0a, 0x20, 0x20, 0x3c, 0x68, 0x31, 0x3e, 0x45, 0x53, 0x50,
+  0x33, 0x32, 0x20, 0x57, 0x69, 0x46, 0x69, 0x20, 0x53, 0x65, 0x74, 0x75, 0x70, 0x3c, 0x2f, 0x68,
+  0x31, 0x3e, 0x0a, 0x20, 0x20, 0x3c, 0x62, 0x75, 0x74, 0x74, 0x6f, 0x6e, 0x20, 0x6f, 0x6e, 0x63,
+  0x6c, 0x69, 0x63, 0x6b, 0x3d, 0x22, 0x77, 0x69, 0x6e, 0x64, 0x6f, 0x77, 0x2e, 0x6c, 0x6f, 0x63,
+  0x61, 0x74, 0x69, 0x6f, 0x6e, 0x2e, 0x68, 0x72, 0x65, 0x66, 0x3d, 0x27, 0x2f, 0x63, 0x6f, 0x6e,
+  0x6e, 0x65, 0x63, 0x74, 0x27, 0x22, 0x3e, 0x53, 0x65, 0x74, 0x75, 0x70, 0x20, 0x57, 0x69, 0x46,
+  0x69, 0x3c, 0x2f, 0x62, 0x75, 0x74, 0x74, 0x6f, 0x6e, 0x3e, 0x0a, 0x20, 0x20, 0x3c, 0x73, 0x63,
+  0x72, 0x69, 0x70, 0x74, 0x20, 0x73, 0x72, 0x63, 0x3d, 0x27, 0x2f, 0x73, 0x63, 0x72, 0x69, 0x70,
+  0x74, 0x2e, 0x6a, 0x73, 0x3f, 0x76, 0x3d, 0x65, 0x62, 0x31, 0x36, 0x30, 0x32, 0x61, 0x63, 0x31,
+  0x38, 0x37, 0x65, 0x34, 0x30, 0x64, 0x37, 0x27, 0x3e, 0x3c, 0x2f, 0x73, 0x63, 0x72, 0x69, 0x70,
+  0x74, 0x3e, 0x0a, 0x3c, 0x2f, 0x62, 0x6f, 0x64, 0x79, 0x3e, 0x0a, 0x3c, 0x2f, 0x68, 0x74, 0x6d,
+  0x6c, 0x3e, 0x0a,
+};
+static const uint8_t portalIndexHtmlGz[] PROGMEM = {
+  0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0x6d, 0x90, 0x31, 0x6f, 0xc2, 0x30,
+  0x10, 0x85, 0x77, 0x7e, 0x85, 0xcb, 0xe2, 0xa9, 0x09, 0x09, 0x15, 0xa1, 0x92, 0xed, 0x0e, 0x2d,
+  0xac, 0x45, 0x82, 0xaa, 0xea, 0x68, 0x5f, 0x2e, 0x8a, 0x8b, 0xb1, 0x91, 0x7d, 0x14, 0xf1, 0xef,
+  0x9b, 0x38, 0x74, 0xeb, 0x74, 0xf2, 0x7b, 0xbe, 0xf7, 0x3e, 0x9d, 0x78, 0x78, 0x7b, 0x7f, 0x3d,
+  0x7c, 0xed, 0x36, 0xac, 0xa7, 0x93, 0x53, 0x33, 0xf1, 0x37, 0x50, 0xb7, 0x6a, 0xc6, 0x98, 0x38,
+  0x21, 0x69, 0x06, 0xbd, 0x8e, 0x09, 0x49, 0xf2, 0x8f, 0xc3, 0xf6, 0x71, 0xcd, 0xb3, 0x41, 0x96,
+  0x1c, 0xaa, 0xcd, 0x7e, 0xb7, 0xac, 0xd9, 0xa7, 0xdd, 0x5a, 0xb6, 0x47, 0xba, 0x9c, 0x45, 0x39,
+  0xe9, 0xe3, 0x0f, 0x67, 0xfd, 0x91, 0x45, 0x74, 0x92, 0x27, 0xba, 0x39, 0x4c, 0x3d, 0x22, 0x71,
+  0xd6, 0x47, 0xec, 0x24, 0x2f, 0xb3, 0x54, 0x40, 0x4a, 0x2f, 0x3f, 0x12, 0x75, 0xa7, 0x9b, 0xae,
+  0xa9, 0x9f, 0x51, 0x1b, 0xb3, 0xac, 0x56, 0x43, 0x81, 0x28, 0x27, 0x02, 0x61, 0x42, 0x7b, 0xcb,
+  0x69, 0x7d, 0xf5, 0x4f, 0xd9, 0x20, 0x8e, 0x9e, 0xb9, 0x10, 0x05, 0xcf, 0x82, 0x07, 0x67, 0xe1,
+  0x28, 0xe7, 0x57, 0xeb, 0xdb, 0x70, 0x2d, 0x5c, 0x00, 0x4d, 0x36, 0xf8, 0xe2, 0xde, 0x09, 0xc1,
+  0x7b, 0x04, 0xe2, 0x73, 0x95, 0xd7, 0x73, 0x92, 0x28, 0xa7, 0xe5, 0x9c, 0x93, 0x20, 0xda, 0x33,
+  0xb1, 0x14, 0x61, 0x24, 0xcc, 0x8f, 0xe2, 0x3b, 0x13, 0x9a, 0x6a, 0xb5, 0xa8, 0x35, 0x54, 0xeb,
+  0x06, 0x9f, 0x16, 0x6d, 0xc3, 0x95, 0xb8, 0xfb, 0x23, 0xea, 0xc4, 0x38, 0xd0, 0xe4, 0xdb, 0xfd,
+  0x02, 0x6a, 0x4e, 0x54, 0x48, 0x53, 0x01, 0x00, 0x00,
+};
+
+// portal/script.js (2738 bytes, 1088 gzipped)
+static const uint8_t portalScriptJs[] PROGMEM = {
+  0x66, 0x75, 0x6e, 0x63, 0x74, 0x69, 0x6f, 0x6e, 0x20, 0x74, 0x6f, 0x67, 0x67, 0x6c, 0x65, 0x50,
+  0x61, 0x73, 0x73, 0x77, 0x6f, 0x72, 0x64, 0x28, 0x29, 0x20, 0x7b, 0x0a, 0x20, 0x20, 0x76, 0x61,
+  0x72, 0x20, 0x78, 0x20, 0x3d, 0x20, 0x64, 0x6f, 0x63, 0x75, 0x6d, 0x65, 0x6e, 0x74, 0x2e, 0x67,
+  0x65, 0x74, 0x45, 0x6c, 0x65, 0x6d, 0x65, 0x6e, 0x74, 0x42, 0x79, 0x49, 0x64, 0x28, 0x27, 0x70,
+  0x61, 0x73, 0x73, 0x77, 0x6f, 0x72, 0x64, 0x27, 0x29, 0x3b, 0x0a, 0x20, 0x20, 0x69, 0x66, 0x20,
+  0x28, 0x78, 0x2e, 0x74, 0x79, 0x70, 0x65, 0x20, 0x3d, 0x3d, 0x3d, 0x20, 0x27, 0x70, 0x61, 0x73,
+  0x73, 0x77, 0x6f, 0x72, 0x64, 0x27, 0x29, 0x20, 0x7b, 0x20, 0x78, 0x2e, 0x74, 0x79, 0x70, 0x65,
+  0x20, 0x3d, 0x20, 0x27, 0x74, 0x65, 0x78, 0x74, 0x27, 0x3b, 0x20, 0x7d, 0x20, 0x65, 0x6c, 0x73,
+  0x65, 0x20, 0x7b, 0x20, 0x78, 0x2e, 0x74, 0x79, 0x70, 0x65, 0x20, 0x3d, 0x20, 0x27, 0x70, 0x61,
+  0x73, 0x73, 0x77, 0x6f, 0x72, 0x64, 0x27, 0x3b, 0x20, 0x7d, 0x0a, 0x7d, 0x0a, 0x0a, 0x2f, 0x2f,
+  0x20, 0x53, 0x63, 0x61, 0x6e, 0x20, 0x72, 0x65, 0x73, 0x75, 0x6c, 0x74, 0x73, 0x20, 0x6b, 0x65,
+  0x79, 0x65, 0x64, 0x20, 0x62, 0x79, 0x20, 0x42, 0x53, 0x53, 0x49, 0x44, 0x2c, 0x20, 0x6b, 0x65,
+  0x70, 0x74, 0x20, 0x69, 0x6e, 0x20, 0x73, 0x74, 0x65, 0x70, 0x20, 0x77, 0x69, 0x74, 0x68, 0x20,
+  0x74, 0x68, 0x65, 0x20, 0x64, 0x65, 0x76, 0x69, 0x63, 0x65, 0x27, 0x73, 0x20, 0x73, 0x63, 0x61,
+  0x6e, 0x20, 0x67, 0x65, 0x6e, 0x65, 0x72, 0x61, 0x74, 0x69, 0x6f, 0x6e, 0x2e, 0x0a, 0x76, 0x61,
+  0x72, 0x20, 0x6e, 0x65, 0x74, 0x77, 0x6f, 0x72, 0x6b, 0x73, 0x20, 0x3d, 0x20, 0x7b, 0x7d, 0x3b,
+  0x0a, 0x76, 0x61, 0x72, 0x20, 0x67, 0x65, 0x6e, 0x65, 0x72, 0x61, 0x74, 0x69, 0x6f, 0x6e, 0x20,
+  0x3d, 0x20, 0x30, 0x3b, 0x0a, 0x76, 0x61, 0x72, 0x20, 0x70, 0x6f, 0x6c, 0x6c, 0x54, 0x69, 0x6d,
+  0x65, 0x72, 0x20, 0x3d, 0x20, 0x6e, 0x75, 0x6c, 0x6c, 0x3b, 0x0a, 0x0a, 0x66, 0x75, 0x6e, 0x63,
+  0x74, 0x69, 0x6f, 0x6e, 0x20, 0x61, 0x70, 0x70, 0x6c, 0x79, 0x44, 0x69, 0x66, 0x66, 0x28, 0x64,
+  0x61, 0x74, 0x61, 0x29, 0x20, 0x7b, 0x0a, 0x20, 0x20, 0x69, 0x66, 0x20, 0x28, 0x64, 0x61, 0x74,
+  0x61, 0x2e, 0x66, 0x75, 0x6c, 0x6c, 0x29, 0x20, 0x7b, 0x20, 0x6e, 0x65, 0x74, 0x77, 0x6f, 0x72,
+  0x6b, 0x73, 0x20, 0x3d, 0x20, 0x7b, 0x7d, 0x3b, 0x20, 0x7d, 0x0a, 0x20, 0x20, 0x28, 0x64, 0x61,
+  0x74, 0x61, 0x2e, 0x6e, 0x65, 0x74, 0x77, 0x6f, 0x72, 0x6b, 0x73, 0x20, 0x7c, 0x7c, 0x20, 0x5b,
+  0x5d, 0x29, 0x2e, 0x66, 0x6f, 0x72, 0x45, 0x61, 0x63, 0x68, 0x28, 0x66, 0x75, 0x6e, 0x63, 0x74,
+  0x69, 0x6f, 0x6e, 0x28, 0x6e, 0x65, 0x74, 0x29, 0x20, 0x7b, 0x20, 0x6e, 0x65, 0x74, 0x77, 0x6f,
+  0x72, 0x6b, 0x73, 0x5b, 0x6e, 0x65, 0x74, 0x2e, 0x62, 0x73, 0x73, 0x69, 0x64, 0x5d, 0x20, 0x3d,
+  0x20, 0x6e, 0x65, 0x74, 0x3b, 0x20, 0x7d, 0x29, 0x3b, 0x0a, 0x20, 0x20, 0x28, 0x64, 0x61, 0x74,
+  0x61, 0x2e, 0x72, 0x65, 0x6d, 0x6f, 0x76, 0x65, 0x64, 0x20, 0x7c, 0x7c, 0x20, 0x5b, 0x5d, 0x29,
+  0x2e, 0x66, 0x6f, 0x72, 0x45, 0x61, 0x63, 0x68, 0x28, 0x66, 0x75, 0x6e, 0x63, 0x74, 0x69, 0x6f,
+  0x6e, 0x28, 0x62, 0x73, 0x73, 0x69, 0x64, 0x29, 0x20, 0x7b, 0x20, 0x64, 0x65, 0x6c, 0x65, 0x74,
+  0x65, 0x20, 0x6e, 0x65, 0x74, 0x77, 0x6f, 0x72, 0x6b, 0x73, 0x5b, 0x62, 0x73, 0x73, 0x69, 0x64,
+  0x5d, 0x3b, 0x20, 0x7d, 0x29, 0x3b, 0x0a, 0x20, 0x20, 0x67, 0x65, 0x6e, 0x65, 0x72, 0x61, 0x74,
+  0x69, 0x6f, 0x6e, 0x20, 0x3d, 0x20, 0x64, 0x61, 0x74, 0x61, 0x2e, 0x67, 0x65, 0x6e, 0x65, 0x72,
+  0x61, 0x74, 0x69, 0x6f, 0x6e, 0x3b, 0x0a, 0x20, 0x20, 0x72, 0x65, 0x6e, 0x64, 0x65, 0x72, 0x4e,
+  0x65, 0x74, 0x77, 0x6f, 0x72, 0x6b, 0x73, 0x28, 0x29, 0x3b, 0x0a, 0x7d, 0x0a, 0x0a, 0x66, 0x75,
+  0x6e, 0x63, 0x74, 0x69, 0x6f, 0x6e, 0x20, 0x72, 0x65, 0x6e, 0x64, 0x65, 0x72, 0x4e, 0x65, 0x74,
+  0x77, 0x6f, 0x72, 0x6b, 0x73, 0x28, 0x29, 0x20, 0x7b, 0x0a, 0x20, 0x20, 0x2f, 0x2f, 0x20, 0x4f,
+  0x6e, 0x65, 0x20, 0x72, 0x6f, 0x77, 0x20, 0x70, 0x65, 0x72, 0x20, 0x53, 0x53, 0x49, 0x44, 0x2c,
+  0x20, 0x73, 0x68, 0x6f, 0x77, 0x69, 0x6e, 0x67, 0x20, 0x69, 0x74, 0x73, 0x20, 0x73, 0x74, 0x72,
+  0x6f, 0x6e, 0x67, 0x65, 0x73, 0x74, 0x20, 0x61, 0x63, 0x63, 0x65, 0x73, 0x73, 0x20, 0x70, 0x6f,
+  0x69, 0x6e, 0x74, 0x2e, 0x0a, 0x20, 0x20, 0x76, 0x61, 0x72, 0x20, 0x62, 0x79, 0x53, 0x73, 0x69,
+  0x64, 0x20, 0x3d, 0x20, 0x7b, 0x7d, 0x3b, 0x0a, 0x20, 0x20, 0x4f, 0x62, 0x6a, 0x65, 0x63, 0x74,
+  0x2e, 0x6b, 0x65, 0x79, 0x73, 0x28, 0x6e, 0x65, 0x74, 0x77, 0x6f, 0x72, 0x6b, 0x73, 0x29, 0x2e,
+  0x66, 0x6f, 0x72, 0x45, 0x61, 0x63, 0x68, 0x28, 0x66, 0x75, 0x6e, 0x63, 0x74, 0x69, 0x6f, 0x6e,
+  0x28, 0x62, 0x73, 0x73, 0x69, 0x64, 0x29, 0x20, 0x7b, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x76, 0x61,
+  0x72, 0x20, 0x6e, 0x65, 0x74, 0x20, 0x3d, 0x20, 0x6e, 0x65, 0x74, 0x77, 0x6f, 0x72, 0x6b, 0x73,
+  0x5b, 0x62, 0x73, 0x73, 0x69, 0x64, 0x5d, 0x3b, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x69, 0x66, 0x20,
+  0x28, 0x21, 0x62, 0x79, 0x53, 0x73, 0x69, 0x64, 0x5b, 0x6e, 0x65, 0x74, 0x2e, 0x73, 0x73, 0x69,
+  0x64, 0x5d, 0x20, 0x7c, 0x7c, 0x20, 0x6e, 0x65, 0x74, 0x2e, 0x72, 0x73, 0x73, 0x69, 0x20, 0x3e,
+  0x20, 0x62, 0x79, 0x53, 0x73, 0x69, 0x64, 0x5b, 0x6e, 0x65, 0x74, 0x2e, 0x73, 0x73, 0x69, 0x64,
+  0x5d, 0x2e, 0x72, 0x73, 0x73, 0x69, 0x29, 0x20, 0x7b, 0x20, 0x62, 0x79, 0x53, 0x73, 0x69, 0x64,
+  0x5b, 0x6e, 0x65, 0x74, 0x2e, 0x73, 0x73, 0x69, 0x64, 0x5d, 0x20, 0x3d, 0x20, 0x6e, 0x65, 0x74,
+  0x3b, 0x20, 0x7d, 0x0a, 0x20, 0x20, 0x7d, 0x29, 0x3b, 0x0a, 0x20, 0x20, 0x76, 0x61, 0x72, 0x20,
+  0x6c, 0x69, 0x73, 0x74, 0x20, 0x3d, 0x20, 0x4f, 0x62, 0x6a, 0x65, 0x63, 0x74, 0x2e, 0x6b, 0x65,
+  0x79, 0x73, 0x28, 0x62, 0x79, 0x53, 0x73, 0x69, 0x64, 0x29, 0x2e, 0x6d, 0x61, 0x70, 0x28, 0x66,
+  0x75, 0x6e, 0x63, 0x74, 0x69, 0x6f, 0x6e, 0x28, 0x73, 0x73, 0x69, 0x64, 0x29, 0x20, 0x7b, 0x20,
+  0x72, 0x65, 0x74, 0x75, 0x72, 0x6e, 0x20, 0x62, 0x79, 0x53, 0x73, 0x69, 0x64, 0x5b, 0x73, 0x73,
+  0x69, 0x64, 0x5d, 0x3b, 0x20, 0x7d, 0x29, 0x3b, 0x0a, 0x20, 0x20, 0x6c, 0x69, 0x73, 0x74, 0x2e,
+  0x73, 0x6f, 0x72, 0x74, 0x28, 0x66, 0x75, 0x6e, 0x63, 0x74, 0x69, 0x6f, 0x6e, 0x28, 0x61, 0x2c,
+  0x20, 0x62, 0x29, 0x20, 0x7b, 0x20, 0x72, 0x65, 0x74, 0x75, 0x72, 0x6e, 0x20, 0x62, 0x2e, 0x72,
+  0x73, 0x73, 0x69, 0x20, 0x2d, 0x20, 0x61, 0x2e, 0x72, 0x73, 0x73, 0x69, 0x3b, 0x20, 0x7d, 0x29,
+  0x3b, 0x0a, 0x0a, 0x20, 0x20, 0x76, 0x61, 0x72, 0x20, 0x6e, 0x65, 0x74, 0x77, 0x6f, 0x72, 0x6b,
+  0x73, 0x44, 0x69, 0x76, 0x20, 0x3d, 0x20, 0x64, 0x6f, 0x63, 0x75, 0x6d, 0x65, 0x6e, 0x74, 0x2e,
+  0x67, 0x65, 0x74, 0x45, 0x6c, 0x65, 0x6d, 0x65, 0x6e, 0x74, 0x42, 0x79, 0x49, 0x64, 0x28, 0x27,
+  0x6e, 0x65, 0x74, 0x77, 0x6f, 0x72, 0x6b, 0x73, 0x27, 0x29, 0x3b, 0x0a, 0x20, 0x20, 0x69, 0x66,
+  0x20, 0x28, 0x6c, 0x69, 0x73, 0x74, 0x2e, 0x6c, 0x65, 0x6e, 0x67, 0x74, 0x68, 0x20, 0x3d, 0x3d,
+  0x3d, 0x20, 0x30, 0x29, 0x20, 0x7b, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x6e, 0x65, 0x74, 0x77, 0x6f,
+  0x72, 0x6b, 0x73, 0x44, 0x69, 0x76, 0x2e, 0x69, 0x6e, 0x6e, 0x65, 0x72, 0x48, 0x54, 0x4d, 0x4c,
+  0x20, 0x3d, 0x20, 0x27, 0x3c, 0x70, 0x3e, 0x4e, 0x6f, 0x20, 0x6e, 0x65, 0x74, 0x77, 0x6f, 0x72,
+  0x6b, 0x73, 0x20, 0x66, 0x6f, 0x75, 0x6e, 0x64, 0x2e, 0x20, 0x50, 0x6c, 0x65, 0x61, 0x73, 0x65,
+  0x20, 0x72, 0x65, 0x66, 0x72, 0x65, 0x73, 0x68, 0x2e, 0x3c, 0x2f, 0x70, 0x3e, 0x27, 0x3b, 0x0a,
+  0x20, 0x20, 0x20, 0x20, 0x72, 0x65, 0x74, 0x75, 0x72, 0x6e, 0x3b, 0x0a, 0x20, 0x20, 0x7d, 0x0a,
+  0x20, 0x20, 0x76, 0x61, 0x72, 0x20, 0x75, 0x6c, 0x20, 0x3d, 0x20, 0x64, 0x6f, 0x63, 0x75, 0x6d,
+  0x65, 0x6e, 0x74, 0x2e, 0x63, 0x72, 0x65, 0x61, 0x74, 0x65, 0x45, 0x6c, 0x65, 0x6d, 0x65, 0x6e,
+  0x74, 0x28, 0x27, 0x75, 0x6c, 0x27, 0x29, 0x3b, 0x0a, 0x20, 0x20, 0x6c, 0x69, 0x73, 0x74, 0x2e,
+  0x66, 0x6f, 0x72, 0x45, 0x61, 0x63, 0x68, 0x28, 0x66, 0x75, 0x6e, 0x63, 0x74, 0x69, 0x6f, 0x6e,
+  0x28, 0x6e, 0x65, 0x74, 0x29, 0x20, 0x7b, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x76, 0x61, 0x72, 0x20,
+  0x6c, 0x69, 0x20, 0x3d, 0x20, 0x64, 0x6f, 0x63, 0x75, 0x6d, 0x65, 0x6e, 0x74, 0x2e, 0x63, 0x72,
+  0x65, 0x61, 0x74, 0x65, 0x45, 0x6c, 0x65, 0x6d, 0x65, 0x6e, 0x74, 0x28, 0x27, 0x6c, 0x69, 0x27,
+  0x29, 0x3b, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x6c, 0x69, 0x2e, 0x74, 0x65, 0x78, 0x74, 0x43, 0x6f,
+  0x6e, 0x74, 0x65, 0x6e, 0x74, 0x20, 0x3d, 0x20, 0x6e, 0x65, 0x74, 0x2e, 0x73, 0x73, 0x69, 0x64,
+  0x20, 0x2b, 0x20, 0x27, 0x20, 0x28, 0x27, 0x20, 0x2b, 0x20, 0x6e, 0x65, 0x74, 0x2e, 0x72, 0x73,
+  0x73, 0x69, 0x20, 0x2b, 0x20, 0x27, 0x20, 0x64, 0x42, 0x6d, 0x29, 0x27, 0x3b, 0x0a, 0x20, 0x20,
+  0x20, 0x20, 0x6c, 0x69, 0x2e, 0x6f, 0x6e, 0x63, 0x6c, 0x69, 0x63, 0x6b, 0x20, 0x3d, 0x20, 0x66,
+  0x75, 0x6e, 0x63, 0x74, 0x69, 0x6f, 0x6e, 0x28, 0x29, 0x20, 0x7b, 0x0a, 0x20, 0x20, 0x20, 0x20,
+  0x20, 0x20, 0x64, 0x6f, 0x63, 0x75, 0x6d, 0x65, 0x6e, 0x74, 0x2e, 0x67, 0x65, 0x74, 0x45, 0x6c,
+  0x65, 0x6d, 0x65, 0x6e, 0x74, 0x42, 0x79, 0x49, 0x64, 0x28, 0x27, 0x73, 0x73, 0x69, 0x64, 0x27,
+  0x29, 0x2e, 0x76, 0x61, 0x6c, 0x75, 0x65, 0x20, 0x3d, 0x20, 0x6e, 0x65, 0x74, 0x2e, 0x73, 0x73,
+  0x69, 0x64, 0x3b, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x64, 0x6f, 0x63, 0x75, 0x6d, 0x65,
+  0x6e, 0x74, 0x2e, 0x67, 0x65, 0x74, 0x45, 0x6c, 0x65, 0x6d, 0x65, 0x6e, 0x74, 0x42, 0x79, 0x49,
+  0x64, 0x28, 0x27, 0x70, 0x61, 0x73, 0x73, 0x77, 0x6f, 0x72, 0x64, 0x27, 0x29, 0x2e, 0x66, 0x6f,
+  0x63, 0x75, 0x73, 0x28, 0x29, 0x3b, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x7d, 0x3b, 0x0a, 0x20, 0x20,
+  0x20, 0x20, 0x75, 0x6c, 0x2e, 0x61, 0x70, 0x70, 0x65, 0x6e, 0x64, 0x43, 0x68, 0x69, 0x6c, 0x64,
+  0x28, 0x6c, 0x69, 0x29, 0x3b, 0x0a, 0x20, 0x20, 0x7d, 0x29, 0x3b, 0x0a, 0x20, 0x20, 0x6e, 0x65,
+  0x74, 0x77, 0x6f, 0x72, 0x6b, 0x73, 0x44, 0x69, 0x76, 0x2e, 0x69, 0x6e, 0x6e, 0x65, 0x72, 0x48,
+  0x54, 0x4d, 0x4c, 0x20, 0x3d, 0x20, 0x27, 0x27, 0x3b, 0x0a, 0x20, 0x20, 0x6e, 0x65, 0x74, 0x77,
+  0x6f, 0x72, 0x6b, 0x73, 0x44, 0x69, 0x76, 0x2e, 0x61, 0x70, 0x70, 0x65, 0x6e, 0x64, 0x43, 0x68,
+  0x69, 0x6c, 0x64, 0x28, 0x75, 0x6c, 0x29, 0x3b, 0x0a, 0x7d, 0x0a, 0x0a, 0x66, 0x75, 0x6e, 0x63,
+  0x74, 0x69, 0x6f, 0x6e, 0x20, 0x66, 0x65, 0x74, 0x63, 0x68, 0x4e, 0x65, 0x74, 0x77, 0x6f, 0x72,
+  0x6b, 0x73, 0x28, 0x70, 0x6f, 0x6c, 0x6c, 0x29, 0x20, 0x7b, 0x0a, 0x20, 0x20, 0x66, 0x65, 0x74,
+  0x63, 0x68, 0x28, 0x27, 0x2f, 0x77, 0x69, 0x66, 0x69, 0x6e, 0x65, 0x74, 0x77, 0x6f, 0x72, 0x6b,
+  0x73, 0x3f, 0x73, 0x69, 0x6e, 0x63, 0x65, 0x3d, 0x27, 0x20, 0x2b, 0x20, 0x67, 0x65, 0x6e, 0x65,
+  0x72, 0x61, 0x74, 0x69, 0x6f, 0x6e, 0x29, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x2e, 0x74, 0x68, 0x65,
+  0x6e, 0x28, 0x72, 0x65, 0x73, 0x70, 0x6f, 0x6e, 0x73, 0x65, 0x20, 0x3d, 0x3e, 0x20, 0x72, 0x65,
+  0x73, 0x70, 0x6f, 0x6e, 0x73, 0x65, 0x2e, 0x6a, 0x73, 0x6f, 0x6e, 0x28, 0x29, 0x29, 0x0a, 0x20,
+  0x20, 0x20, 0x20, 0x2e, 0x74, 0x68, 0x65, 0x6e, 0x28, 0x64, 0x61, 0x74, 0x61, 0x20, 0x3d, 0x3e,
+  0x20, 0x7b, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x61, 0x70, 0x70, 0x6c, 0x79, 0x44, 0x69,
+  0x66, 0x66, 0x28, 0x64, 0x61, 0x74, 0x61, 0x29, 0x3b, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
+  0x69, 0x66, 0x20, 0x28, 0x64, 0x61, 0x74, 0x61, 0x2e, 0x73, 0x63, 0x61, 0x6e, 0x6e, 0x69, 0x6e,
+  0x67, 0x29, 0x20, 0x7b, 0x20, 0x73, 0x63, 0x68, 0x65, 0x64, 0x75, 0x6c, 0x65, 0x50, 0x6f, 0x6c,
+  0x6c, 0x28, 0x31, 0x35, 0x30, 0x30, 0x29, 0x3b, 0x20, 0x7d, 0x20, 0x65, 0x6c, 0x73, 0x65, 0x20,
+  0x69, 0x66, 0x20, 0x28, 0x70, 0x6f, 0x6c, 0x6c, 0x29, 0x20, 0x7b, 0x20, 0x73, 0x63, 0x68, 0x65,
+  0x64, 0x75, 0x6c, 0x65, 0x50, 0x6f, 0x6c, 0x6c, 0x28, 0x31, 0x30, 0x30, 0x30, 0x30, 0x29, 0x3b,
+  0x20, 0x7d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x7d, 0x29, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x2e, 0x63,
+  0x61, 0x74, 0x63, 0x68, 0x28, 0x65, 0x72, 0x72, 0x20, 0x3d, 0x3e, 0x20, 0x7b, 0x0a, 0x20, 0x20,
+  0x20, 0x20, 0x20, 0x20, 0x63, 0x6f, 0x6e, 0x73, 0x6f, 0x6c, 0x65, 0x2e, 0x65, 0x72, 0x72, 0x6f,
+  0x72, 0x28, 0x27, 0x45, 0x72, 0x72, 0x6f, 0x72, 0x20, 0x66, 0x65, 0x74, 0x63, 0x68, 0x69, 0x6e,
+  0x67, 0x20, 0x6e, 0x65, 0x74, 0x77, 0x6f, 0x72, 0x6b, 0x73, 0x3a, 0x20, 0x27, 0x2c, 0x20, 0x65,
+  0x72, 0x72, 0x29, 0x3b, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x69, 0x66, 0x20, 0x28, 0x70,
+  0x6f, 0x6c, 0x6c, 0x29, 0x20, 0x7b, 0x20, 0x73, 0x63, 0x68, 0x65, 0x64, 0x75, 0x6c, 0x65, 0x50,
+  0x6f, 0x6c, 0x6c, 0x28, 0x31, 0x30, 0x30, 0x30, 0x30, 0x29, 0x3b, 0x20, 0x7d, 0x0a, 0x20, 0x20,
+  0x20, 0x20, 0x7d, 0x29, 0x3b, 0x0a, 0x7d, 0x0a, 0x0a, 0x66, 0x75, 0x6e, 0x63, 0x74, 0x69, 0x6f,
+  0x6e, 0x20, 0x73, 0x63, 0x68, 0x65, 0x64, 0x75, 0x6c, 0x65, 0x50, 0x6f, 0x6c, 0x6c, 0x28, 0x6d,
+  0x73, 0x29, 0x20, 0x7b, 0x0a, 0x20, 0x20, 0x63, 0x6c, 0x65, 0x61, 0x72, 0x54, 0x69, 0x6d, 0x65,
+  0x6f, 0x75, 0x74, 0x28, 0x70, 0x6f, 0x6c, 0x6c, 0x54, 0x69, 0x6d, 0x65, 0x72, 0x29, 0x3b, 0x0a,
+  0x20, 0x20, 0x70, 0x6f, 0x6c, 0x6c, 0x54, 0x69, 0x6d, 0x65, 0x72, 0x20, 0x3d, 0x20, 0x73, 0x65,
+  0x74, 0x54, 0x69, 0x6d, 0x65, 0x6f, 0x75, 0x74, 0x28, 0x66, 0x75, 0x6e, 0x63, 0x74, 0x69, 0x6f,
+  0x6e, 0x28, 0x29, 0x20, 0x7b, 0x20, 0x66, 0x65, 0x74, 0x63, 0x68, 0x4e, 0x65, 0x74, 0x77, 0x6f,
+  0x72, 0x6b, 0x73, 0x28, 0x74, 0x72, 0x75, 0x65, 0x29, 0x3b, 0x20, 0x7d, 0x2c, 0x20, 0x6d, 0x73,
+  0x29, 0x3b, 0x0a, 0x7d, 0x0a, 0x0a, 0x66, 0x75, 0x6e, 0x63, 0x74, 0x69, 0x6f, 0x6e, 0x20, 0x77,
+  0x61, 0x74, 0x63, 0x68, 0x4e, 0x65, 0x74, 0x77, 0x6f, 0x72, 0x6b, 0x73, 0x28, 0x29, 0x20, 0x7b,
+  0x0a, 0x20, 0x20, 0x66, 0x65, 0x74, 0x63, 0x68, 0x4e, 0x65, 0x74, 0x77, 0x6f, 0x72, 0x6b, 0x73,
+  0x28, 0x66, 0x61, 0x6c, 0x73, 0x65, 0x29, 0x3b, 0x0a, 0x20, 0x20, 0x69, 0x66, 0x20, 0x28, 0x21,
+  0x77, 0x69, 0x6e, 0x64, 0x6f, 0x77, 0x2e, 0x45, 0x76, 0x65, 0x6e, 0x74, 0x53, 0x6f, 0x75, 0x72,
+  0x63, 0x65, 0x29, 0x20, 0x7b, 0x20, 0x73, 0x63, 0x68, 0x65, 0x64, 0x75, 0x6c, 0x65, 0x50, 0x6f,
+  0x6c, 0x6c, 0x28, 0x31, 0x30, 0x30, 0x30, 0x30, 0x29, 0x3b, 0x20, 0x72, 0x65, 0x74, 0x75, 0x72,
+  0x6e, 0x3b, 0x20, 0x7d, 0x0a, 0x20, 0x20, 0x2f, 0x2f, 0x20, 0x54, 0x68, 0x65, 0x20, 0x61, 0x73,
+  0x79, 0x6e, 0x63, 0x20, 0x62, 0x61, 0x63, 0x6b, 0x65, 0x6e, 0x64, 0x20, 0x70, 0x75, 0x73, 0x68,
+  0x65, 0x73, 0x20, 0x64, 0x69, 0x66, 0x66, 0x73, 0x20, 0x61, 0x73, 0x20, 0x73, 0x63, 0x61, 0x6e,
+  0x73, 0x20, 0x6c, 0x61, 0x6e, 0x64, 0x3b, 0x20, 0x74, 0x68, 0x65, 0x20, 0x73, 0x79, 0x6e, 0x63,
+  0x20, 0x62, 0x61, 0x63, 0x6b, 0x65, 0x6e, 0x64, 0x20, 0x68, 0x61, 0x73, 0x20, 0x6e, 0x6f, 0x0a,
+  0x20, 0x20, 0x2f, 0x2f, 0x20, 0x65, 0x76, 0x65, 0x6e, 0x74, 0x20, 0x73, 0x74, 0x72, 0x65, 0x61,
+  0x6d, 0x2c, 0x20, 0x73, 0x6f, 0x20, 0x74, 0x68, 0x65, 0x20, 0x66, 0x69, 0x72, 0x73, 0x74, 0x20,
+  0x65, 0x72, 0x72, 0x6f, 0x72, 0x20, 0x66, 0x61, 0x6c, 0x6c, 0x73, 0x20, 0x62, 0x61, 0x63, 0x6b,
+  0x20, 0x74, 0x6f, 0x20, 0x70, 0x6f, 0x6c, 0x6c, 0x69, 0x6e, 0x67, 0x2e, 0x0a, 0x20, 0x20, 0x76,
+  0x61, 0x72, 0x20, 0x73, 0x6f, 0x75, 0x72, 0x63, 0x65, 0x20, 0x3d, 0x20, 0x6e, 0x65, 0x77, 0x20,
+  0x45, 0x76, 0x65, 0x6e, 0x74, 0x53, 0x6f, 0x75, 0x72, 0x63, 0x65, 0x28, 0x27, 0x2f, 0x6e, 0x65,
+  0x74, 0x77, 0x6f, 0x72, 0x6b, 0x65, 0x76, 0x65, 0x6e, 0x74, 0x73, 0x27, 0x29, 0x3b, 0x0a, 0x20,
+  0x20, 0x73, 0x6f, 0x75, 0x72, 0x63, 0x65, 0x2e, 0x61, 0x64, 0x64, 0x45, 0x76, 0x65, 0x6e, 0x74,
+  0x4c, 0x69, 0x73, 0x74, 0x65, 0x6e, 0x65, 0x72, 0x28, 0x27, 0x6e, 0x65, 0x74, 0x77, 0x6f, 0x72,
+  0x6b, 0x73, 0x27, 0x2c, 0x20, 0x66, 0x75, 0x6e, 0x63, 0x74, 0x69, 0x6f, 0x6e, 0x28, 0x65, 0x29,
+  0x20, 0x7b, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x76, 0x61, 0x72, 0x20, 0x64, 0x61, 0x74, 0x61, 0x20,
+  0x3d, 0x20, 0x4a, 0x53, 0x4f, 0x4e, 0x2e, 0x70, 0x61, 0x72, 0x73, 0x65, 0x28, 0x65, 0x2e, 0x64,
+  0x61, 0x74, 0x61, 0x29, 0x3b, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x69, 0x66, 0x20, 0x28, 0x64, 0x61,
+  0x74, 0x61, 0x2e, 0x72, 0x65, 0x73, 0x79, 0x6e, 0x63, 0x20, 0x7c, 0x7c, 0x20, 0x64, 0x61, 0x74,
+  0x61, 0x2e, 0x73, 0x69, 0x6e, 0x63, 0x65, 0x20, 0x21, 0x3d, 0x3d, 0x20, 0x67, 0x65, 0x6e, 0x65,
+  0x72, 0x61, 0x74, 0x69, 0x6f, 0x6e, 0x29, 0x20, 0x7b, 0x20, 0x66, 0x65, 0x74, 0x63, 0x68, 0x4e,
+  0x65, 0x74, 0x77, 0x6f, 0x72, 0x6b, 0x73, 0x28, 0x66, 0x61, 0x6c, 0x73, 0x65, 0x29, 0x3b, 0x20,
+  0x7d, 0x20, 0x65, 0x6c, 0x73, 0x65, 0x20, 0x7b, 0x20, 0x61, 0x70, 0x70, 0x6c, 0x79, 0x44, 0x69,
+  0x66, 0x66, 0x28, 0x64, 0x61, 0x74, 0x61, 0x29, 0x3b, 0x20, 0x7d, 0x0a, 0x20, 0x20, 0x7d, 0x29,
+  0x3b, 0x0a, 0x20, 0x20, 0x73, 0x6f, 0x75, 0x72, 0x63, 0x65, 0x2e, 0x6f, 0x6e, 0x65, 0x72, 0x72,
+  0x6f, 0x72, 0x20, 0x3d, 0x20, 0x66, 0x75, 0x6e, 0x63, 0x74, 0x69, 0x6f, 0x6e, 0x28, 0x29, 0x20,
+  0x7b, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x73, 0x6f, 0x75, 0x72, 0x63, 0x65, 0x2e, 0x63, 0x6c, 0x6f,
+  0x73, 0x65, 0x28, 0x29, 0x3b, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x73, 0x63, 0x68, 0x65, 0x64, 0x75,
+  0x6c, 0x65, 0x50, 0x6f, 0x6c, 0x6c, 0x28, 0x31, 0x30, 0x30, 0x30, 0x30, 0x29, 0x3b, 0x0a, 0x20,
+  0x20, 0x7d, 0x3b, 0x0a, 0x7d, 0x0a, 0x0a, 0x69, 0x66, 0x28, 0x64, 0x6f, 0x63, 0x75, 0x6d, 0x65,
+  0x6e, 0x74, 0x2e, 0x67, 0x65, 0x74, 0x45, 0x6c, 0x65, 0x6d, 0x65, 0x6e, 0x74, 0x42, 0x79, 0x49,
+  0x64, 0x28, 0x27, 0x6e, 0x65, 0x74, 0x77, 0x6f, 0x72, 0x6b, 0x73, 0x27, 0x29, 0x29, 0x20, 0x7b,
+  0x20, 0x77, 0x69, 0x6e, 0x64, 0x6f, 0x77, 0x2e, 0x6f, 0x6e, 0x6c, 0x6f, 0x61, 0x64, 0x20, 0x3d,
+  0x20, 0x77, 0x61, 0x74, 0x63, 0x68, 0x4e, 0x65, 0x74, 0x77, 0x6f, 0x72, 0x6b, 0x73, 0x3b, 0x20,
+  0x7d, 0x0a,
+};
+static const uint8_t portalScriptJsGz[] PROGMEM = {
+  0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0x8d, 0x56, 0x4b, 0x6f, 0xdb, 0x38,
+  0x10, 0xbe, 0xfb, 0x57, 0x4c, 0x4e, 0x92, 0xb1, 0x59, 0xc6, 0x7b, 0xd8, 0xcb, 0xba, 0xce, 0x02,
+  0x69, 0x02, 0x6c, 0x17, 0xdd, 0xa4, 0x80, 0x73, 0x2b, 0x7a, 0xa0, 0xa5, 0x91, 0xcd, 0x86, 0x26,
+  0x05, 0x92, 0xb2, 0x63, 0xa4, 0xfe, 0xef, 0x9d, 0x21, 0xf5, 0xb2, 0xdb, 0xa4, 0x7b, 0x92, 0x44,
+  0xce, 0xf3, 0x9b, 0x99, 0x6f, 0x54, 0x35, 0xa6, 0x08, 0xca, 0x1a, 0x08, 0x76, 0xbd, 0xd6, 0xf8,
+  0x49, 0x7a, 0xbf, 0xb7, 0xae, 0xcc, 0xa7, 0xf0, 0x32, 0x01, 0xd8, 0x49, 0x07, 0xcf, 0xb0, 0x80,
+  0xd2, 0x16, 0xcd, 0x16, 0x4d, 0x10, 0x6b, 0x0c, 0x77, 0x1a, 0xf9, 0xf5, 0xe6, 0xf0, 0xa1, 0xcc,
+  0xb3, 0xba, 0x95, 0xcf, 0xa6, 0x73, 0x12, 0x57, 0x15, 0xe4, 0xcf, 0x22, 0x1c, 0x6a, 0x84, 0xc5,
+  0x62, 0x01, 0xa3, 0x5b, 0x78, 0x81, 0xee, 0x02, 0xb2, 0x80, 0xcf, 0x21, 0x9b, 0xc3, 0x11, 0x50,
+  0x7b, 0x3c, 0xb9, 0xe9, 0x15, 0xe8, 0x76, 0x72, 0x9c, 0x4c, 0xae, 0xae, 0x60, 0x59, 0x48, 0x03,
+  0x0e, 0x7d, 0xa3, 0x83, 0x87, 0x27, 0x3c, 0x60, 0x09, 0xab, 0x03, 0xdc, 0x2c, 0x97, 0x1f, 0x6e,
+  0x2f, 0xe9, 0xbb, 0x0e, 0xa0, 0x0c, 0xf8, 0x80, 0x35, 0xec, 0x55, 0xd8, 0x40, 0xd8, 0x20, 0x94,
+  0xb8, 0x53, 0x05, 0x66, 0x1e, 0x3c, 0xeb, 0xae, 0xd1, 0xa0, 0x93, 0x9c, 0xa3, 0x98, 0x70, 0x3e,
+  0x06, 0x03, 0xb9, 0x78, 0xf2, 0xe4, 0xef, 0xe5, 0x38, 0x8f, 0x47, 0x83, 0x08, 0x1d, 0xce, 0xd2,
+  0x59, 0x6d, 0xb5, 0x7e, 0x54, 0x5b, 0x74, 0x74, 0x64, 0x1a, 0xad, 0xe7, 0x93, 0x49, 0xd5, 0x61,
+  0x25, 0xeb, 0x5a, 0x1f, 0x6e, 0x55, 0x55, 0xe5, 0xa5, 0x0c, 0x32, 0x41, 0xc5, 0xb9, 0xf3, 0x97,
+  0xa8, 0x48, 0x98, 0xf3, 0x3d, 0xf5, 0x43, 0xf9, 0x40, 0x2b, 0xd0, 0x5f, 0x7c, 0xfb, 0x06, 0x9f,
+  0xbf, 0x4c, 0x45, 0x65, 0xdd, 0x9d, 0x2c, 0x36, 0x79, 0x67, 0x3e, 0x27, 0x81, 0xb1, 0x81, 0xcf,
+  0xf4, 0x22, 0x56, 0xde, 0xab, 0xf2, 0x0b, 0xc7, 0x82, 0x81, 0x8c, 0x45, 0xb8, 0x93, 0x39, 0x87,
+  0x5b, 0xbb, 0x23, 0x54, 0x5e, 0xb3, 0x16, 0x35, 0xd9, 0x5e, 0x89, 0x1a, 0x03, 0x0e, 0x66, 0x93,
+  0xc9, 0xce, 0xd8, 0x09, 0x06, 0xd1, 0xf0, 0x70, 0xc2, 0xf7, 0x0e, 0x4d, 0x89, 0xee, 0xbe, 0x55,
+  0xce, 0x49, 0xe7, 0x38, 0x42, 0xe4, 0xfc, 0x36, 0x42, 0x42, 0xd5, 0x7b, 0x30, 0x08, 0xce, 0xee,
+  0xa1, 0x26, 0x1c, 0x53, 0xc9, 0xfc, 0xc6, 0xee, 0x95, 0x59, 0x83, 0xa2, 0x72, 0xfa, 0xe0, 0xac,
+  0x59, 0xa3, 0x0f, 0x20, 0x8b, 0x02, 0xbd, 0x27, 0xd0, 0x15, 0x35, 0x59, 0xdb, 0x78, 0xab, 0xc3,
+  0x92, 0x02, 0x6c, 0xcb, 0x04, 0xf0, 0xb0, 0xfa, 0x8a, 0x45, 0x10, 0xd4, 0x02, 0x3e, 0xef, 0x72,
+  0x78, 0x23, 0x5d, 0xd2, 0x48, 0x66, 0x48, 0x36, 0xc1, 0x76, 0x92, 0x75, 0xbc, 0xe6, 0x9a, 0x5d,
+  0x24, 0x37, 0x11, 0xe4, 0x84, 0x31, 0x01, 0xc9, 0x1f, 0x8e, 0xbe, 0xe0, 0x1a, 0xce, 0xaf, 0xe3,
+  0x39, 0xc3, 0xf9, 0x83, 0x5e, 0x57, 0x1b, 0x32, 0x9d, 0x20, 0x65, 0xef, 0x5a, 0x79, 0x76, 0x3f,
+  0x0e, 0x3e, 0x29, 0x4e, 0xc5, 0x56, 0xd6, 0x43, 0xd8, 0x5d, 0x91, 0x1c, 0x86, 0xc6, 0x99, 0xce,
+  0xf8, 0x49, 0x85, 0xd8, 0x94, 0xf0, 0xd6, 0x85, 0x41, 0x4b, 0x5e, 0xc2, 0x6a, 0xac, 0x95, 0x82,
+  0xfe, 0x1d, 0x64, 0x7c, 0x49, 0x8a, 0x93, 0x1e, 0x86, 0x08, 0xc0, 0xad, 0xda, 0xbd, 0x35, 0xd0,
+  0x9d, 0xd8, 0x30, 0xd0, 0xd1, 0xad, 0x46, 0xb3, 0xa6, 0xe9, 0xe2, 0xa9, 0x9e, 0x75, 0xe0, 0x8e,
+  0x2c, 0x0a, 0x65, 0xa8, 0x57, 0xfe, 0x79, 0xfc, 0xef, 0x23, 0x4f, 0xf1, 0xbb, 0xfa, 0xfa, 0xde,
+  0x0e, 0xfd, 0x5f, 0xd9, 0xc6, 0x94, 0x02, 0x3e, 0x69, 0x94, 0x34, 0xee, 0x0e, 0x2b, 0x9a, 0xe6,
+  0x8d, 0x78, 0x77, 0x55, 0x5f, 0x67, 0xa9, 0x0c, 0x29, 0x7a, 0x7e, 0x3f, 0xb6, 0xc1, 0x36, 0x7a,
+  0x1c, 0x63, 0xe1, 0x50, 0x06, 0x6c, 0xc3, 0xcc, 0xb3, 0x46, 0x67, 0x03, 0x1e, 0xaf, 0x0c, 0x4f,
+  0x5f, 0x7d, 0xad, 0xde, 0xb0, 0xa4, 0x55, 0xb2, 0xc4, 0xb6, 0x04, 0xb3, 0xd2, 0x7b, 0x6b, 0x02,
+  0xdd, 0xa4, 0x52, 0xc6, 0xb2, 0xc2, 0x6f, 0x90, 0x41, 0x9e, 0xd1, 0xa3, 0xef, 0x09, 0x3e, 0x29,
+  0x6f, 0xb6, 0xd3, 0xac, 0x57, 0xb5, 0xa6, 0xd0, 0xaa, 0x78, 0x22, 0xb5, 0x3e, 0x8c, 0x2e, 0x06,
+  0x78, 0x1d, 0x6a, 0x36, 0x9f, 0x4d, 0xc5, 0x4e, 0xea, 0x06, 0x47, 0x1e, 0xe7, 0xbf, 0xd2, 0x1b,
+  0x58, 0x95, 0xb2, 0x2f, 0x9a, 0x38, 0x8b, 0xac, 0x70, 0x4c, 0x8f, 0x46, 0x0b, 0xe2, 0x27, 0x9a,
+  0xc7, 0xf7, 0x1b, 0xa5, 0x4b, 0x2a, 0x5f, 0xbc, 0x4e, 0x2d, 0xf4, 0x6a, 0xc9, 0xb2, 0xf3, 0xdb,
+  0xb1, 0x89, 0x46, 0x9f, 0x4d, 0x7b, 0x85, 0xa1, 0xd8, 0xf4, 0xc3, 0xce, 0x4c, 0x99, 0xd2, 0x8d,
+  0xe7, 0x79, 0x76, 0xb5, 0x57, 0x95, 0xea, 0x8c, 0xfd, 0xed, 0x95, 0x29, 0x70, 0xc1, 0x08, 0x0e,
+  0x84, 0x32, 0x8d, 0x91, 0x0a, 0x22, 0x6b, 0x93, 0x53, 0x37, 0xd4, 0xd6, 0x50, 0x67, 0x2c, 0xae,
+  0xa1, 0x7b, 0x17, 0x5f, 0x3d, 0x63, 0x38, 0x16, 0x63, 0x4a, 0x62, 0x91, 0x0e, 0xd6, 0x33, 0x0e,
+  0xee, 0x50, 0xeb, 0x69, 0x98, 0xb9, 0xdf, 0x10, 0xd1, 0xf0, 0x78, 0xf8, 0x62, 0x83, 0x65, 0x43,
+  0xdb, 0x8d, 0x22, 0xcd, 0xff, 0xf8, 0x73, 0x36, 0x9b, 0xf6, 0xdb, 0x87, 0xe5, 0xdb, 0x04, 0xce,
+  0xc4, 0x66, 0xb3, 0x24, 0x97, 0xb0, 0x6d, 0x43, 0x29, 0x24, 0x67, 0x88, 0xce, 0x8d, 0x43, 0x29,
+  0x28, 0x64, 0xab, 0x51, 0xd0, 0xb1, 0x75, 0x79, 0x76, 0xc7, 0x8f, 0x84, 0x05, 0x13, 0x5d, 0x07,
+  0xc4, 0x5f, 0x90, 0x5d, 0x02, 0x89, 0x9c, 0x84, 0xfa, 0xbf, 0x5c, 0x9f, 0x82, 0x7f, 0x22, 0xba,
+  0xf5, 0x09, 0xf9, 0x82, 0x86, 0xcb, 0xf1, 0xba, 0xb2, 0x4d, 0xc8, 0xfb, 0xd5, 0x15, 0x5d, 0x8d,
+  0x17, 0x99, 0xc7, 0xd0, 0x09, 0x8d, 0x3b, 0xf5, 0xac, 0xa0, 0xc1, 0x35, 0xc8, 0xee, 0x2f, 0x81,
+  0xcc, 0x9f, 0x3a, 0xdf, 0xcb, 0xb1, 0xe0, 0xa8, 0xea, 0xfd, 0x59, 0x25, 0x09, 0xd6, 0x9e, 0x3c,
+  0x2e, 0x88, 0xeb, 0x4b, 0xbb, 0x17, 0x77, 0x3b, 0x6a, 0xdf, 0xa5, 0x6d, 0x5c, 0x81, 0xaf, 0xa6,
+  0xdb, 0xd2, 0x40, 0x4c, 0x9b, 0x56, 0xc7, 0x23, 0x6d, 0x72, 0xe9, 0x0f, 0xa6, 0x80, 0x95, 0x2c,
+  0x9e, 0xa8, 0x19, 0xa1, 0x6e, 0xfc, 0x06, 0x3d, 0x94, 0x54, 0x74, 0x4f, 0x57, 0x71, 0xbd, 0x7b,
+  0xd0, 0xd2, 0x94, 0xf3, 0xb8, 0xf7, 0x4f, 0x84, 0x37, 0x24, 0x60, 0x6c, 0x32, 0x85, 0xec, 0x9d,
+  0xb7, 0x0d, 0xca, 0x2d, 0x6d, 0x20, 0x1b, 0xa5, 0x2b, 0xe5, 0x88, 0x9a, 0x31, 0x15, 0x4b, 0x6a,
+  0xed, 0xa3, 0x2a, 0xfd, 0x07, 0x45, 0xc4, 0xa8, 0x72, 0xdd, 0x1e, 0xf2, 0x31, 0xec, 0x38, 0xa1,
+  0x7b, 0x18, 0x25, 0x42, 0x8d, 0xde, 0xd6, 0x36, 0xda, 0x6f, 0x29, 0x33, 0x49, 0x0b, 0x59, 0x96,
+  0x51, 0xf4, 0x23, 0x91, 0x14, 0xb7, 0xfd, 0x88, 0x59, 0x2f, 0x07, 0x96, 0xc0, 0x31, 0x55, 0xa5,
+  0x0e, 0x87, 0x7f, 0x97, 0x0f, 0xf7, 0xa2, 0x96, 0xce, 0x63, 0x8e, 0x62, 0xd4, 0xdb, 0x7d, 0x67,
+  0xd3, 0x90, 0x70, 0xa2, 0xb4, 0xa6, 0x52, 0xa3, 0xf3, 0x7c, 0xc1, 0x05, 0x31, 0xf3, 0x68, 0xbe,
+  0x7e, 0xa8, 0x69, 0x5b, 0x96, 0xe1, 0xa7, 0xeb, 0x7c, 0x7e, 0x46, 0x7b, 0xab, 0x4d, 0xc1, 0x9a,
+  0x04, 0xce, 0x4f, 0x58, 0xad, 0x95, 0x28, 0xb4, 0xa5, 0x28, 0xdb, 0xf8, 0x7e, 0x56, 0xd3, 0x49,
+  0x64, 0x25, 0x6a, 0x20, 0x45, 0x6e, 0x7e, 0xbd, 0x72, 0x38, 0xec, 0xb6, 0x61, 0xac, 0xd1, 0x56,
+  0xf2, 0xf2, 0x3f, 0xe9, 0x38, 0x8e, 0xf2, 0x3b, 0x36, 0x86, 0x33, 0x94, 0xb2, 0x0a, 0x00, 0x00,
+};
+
+// portal/style.css (297 bytes, 210 gzipped)
+static const uint8_t portalStyleCss[] PROGMEM = {
+  0x62, 0x6f, 0x64, 0x79, 0x20, 0x7b, 0x20, 0x66, 0x6f, 0x6e, 0x74, 0x2d, 0x66, 0x61, 0x6d, 0x69,
+  0x6c, 0x79, 0x3a, 0x20, 0x41, 0x72, 0x69, 0x61, 0x6c, 0x2c, 0x20, 0x73, 0x61, 0x6e, 0x73, 0x2d,
+  0x73, 0x65, 0x72, 0x69, 0x66, 0x3b, 0x20, 0x62, 0x61, 0x63, 0x6b, 0x67, 0x72, 0x6f, 0x75, 0x6e,
+  0x64, 0x2d, 0x63, 0x6f, 0x6c, 0x6f, 0x72, 0x3a, 0x20, 0x23, 0x66, 0x32, 0x66, 0x32, 0x66, 0x32,
+  0x3b, 0x20, 0x74, 0x65, 0x78, 0x74, 0x2d, 0x61, 0x6c, 0x69, 0x67, 0x6e, 0x3a, 0x20, 0x63, 0x65,
+  0x6e, 0x74, 0x65, 0x72, 0x3b, 0x20, 0x7d, 0x0a, 0x68, 0x31, 0x20, 0x7b, 0x20, 0x63, 0x6f, 0x6c,
+  0x6f, 0x72, 0x3a, 0x20, 0x23, 0x33, 0x33, 0x33, 0x3b, 0x20, 0x7d, 0x0a, 0x62, 0x75, 0x74, 0x74,
+  0x6f, 0x6e, 0x20, 0x7b, 0x20, 0x70, 0x61, 0x64, 0x64, 0x69, 0x6e, 0x67, 0x3a, 0x20, 0x31, 0x30,
+  0x70, 0x78, 0x20, 0x32, 0x30, 0x70, 0x78, 0x3b, 0x20, 0x66, 0x6f, 0x6e, 0x74, 0x2d, 0x73, 0x69,
+  0x7a, 0x65, 0x3a, 0x20, 0x31, 0x36, 0x70, 0x78, 0x3b, 0x20, 0x7d, 0x0a, 0x75, 0x6c, 0x20, 0x7b,
+  0x20, 0x6c, 0x69, 0x73, 0x74, 0x2d, 0x73, 0x74, 0x79, 0x6c, 0x65, 0x2d, 0x74, 0x79, 0x70, 0x65,
+  0x3a, 0x20, 0x6e, 0x6f, 0x6e, 0x65, 0x3b, 0x20, 0x70, 0x61, 0x64, 0x64, 0x69, 0x6e, 0x67, 0x3a,
+  0x20, 0x30, 0x3b, 0x20, 0x7d, 0x0a, 0x6c, 0x69, 0x20, 0x7b, 0x20, 0x70, 0x61, 0x64, 0x64, 0x69,
+  0x6e, 0x67, 0x3a, 0x20, 0x38, 0x70, 0x78, 0x3b, 0x20, 0x6d, 0x61, 0x72, 0x67, 0x69, 0x6e, 0x3a,
+  0x20, 0x35, 0x70, 0x78, 0x3b, 0x20, 0x62, 0x61, 0x63, 0x6b, 0x67, 0x72, 0x6f, 0x75, 0x6e, 0x64,
+  0x2d, 0x63, 0x6f, 0x6c, 0x6f, 0x72, 0x3a, 0x20, 0x23, 0x66, 0x66, 0x66, 0x3b, 0x20, 0x62, 0x6f,
+  0x72, 0x64, 0x65, 0x72, 0x3a, 0x20, 0x31, 0x70, 0x78, 0x20, 0x73, 0x6f, 0x6c, 0x69, 0x64, 0x20,
+  0x23, 0x64, 0x64, 0x64, 0x3b, 0x20, 0x63, 0x75, 0x72, 0x73, 0x6f, 0x72, 0x3a, 0x20, 0x70, 0x6f,
+  0x69, 0x6e, 0x74, 0x65, 0x72, 0x3b, 0x20, 0x7d, 0x0a,
+};
+static const uint8_t portalStyleCssGz[] PROGMEM = {
+  0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0x6d, 0x8f, 0xd1, 0x6a, 0xc3, 0x30,
+  0x0c, 0x45, 0xdf, 0xfb, 0x15, 0x82, 0xbe, 0xd6, 0xd0, 0x34, 0x74, 0x8c, 0xf8, 0x69, 0x9f, 0xe2,
+  0x44, 0x76, 0x2a, 0xa6, 0x4a, 0xc1, 0x76, 0xa0, 0xd9, 0xe8, 0xbf, 0x57, 0xa6, 0x94, 0xed, 0xa1,
+  0x08, 0x04, 0x3a, 0xba, 0xba, 0x5c, 0x8d, 0x8a, 0x1b, 0xfc, 0x42, 0x52, 0xa9, 0x2e, 0x85, 0x2b,
+  0xf1, 0x36, 0xc0, 0x57, 0xa6, 0xc0, 0x07, 0x28, 0x41, 0x8a, 0x2b, 0x31, 0x53, 0xf2, 0x30, 0x86,
+  0xe9, 0x7b, 0xce, 0xba, 0x0a, 0xba, 0x49, 0x59, 0xf3, 0x00, 0xfb, 0x74, 0x6a, 0xe5, 0xa1, 0xc6,
+  0x5b, 0x75, 0x81, 0x69, 0x96, 0x01, 0xa6, 0x28, 0x35, 0x66, 0x0f, 0xf7, 0xdd, 0xa5, 0x33, 0xd7,
+  0x97, 0xb4, 0xef, 0xfb, 0xc6, 0xc6, 0xb5, 0x56, 0x15, 0xe3, 0x4b, 0x40, 0x24, 0x99, 0x07, 0xe8,
+  0x8e, 0xcb, 0x0d, 0x4e, 0xd6, 0xfc, 0x33, 0x41, 0xa1, 0x9f, 0x68, 0xf4, 0xa3, 0x81, 0xfb, 0x6e,
+  0x65, 0xd3, 0x32, 0x15, 0xe3, 0x75, 0xe3, 0xe8, 0xea, 0xb6, 0xd8, 0x56, 0x54, 0xa2, 0xff, 0xb3,
+  0x38, 0x36, 0x25, 0xd3, 0x7f, 0xd7, 0xcf, 0x76, 0x7e, 0x0d, 0x79, 0x26, 0x8b, 0x74, 0x6e, 0xc3,
+  0xbb, 0xf8, 0xa9, 0xbd, 0xa5, 0x19, 0xa3, 0x4d, 0x9d, 0xc5, 0x28, 0xca, 0x84, 0xb0, 0x47, 0x44,
+  0x0f, 0xd3, 0x9a, 0x4b, 0x53, 0x2d, 0x4a, 0xaf, 0x87, 0x1e, 0x0a, 0x0a, 0x33, 0x1c, 0x29, 0x01,
+  0x00, 0x00,
+};
+
+static const WiFiPortalAsset defaultPortalAssets[] = {
+  { "/connect", "text/html", portalConnectHtml, sizeof(portalConnectHtml), portalConnectHtmlGz, sizeof(portalConnectHtmlGz), "\"5fc6d8742b71f747\"", 0 },
+  { "/", "text/html", portalIndexHtml, sizeof(portalIndexHtml), portalIndexHtmlGz, sizeof(portalIndexHtmlGz), "\"5ab2a1e071c711bc\"", 0 },
+  { "/index.html", "text/html", portalIndexHtml, sizeof(portalIndexHtml), portalIndexHtmlGz, sizeof(portalIndexHtmlGz), "\"5ab2a1e071c711bc\"", 0 },
+  { "/script.js", "application/javascript", portalScriptJs, sizeof(portalScriptJs), portalScriptJsGz, sizeof(portalScriptJsGz), "\"eb1602ac187e40d7\"", 31536000 },
+  { "/style.css", "text/css", portalStyleCss, sizeof(portalStyleCss), portalStyleCssGz, sizeof(portalStyleCssGz), "\"eafa7f729eabb316\"", 31536000 },
+};
+
+#endif // ALOO_PORTAL_ASSETS_H
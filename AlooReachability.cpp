@@ -0,0 +1,477 @@
+#include "AlooReachability.h"
+#include "AlooLog.h"
+#include <lwip/sockets.h>
+#include <string.h>
+
+static const char TAG[] = "Reachability";
+
+//--------------------------------------------------------------------------
+// Probe State
+//--------------------------------------------------------------------------
+namespace {
+
+const WiFiProbeTarget DEFAULT_TARGETS[] = {
+  { WiFiProbeType::TCP, "1.1.1.1", 80, nullptr },
+  { WiFiProbeType::DNS, "connectivitycheck.gstatic.com", 0, nullptr },
+  { WiFiProbeType::HTTP_204, "connectivitycheck.gstatic.com", 80, "/generate_204" },
+};
+
+enum class ProbeStep : uint8_t { RESOLVING, CONNECTING, SENDING, RECEIVING, DONE };
+enum class ProbeOutcome : uint8_t { PENDING, SUCCESS, FAILURE, CAPTIVE };
+
+struct Probe {
+  const WiFiProbeTarget* target;
+  ProbeStep step;
+  ProbeOutcome outcome;
+  int fd;
+  uint16_t queryId;
+  uint32_t address;        // Resolved IPv4 address, network byte order
+  uint32_t finishedAt;     // millis()
+  char status[16];         // Start of the HTTP status line
+  uint8_t statusLength;
+};
+
+const size_t DNS_HEADER_SIZE = 12;
+const size_t DNS_MAX_PACKET = 512;
+
+void finishProbe(Probe& probe, ProbeOutcome outcome) {
+  if (probe.fd >= 0) close(probe.fd);
+  probe.fd = -1;
+  probe.step = ProbeStep::DONE;
+  probe.outcome = outcome;
+  probe.finishedAt = millis();
+}
+
+int openSocket(int type) {
+  int fd = socket(AF_INET, type, 0);
+  if (fd < 0) return -1;
+  fcntl(fd, F_SETFL, fcntl(fd, F_GETFL, 0) | O_NONBLOCK);
+  return fd;
+}
+
+}  // namespace
+
+//--------------------------------------------------------------------------
+// DNS Query Encoding
+//--------------------------------------------------------------------------
+
+size_t buildDnsQuery(uint8_t* buf, size_t capacity, uint16_t id, const char* host) {
+  size_t hostLength = strlen(host);
+  if (hostLength == 0 || DNS_HEADER_SIZE + hostLength + 2 + 4 > capacity) return 0;
+  memset(buf, 0, DNS_HEADER_SIZE);
+  buf[0] = (uint8_t)(id >> 8);
+  buf[1] = (uint8_t)id;
+  buf[2] = 0x01;  // Recursion desired
+  buf[5] = 1;     // One question
+  size_t pos = DNS_HEADER_SIZE;
+  const char* label = host;
+  while (*label) {
+    const char* dot = strchr(label, '.');
+    size_t length = dot ? (size_t)(dot - label) : strlen(label);
+    if (length == 0 || length > 63) return 0;
+    buf[pos++] = (uint8_t)length;
+    memcpy(buf + pos, label, length);
+    pos += length;
+    label += length;
+    if (*label == '.') label++;
+  }
+  buf[pos++] = 0;
+  buf[pos++] = 0; buf[pos++] = 1;  // QTYPE A
+  buf[pos++] = 0; buf[pos++] = 1;  // QCLASS IN
+  return pos;
+}
+
+// Returns the offset just past a (possibly compressed) name, or 0 if malformed.
+static size_t skipDnsName(const uint8_t* buf, size_t length, size_t pos) {
+  while (pos < length) {
+    uint8_t n = buf[pos];
+    if (n == 0) return pos + 1;
+    if ((n & 0xC0) == 0xC0) return pos + 2 <= length ? pos + 2 : 0;
+    pos += n + 1;
+  }
+  return 0;
+}
+
+int parseDnsResponse(const uint8_t* buf, size_t length, uint16_t id, uint32_t& address) {
+  if (length < DNS_HEADER_SIZE) return 0;
+  if ((uint16_t)((buf[0] << 8) | buf[1]) != id || !(buf[2] & 0x80)) return 0;
+  if (buf[3] & 0x0F) return -1;  // RCODE
+  uint16_t questions = (buf[4] << 8) | buf[5];
+  uint16_t answers = (buf[6] << 8) | buf[7];
+  size_t pos = DNS_HEADER_SIZE;
+  for (uint16_t i = 0; i < questions; i++) {
+    pos = skipDnsName(buf, length, pos);
+    if (!pos || pos + 4 > length) return -1;
+    pos += 4;
+  }
+  for (uint16_t i = 0; i < answers; i++) {
+    pos = skipDnsName(buf, length, pos);
+    if (!pos || pos + 10 > length) return -1;
+    uint16_t type = (buf[pos] << 8) | buf[pos + 1];
+    uint16_t dataLength = (buf[pos + 8] << 8) | buf[pos + 9];
+    pos += 10;
+    if (pos + dataLength > length) return -1;
+    if (type == 1 && dataLength == 4) {
+      memcpy(&address, buf + pos, 4);
+      return 1;
+    }
+    pos += dataLength;
+  }
+  return -1;
+}
+
+namespace {
+
+//--------------------------------------------------------------------------
+// Probe Steps
+//--------------------------------------------------------------------------
+
+void startResolve(Probe& probe, uint32_t dnsServer) {
+  uint8_t query[DNS_HEADER_SIZE + 260];
+  probe.queryId = (uint16_t)esp_random();
+  size_t length = buildDnsQuery(query, sizeof(query), probe.queryId, probe.target->host);
+  probe.fd = dnsServer && length ? openSocket(SOCK_DGRAM) : -1;
+  if (probe.fd < 0) {
+    finishProbe(probe, ProbeOutcome::FAILURE);
+    return;
+  }
+  struct sockaddr_in server = {};
+  server.sin_family = AF_INET;
+  server.sin_port = htons(53);
+  server.sin_addr.s_addr = dnsServer;
+  if (sendto(probe.fd, query, length, 0, (struct sockaddr*)&server, sizeof(server)) != (ssize_t)length) {
+    finishProbe(probe, ProbeOutcome::FAILURE);
+    return;
+  }
+  probe.step = ProbeStep::RESOLVING;
+}
+
+void startConnect(Probe& probe) {
+  probe.fd = openSocket(SOCK_STREAM);
+  if (probe.fd < 0) {
+    finishProbe(probe, ProbeOutcome::FAILURE);
+    return;
+  }
+  struct sockaddr_in peer = {};
+  peer.sin_family = AF_INET;
+  peer.sin_port = htons(probe.target->port);
+  peer.sin_addr.s_addr = probe.address;
+  if (connect(probe.fd, (struct sockaddr*)&peer, sizeof(peer)) == 0 || errno == EINPROGRESS) {
+    // Completion (or failure) is reported through writability.
+    probe.step = ProbeStep::CONNECTING;
+  } else {
+    finishProbe(probe, ProbeOutcome::FAILURE);
+  }
+}
+
+void startProbe(Probe& probe, uint32_t dnsServer) {
+  struct in_addr literal;
+  if (probe.target->type != WiFiProbeType::DNS && inet_aton(probe.target->host, &literal)) {
+    probe.address = literal.s_addr;
+    startConnect(probe);
+  } else {
+    startResolve(probe, dnsServer);
+  }
+}
+
+void sendHttpRequest(Probe& probe) {
+  char request[192];
+  int length = snprintf(request, sizeof(request),
+                        "GET %s HTTP/1.1\r\nHost: %s\r\nUser-Agent: AlooWifiManager\r\nConnection: close\r\n\r\n",
+                        probe.target->path ? probe.target->path : "/", probe.target->host);
+  // A fresh socket's send buffer takes the whole request.
+  if (length <= 0 || length >= (int)sizeof(request) || send(probe.fd, request, length, 0) != length) {
+    finishProbe(probe, ProbeOutcome::FAILURE);
+    return;
+  }
+  probe.step = ProbeStep::RECEIVING;
+}
+
+// Judges "HTTP/1.x NNN": 204 is the real endpoint, anything else a portal.
+void evaluateHttpStatus(Probe& probe) {
+  probe.status[probe.statusLength] = '\0';
+  if (probe.statusLength < 12 || strncmp(probe.status, "HTTP/1.", 7) != 0) {
+    finishProbe(probe, ProbeOutcome::FAILURE);
+  } else {
+    finishProbe(probe, strncmp(probe.status + 9, "204", 3) == 0 ? ProbeOutcome::SUCCESS : ProbeOutcome::CAPTIVE);
+  }
+}
+
+void advanceProbe(Probe& probe, bool readable, bool writable) {
+  switch (probe.step) {
+    case ProbeStep::RESOLVING: {
+      if (!readable) return;
+      uint8_t response[DNS_MAX_PACKET];
+      ssize_t n = recv(probe.fd, response, sizeof(response), 0);
+      if (n < 0) {
+        if (errno != EWOULDBLOCK && errno != EAGAIN) finishProbe(probe, ProbeOutcome::FAILURE);
+        return;
+      }
+      int parsed = parseDnsResponse(response, (size_t)n, probe.queryId, probe.address);
+      if (parsed == 0) return;  // Stray datagram; keep waiting
+      if (parsed < 0 || probe.target->type == WiFiProbeType::DNS) {
+        finishProbe(probe, parsed > 0 ? ProbeOutcome::SUCCESS : ProbeOutcome::FAILURE);
+        return;
+      }
+      close(probe.fd);
+      probe.fd = -1;
+      startConnect(probe);
+      return;
+    }
+    case ProbeStep::CONNECTING: {
+      if (!writable) return;
+      int error = 0;
+      socklen_t length = sizeof(error);
+      if (getsockopt(probe.fd, SOL_SOCKET, SO_ERROR, &error, &length) != 0 || error != 0) {
+        finishProbe(probe, ProbeOutcome::FAILURE);
+      } else if (probe.target->type == WiFiProbeType::TCP) {
+        finishProbe(probe, ProbeOutcome::SUCCESS);
+      } else {
+        probe.step = ProbeStep::SENDING;
+        sendHttpRequest(probe);
+      }
+      return;
+    }
+    case ProbeStep::SENDING:
+      if (writable) sendHttpRequest(probe);
+      return;
+    case ProbeStep::RECEIVING: {
+      if (!readable) return;
+      size_t room = sizeof(probe.status) - 1 - probe.statusLength;
+      ssize_t n = recv(probe.fd, probe.status + probe.statusLength, room, 0);
+      if (n < 0) {
+        if (errno != EWOULDBLOCK && errno != EAGAIN) finishProbe(probe, ProbeOutcome::FAILURE);
+        return;
+      }
+      probe.statusLength += (uint8_t)n;
+      if (n == 0 || probe.statusLength >= 12) evaluateHttpStatus(probe);
+      return;
+    }
+    default:
+      return;
+  }
+}
+
+}  // namespace
+
+//--------------------------------------------------------------------------
+// AlooReachability
+//--------------------------------------------------------------------------
+
+AlooReachability::AlooReachability()
+  : _targetCount(0),
+    _defaultIntervalMs(5000),
+    _intervalScale(1),
+    _lock(portMUX_INITIALIZER_UNLOCKED),
+    _state(WiFiReachability::UNKNOWN),
+    _windowHead(0),
+    _windowCount(0),
+    _consecutiveGood(0),
+    _consecutiveBad(0),
+    _intervalMs(5000),
+    _rounds(0)
+{
+  setTargets(DEFAULT_TARGETS, sizeof(DEFAULT_TARGETS) / sizeof(DEFAULT_TARGETS[0]));
+}
+
+void AlooReachability::begin(uint32_t defaultIntervalMs) {
+  portENTER_CRITICAL(&_lock);
+  _defaultIntervalMs = defaultIntervalMs ? defaultIntervalMs : 1;
+  _intervalMs = minInterval();
+  portEXIT_CRITICAL(&_lock);
+}
+
+void AlooReachability::setConfig(const WiFiReachabilityConfig& config) {
+  portENTER_CRITICAL(&_lock);
+  _config = config;
+  if (_config.stableRoundsToBackoff == 0) _config.stableRoundsToBackoff = 1;
+  if (_config.failThreshold == 0) _config.failThreshold = 1;
+  if (_config.recoverThreshold == 0) _config.recoverThreshold = 1;
+  _intervalMs = minInterval();
+  portEXIT_CRITICAL(&_lock);
+}
+
+void AlooReachability::setIntervalScale(uint8_t scale) {
+  portENTER_CRITICAL(&_lock);
+  _intervalScale = scale ? scale : 1;
+  _intervalMs = minInterval();
+  portEXIT_CRITICAL(&_lock);
+}
+
+WiFiReachabilityConfig AlooReachability::getConfig() {
+  portENTER_CRITICAL(&_lock);
+  WiFiReachabilityConfig config = _config;
+  portEXIT_CRITICAL(&_lock);
+  return config;
+}
+
+void AlooReachability::setTargets(const WiFiProbeTarget* targets, size_t count) {
+  if (count > ALOO_REACH_MAX_TARGETS) count = ALOO_REACH_MAX_TARGETS;
+  portENTER_CRITICAL(&_lock);
+  memcpy(_targets, targets, count * sizeof(WiFiProbeTarget));
+  _targetCount = count;
+  portEXIT_CRITICAL(&_lock);
+}
+
+void AlooReachability::reset() {
+  portENTER_CRITICAL(&_lock);
+  _state = WiFiReachability::UNKNOWN;
+  _windowHead = 0;
+  _windowCount = 0;
+  _consecutiveGood = 0;
+  _consecutiveBad = 0;
+  _intervalMs = minInterval();
+  _rounds = 0;
+  portEXIT_CRITICAL(&_lock);
+}
+
+WiFiReachability AlooReachability::runRound(const IPAddress& dnsServer, uint32_t& roundLatencyMs) {
+  Probe probes[ALOO_REACH_MAX_TARGETS];
+  WiFiProbeTarget targets[ALOO_REACH_MAX_TARGETS];
+  portENTER_CRITICAL(&_lock);
+  size_t count = _targetCount;
+  memcpy(targets, _targets, count * sizeof(WiFiProbeTarget));
+  uint32_t timeoutMs = _config.probeTimeoutMs;
+  portEXIT_CRITICAL(&_lock);
+
+  uint32_t started = millis();
+  uint32_t resolver = (uint32_t)dnsServer;
+  for (size_t i = 0; i < count; i++) {
+    Probe& probe = probes[i];
+    memset(&probe, 0, sizeof(probe));
+    probe.target = &targets[i];
+    probe.fd = -1;
+    probe.outcome = ProbeOutcome::PENDING;
+    startProbe(probe, resolver);
+  }
+
+  // Drive every probe from one select() loop until all are done or time is up.
+  for (;;) {
+    fd_set readable, writable;
+    FD_ZERO(&readable);
+    FD_ZERO(&writable);
+    int maxFd = -1;
+    for (size_t i = 0; i < count; i++) {
+      Probe& probe = probes[i];
+      if (probe.step == ProbeStep::DONE) continue;
+      if (probe.step == ProbeStep::RESOLVING || probe.step == ProbeStep::RECEIVING) {
+        FD_SET(probe.fd, &readable);
+      } else {
+        FD_SET(probe.fd, &writable);
+      }
+      if (probe.fd > maxFd) maxFd = probe.fd;
+    }
+    long remaining = (long)timeoutMs - (long)(millis() - started);
+    if (maxFd < 0 || remaining <= 0) break;
+    struct timeval tv;
+    tv.tv_sec = remaining / 1000;
+    tv.tv_usec = (remaining % 1000) * 1000;
+    if (select(maxFd + 1, &readable, &writable, nullptr, &tv) <= 0) break;
+    for (size_t i = 0; i < count; i++) {
+      Probe& probe = probes[i];
+      if (probe.step == ProbeStep::DONE) continue;
+      advanceProbe(probe, FD_ISSET(probe.fd, &readable), FD_ISSET(probe.fd, &writable));
+    }
+  }
+
+  bool anySuccess = false;
+  bool anyCaptive = false;
+  roundLatencyMs = 0;
+  for (size_t i = 0; i < count; i++) {
+    Probe& probe = probes[i];
+    if (probe.step != ProbeStep::DONE) finishProbe(probe, ProbeOutcome::FAILURE);  // Timed out
+    uint32_t latency = probe.finishedAt - started;
+    ALOO_LOGV(TAG, "Probe %s %u: outcome %u in %lu ms", probe.target->host, (unsigned)probe.target->type,
+              (unsigned)probe.outcome, (unsigned long)latency);
+    if (probe.outcome == ProbeOutcome::CAPTIVE) anyCaptive = true;
+    if (probe.outcome == ProbeOutcome::SUCCESS) {
+      if (!anySuccess || latency < roundLatencyMs) roundLatencyMs = latency;
+      anySuccess = true;
+    }
+  }
+  // A portal that lets TCP through still intercepts HTTP, so it wins.
+  WiFiReachability round = anyCaptive ? WiFiReachability::CAPTIVE
+                         : anySuccess ? WiFiReachability::REACHABLE
+                         : WiFiReachability::UNREACHABLE;
+
+  portENTER_CRITICAL(&_lock);
+  record(round, roundLatencyMs);
+  WiFiReachability state = _state;
+  portEXIT_CRITICAL(&_lock);
+  return state;
+}
+
+uint32_t AlooReachability::nextIntervalMs() {
+  portENTER_CRITICAL(&_lock);
+  uint32_t interval = _intervalMs;
+  portEXIT_CRITICAL(&_lock);
+  uint32_t jitter = interval / 10;
+  return interval - jitter + (jitter ? esp_random() % (2 * jitter + 1) : 0);
+}
+
+WiFiReachabilityStats AlooReachability::stats() {
+  WiFiReachabilityStats out;
+  portENTER_CRITICAL(&_lock);
+  out.state = _state;
+  out.windowRounds = _windowCount;
+  out.windowSuccesses = 0;
+  uint32_t latencySum = 0;
+  for (uint8_t i = 0; i < _windowCount; i++) {
+    if (_window[i].reachable) {
+      out.windowSuccesses++;
+      latencySum += _window[i].latencyMs;
+    }
+  }
+  out.intervalMs = _intervalMs;
+  out.rounds = _rounds;
+  portEXIT_CRITICAL(&_lock);
+  out.meanLatencyMs = out.windowSuccesses ? latencySum / out.windowSuccesses : 0;
+  return out;
+}
+
+uint32_t AlooReachability::minInterval() const {
+  return (_config.minIntervalMs ? _config.minIntervalMs : _defaultIntervalMs) * _intervalScale;
+}
+
+uint32_t AlooReachability::maxInterval() const {
+  return max(_config.maxIntervalMs * _intervalScale, minInterval());
+}
+
+/**
+ * @brief Adds a round to the window and applies hysteresis and interval
+ *        adaptation. Caller holds _lock.
+ */
+void AlooReachability::record(WiFiReachability round, uint32_t latencyMs) {
+  bool good = round == WiFiReachability::REACHABLE;
+  _window[_windowHead].reachable = good;
+  _window[_windowHead].latencyMs = latencyMs;
+  _windowHead = (_windowHead + 1) % ALOO_REACH_WINDOW;
+  if (_windowCount < ALOO_REACH_WINDOW) _windowCount++;
+  _rounds++;
+
+  if (good) {
+    if (_consecutiveGood < 255) _consecutiveGood++;
+    _consecutiveBad = 0;
+  } else {
+    if (_consecutiveBad < 255) _consecutiveBad++;
+    _consecutiveGood = 0;
+  }
+
+  WiFiReachability previous = _state;
+  if (_state == WiFiReachability::UNKNOWN) {
+    _state = round;  // The first round after link-up decides on its own.
+  } else if (good && _state != WiFiReachability::REACHABLE && _consecutiveGood >= _config.recoverThreshold) {
+    _state = WiFiReachability::REACHABLE;
+  } else if (!good && _consecutiveBad >= _config.failThreshold) {
+    _state = round;
+  }
+
+  // Probe quickly while anything is in doubt; back off while stable.
+  uint32_t minimum = minInterval();
+  uint32_t maximum = maxInterval();
+  if (!good || _state != previous) {
+    _intervalMs = minimum;
+  } else if (_consecutiveGood % _config.stableRoundsToBackoff == 0) {
+    _intervalMs = min(_intervalMs * 2, maximum);
+  }
+}
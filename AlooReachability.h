@@ -0,0 +1,168 @@
+#ifndef ALOO_REACHABILITY_H
+#define ALOO_REACHABILITY_H
+
+#include <Arduino.h>
+#include "freertos/FreeRTOS.h"
+
+// Probe targets checked in each round, and rounds kept in the rolling window.
+#ifndef ALOO_REACH_MAX_TARGETS
+#define ALOO_REACH_MAX_TARGETS 4
+#endif
+#ifndef ALOO_REACH_WINDOW
+#define ALOO_REACH_WINDOW 8
+#endif
+
+//========================================================================
+// Probe Targets and Results
+//========================================================================
+enum class WiFiProbeType : uint8_t {
+  TCP,       // Connect to host:port
+  DNS,       // Resolve host through the station's DNS server
+  HTTP_204   // GET http://host:port/path and expect 204; any other answer means a captive portal
+};
+
+enum class WiFiReachability : uint8_t {
+  UNKNOWN,      // No round completed since the link came up
+  REACHABLE,
+  CAPTIVE,      // An HTTP probe was answered by something other than its target
+  UNREACHABLE
+};
+
+// Strings must outlive the prober (string literals in practice). host may
+// be an IPv4 literal or a name; names are resolved with a DNS query sent in
+// the same round.
+struct WiFiProbeTarget {
+  WiFiProbeType type;
+  const char* host;
+  uint16_t port;       // TCP/HTTP port (ignored for DNS)
+  const char* path;    // HTTP_204 only
+};
+
+struct WiFiReachabilityConfig {
+  uint32_t minIntervalMs = 0;          // Interval while unstable (0 = begin()'s monitorTaskDelay)
+  uint32_t maxIntervalMs = 120000;     // Interval cap once the connection has been stable
+  uint8_t stableRoundsToBackoff = 3;   // Successful rounds before the interval doubles
+  uint32_t probeTimeoutMs = 3000;      // Deadline for a whole round; probes run concurrently
+  uint8_t failThreshold = 2;           // Consecutive failed rounds before leaving REACHABLE
+  uint8_t recoverThreshold = 2;        // Consecutive good rounds before returning to REACHABLE
+};
+
+struct WiFiReachabilityStats {
+  WiFiReachability state;
+  uint8_t windowRounds;       // Rounds in the rolling window
+  uint8_t windowSuccesses;    // Reachable rounds in the rolling window
+  uint32_t meanLatencyMs;     // Mean latency of the reachable rounds in the window
+  uint32_t intervalMs;        // Current probe interval (before jitter)
+  uint32_t rounds;            // Rounds since the link came up
+};
+
+//========================================================================
+// DNS Wire Format
+//========================================================================
+// Used by the DNS probes; exposed for the host tests in test/host.
+
+/**
+ * @brief Encodes a recursive A query for host.
+ * @return Query length, or 0 if host is empty, has an empty or over-long
+ *         label, or does not fit in capacity.
+ */
+size_t buildDnsQuery(uint8_t* buf, size_t capacity, uint16_t id, const char* host);
+
+/**
+ * @brief Extracts the first A record from a response to query id.
+ * @param address Set to the address, in network byte order, on success.
+ * @return 1 if an address was found; 0 if buf is not a response to this
+ *         query; -1 if the query failed, had no A record or was malformed.
+ */
+int parseDnsResponse(const uint8_t* buf, size_t length, uint16_t id, uint32_t& address);
+
+//========================================================================
+// AlooReachability
+//========================================================================
+/**
+ * @brief Internet reachability prober.
+ *
+ * A round starts every configured probe at once on non-blocking sockets and
+ * waits on select() until all have finished or the round deadline passes, so
+ * a round costs the slowest probe rather than the sum of the timeouts. The
+ * round passes if any probe succeeded, unless an HTTP probe saw a captive
+ * portal. State changes need failThreshold / recoverThreshold consecutive
+ * rounds, so one lost probe does not flap the link status. The interval
+ * starts at minIntervalMs and doubles after every stableRoundsToBackoff good
+ * rounds up to maxIntervalMs; any failure drops it back to the minimum.
+ *
+ * runRound() is meant for a single task; the setters may be called from any
+ * task.
+ */
+class AlooReachability {
+public:
+  AlooReachability();
+
+  /**
+   * @brief Sets the interval used when the config leaves minIntervalMs at 0.
+   */
+  void begin(uint32_t defaultIntervalMs);
+
+  void setConfig(const WiFiReachabilityConfig& config);
+
+  /**
+   * @brief Stretches the minimum and maximum interval by a factor, e.g. for a
+   *        low-power profile, without touching the configured values.
+   */
+  void setIntervalScale(uint8_t scale);
+  WiFiReachabilityConfig getConfig();
+
+  /**
+   * @brief Replaces the probe targets (at most ALOO_REACH_MAX_TARGETS).
+   *        Defaults: TCP 1.1.1.1:80, DNS and HTTP 204 on connectivitycheck.gstatic.com.
+   */
+  void setTargets(const WiFiProbeTarget* targets, size_t count);
+
+  /**
+   * @brief Forgets the window and state; call when the link (re)connects.
+   */
+  void reset();
+
+  /**
+   * @brief Runs one probe round and returns the filtered state.
+   * @param dnsServer Resolver used by DNS probes and for host names.
+   * @param roundLatencyMs Set to the fastest successful probe, or 0 if none.
+   */
+  WiFiReachability runRound(const IPAddress& dnsServer, uint32_t& roundLatencyMs);
+
+  /**
+   * @brief Delay until the next round: the current interval with +-10% jitter,
+   *        so devices sharing an uplink do not probe in lockstep.
+   */
+  uint32_t nextIntervalMs();
+
+  WiFiReachabilityStats stats();
+
+private:
+  struct Sample {
+    bool reachable;
+    uint32_t latencyMs;
+  };
+
+  WiFiReachabilityConfig _config;
+  WiFiProbeTarget _targets[ALOO_REACH_MAX_TARGETS];
+  size_t _targetCount;
+  uint32_t _defaultIntervalMs;
+  uint8_t _intervalScale;
+  portMUX_TYPE _lock;  // Guards everything above and below against the setters
+
+  WiFiReachability _state;
+  Sample _window[ALOO_REACH_WINDOW];
+  uint8_t _windowHead;
+  uint8_t _windowCount;
+  uint8_t _consecutiveGood;
+  uint8_t _consecutiveBad;
+  uint32_t _intervalMs;
+  uint32_t _rounds;
+
+  uint32_t minInterval() const;
+  uint32_t maxInterval() const;
+  void record(WiFiReachability round, uint32_t latencyMs);
+};
+
+#endif // ALOO_REACHABILITY_H
@@ -1,90 +1,23 @@
 #include "AlooWifiManager.h"
-#include <DNSServer.h>
+#include "AlooJsonWriter.h"
+#include "AlooPortalAssets.h"
+#include "AlooCaptiveProbes.h"
+#include "AlooLog.h"
 #include <HTTPClient.h>
+#include <algorithm>
+#include <new>
 #ifdef ESP32
 #include <esp_wifi.h>
 #include <esp_wifi_types.h>
 #include <esp_netif.h>
+#include <esp_netif_net_stack.h>
+#include <esp_attr.h>
+#include <lwip/dhcp.h>
+#include <lwip/tcpip.h>
 #endif
 //--------------------------------------------------------------------------
-// Default Embedded Web Files (Fallbacks)
-//--------------------------------------------------------------------------
-static const char defaultIndexHtml[] =
-"<!DOCTYPE html>\n"
-"<html>\n"
-"<head>\n"
-"  <meta charset='UTF-8'>\n"
-"  <title>ESP32 WiFi Setup</title>\n"
-"  <link rel='stylesheet' href='/style.css'>\n"
-"</head>\n"
-"<body>\n"
-"  <h1>ESP32 WiFi Setup</h1>\n"
-"  <button onclick=\"window.location.href='/connect'\">Setup WiFi</button>\n"
-"  <script src='/script.js'></script>\n"
-"</body>\n"
-"</html>";
-
-static const char defaultConnectHtml[] =
-"<!DOCTYPE html>\n"
-"<html>\n"
-"<head>\n"
-"  <meta charset='UTF-8'>\n"
-"  <title>Select WiFi Network</title>\n"
-"  <link rel='stylesheet' href='/style.css'>\n"
-"</head>\n"
-"<body>\n"
-"  <h1>Select WiFi Network</h1>\n"
-"  <div id='networks'></div>\n"
-"  <form id='wifiForm' action='/submit' method='POST'>\n"
-"    SSID: <input type='text' id='ssid' name='ssid'><br>\n"
-"    Password: <input type='password' id='password' name='password'><br>\n"
-"    <input type='checkbox' onclick='togglePassword()'> Show Password<br>\n"
-"    <input type='submit' value='Connect'>\n"
-"  </form>\n"
-"  <script src='/script.js'></script>\n"
-"</body>\n"
-"</html>";
-
-static const char defaultStyleCss[] =
-"body { font-family: Arial, sans-serif; background-color: #f2f2f2; text-align: center; }\n"
-"h1 { color: #333; }\n"
-"button { padding: 10px 20px; font-size: 16px; }\n"
-"ul { list-style-type: none; padding: 0; }\n"
-"li { padding: 8px; margin: 5px; background-color: #fff; border: 1px solid #ddd; cursor: pointer; }";
-
-static const char defaultScriptJs[] =
-"function togglePassword() {\n"
-"  var x = document.getElementById('password');\n"
-"  if (x.type === 'password') { x.type = 'text'; } else { x.type = 'password'; }\n"
-"}\n"
-"\n"
-"function fetchNetworks() {\n"
-"  fetch('/wifinetworks')\n"
-"    .then(response => response.json())\n"
-"    .then(data => {\n"
-"      var networksDiv = document.getElementById('networks');\n"
-"      if(data.networks && data.networks.length > 0) {\n"
-"        var ul = document.createElement('ul');\n"
-"        data.networks.forEach(function(net) {\n"
-"          var li = document.createElement('li');\n"
-"          li.textContent = net.ssid + ' (' + net.rssi + ' dBm)';\n"
-"          li.onclick = function() {\n"
-"            document.getElementById('ssid').value = net.ssid;\n"
-"            document.getElementById('password').focus();\n"
-"          };\n"
-"          ul.appendChild(li);\n"
-"        });\n"
-"        networksDiv.innerHTML = '';\n"
-"        networksDiv.appendChild(ul);\n"
-"      } else {\n"
-"        networksDiv.innerHTML = '<p>No networks found. Please refresh.</p>';\n"
-"      }\n"
-"    })\n"
-"    .catch(err => { console.error('Error fetching networks: ', err); });\n"
-"}\n"
-"\n"
-"if(document.getElementById('networks')) { window.onload = fetchNetworks; }";
-
+// Connecting Page (formatted per request, so not part of the asset bundle)
+//--------------------------------------------------------------------------
 static const char connectingHtml[] PROGMEM = R"raw(
 <!DOCTYPE html>
 <html>
@@ -122,15 +55,175 @@ static const char connectingHtml[] PROGMEM = R"raw(
 // Persistent Storage Keys
 //--------------------------------------------------------------------------
 const char WiFiManager::PREF_NAMESPACE[] = "wifimanager";
+const char WiFiManager::PREF_STATE_KEY[] = "state";
 const char WiFiManager::PREF_SSID_KEY[] = "last_ssid";
 const char WiFiManager::PREF_PASS_KEY[] = "last_pass";
+const char WiFiManager::PREF_BSSID_KEY[] = "last_bssid";
+const char WiFiManager::PREF_CHANNEL_KEY[] = "last_chan";
+const char WiFiManager::PREF_LEASE_KEY[] = "last_lease";
+const char WiFiManager::PREF_TABLE_KEY[] = "cred_table";
 const char WiFiManager::STATUS_ENDPOINT[] = "/status";
+const char WiFiManager::METRICS_ENDPOINT[] = "/metrics";
+// Not under /wifinetworks: async handlers also match "<uri>/..." and that
+// route is registered first.
+const char WiFiManager::NETWORK_EVENTS_ENDPOINT[] = "/networkevents";
+
+// Histogram bucket bounds. Connect times cover fast reconnect through a full
+// timeout; HTTP and mutex buckets are in microseconds.
+static const uint32_t CONNECT_DURATION_BOUNDS_MS[] = { 250, 500, 1000, 2000, 3000, 5000, 8000, 12000, 20000, 30000 };
+static const uint32_t SCAN_DURATION_BOUNDS_MS[] = { 250, 500, 1000, 2000, 3000, 5000, 8000, 12000 };
+static const uint32_t PROBE_LATENCY_BOUNDS_MS[] = { 10, 25, 50, 100, 250, 500, 1000, 2000, 3000 };
+static const uint32_t HTTP_DURATION_BOUNDS_US[] = { 500, 1000, 2500, 5000, 10000, 25000, 50000, 100000, 250000, 1000000 };
+static const uint32_t MUTEX_WAIT_BOUNDS_US[] = { 0, 10, 100, 1000, 10000, 100000, 1000000 };
+
+// Upper bound on how long stopAPMode() waits for the server task to park.
+static const uint32_t SERVER_PARK_TIMEOUT_MS = 2000;
+// Longest the DNS task blocks on its socket between checkpoints, which bounds
+// how long parking it takes.
+static const uint32_t DNS_WAIT_MS = 250;
+// Upper bound on how long a new attempt waits for the DISCONNECTED of the
+// link it has just dropped.
+static const uint32_t STALE_DISCONNECT_WAIT_MS = 300;
+// How often the connection manager polls the DHCP client started next to a
+// cached lease: until it binds, and then for a revoked or moved address.
+static const uint32_t LEASE_BIND_POLL_MS = 500;
+static const uint32_t LEASE_WATCH_POLL_MS = 30000;
+
+static const char* const TASK_NAMES[] = {
+  "WiFiConnMgrTask", "WiFiServerTask", "WiFiMonitorTask", "WiFiScanTask", "WiFiEventTask", "WiFiPersistTask",
+  "WiFiDnsTask", "WiFiNotifyTask"
+};
+
+static const char* const HTTP_ROUTE_LABELS[] = {
+  "route=\"portal\"", "route=\"/wifinetworks\"", "route=\"/status\"", "route=\"/submit\"",
+  "route=\"captive\"", "route=\"/metrics\"", "route=\"not_found\""
+};
+static const char* const MUTEX_LABELS[] = {
+  "mutex=\"status\"", "mutex=\"pending\"", "mutex=\"connection\"", "mutex=\"connecting\"",
+  "mutex=\"wifi\"", "mutex=\"networks\"", "mutex=\"credentials\"", "mutex=\"subscribers\"",
+  "mutex=\"storage\""
+};
+static const char* const TASK_LABELS[] = {
+  "task=\"connection_manager\"", "task=\"server\"", "task=\"monitor\"", "task=\"scan\"",
+  "task=\"dispatcher\"", "task=\"persist\"", "task=\"dns\"", "task=\"notifier\""
+};
+static const char* const PROBE_OS_LABELS[] = {
+  "os=\"apple\"", "os=\"android\"", "os=\"chromeos\"", "os=\"windows\"", "os=\"firefox\"", "os=\"other\""
+};
+static const char* const DNS_QUERY_LABELS[] = {
+  "type=\"a\"", "type=\"aaaa\"", "type=\"https\"", "type=\"other\""
+};
+static const char* const RADIO_STATE_LABELS[] = {
+  "state=\"idle\"", "state=\"connecting\"", "state=\"active\"", "state=\"modem_sleep\"", "state=\"ap\"",
+  "state=\"scan\""
+};
+static const char* const DISCONNECT_CLASS_LABELS[] = {
+  "class=\"transient\"", "class=\"auth\"", "class=\"not_found\"", "class=\"ap_full\"", "class=\"local\"",
+  "class=\"other\""
+};
+static const char* const RECOVERY_LABELS[] = {
+  "recovery=\"none\"", "recovery=\"reassociate\"", "recovery=\"backoff\"", "recovery=\"mark_bad\"",
+  "recovery=\"portal\""
+};
+static_assert(sizeof(HTTP_ROUTE_LABELS) / sizeof(HTTP_ROUTE_LABELS[0]) == (size_t)WiFiHttpRoute::COUNT, "route labels");
+static_assert(sizeof(MUTEX_LABELS) / sizeof(MUTEX_LABELS[0]) == (size_t)WiFiMutexId::COUNT, "mutex labels");
+static_assert(sizeof(TASK_LABELS) / sizeof(TASK_LABELS[0]) == (size_t)WiFiTaskId::COUNT, "task labels");
+static_assert(sizeof(TASK_NAMES) / sizeof(TASK_NAMES[0]) == (size_t)WiFiTaskId::COUNT, "task names");
+static_assert(sizeof(RADIO_STATE_LABELS) / sizeof(RADIO_STATE_LABELS[0]) == (size_t)WiFiRadioState::COUNT, "radio labels");
+static_assert(sizeof(DISCONNECT_CLASS_LABELS) / sizeof(DISCONNECT_CLASS_LABELS[0]) == (size_t)WiFiDisconnectClass::COUNT,
+              "disconnect class labels");
+static_assert(sizeof(PROBE_OS_LABELS) / sizeof(PROBE_OS_LABELS[0]) == (size_t)WiFiProbeOs::COUNT, "probe os labels");
+static_assert(sizeof(DNS_QUERY_LABELS) / sizeof(DNS_QUERY_LABELS[0]) == (size_t)WiFiDnsQueryType::COUNT, "dns labels");
+static_assert(sizeof(RECOVERY_LABELS) / sizeof(RECOVERY_LABELS[0]) == (size_t)WiFiRecovery::COUNT, "recovery labels");
+static_assert((size_t)WiFiTaskId::COUNT <= 8, "task supervisor bits");
+
+// The event task runs above the workers so transitions are not delayed by a
+// scan or probe; the DNS task too, since portal detection times out quickly.
+// Subscriber callbacks run on the notifier task, at worker priority.
+static const WiFiTaskConfig DEFAULT_TASK_CONFIG[] = {
+  { 1, WiFiTaskConfig::BEGIN_CORE, ALOO_WM_MANAGER_STACK_SIZE },
+  { 1, WiFiTaskConfig::BEGIN_CORE, ALOO_WM_SERVER_STACK_SIZE },
+  { 1, WiFiTaskConfig::BEGIN_CORE, ALOO_WM_MONITOR_STACK_SIZE },
+  { 1, WiFiTaskConfig::BEGIN_CORE, ALOO_WM_SCAN_STACK_SIZE },
+  { 2, WiFiTaskConfig::BEGIN_CORE, ALOO_WM_DISPATCHER_STACK_SIZE },
+  { 1, WiFiTaskConfig::BEGIN_CORE, ALOO_WM_PERSIST_STACK_SIZE },
+  { 2, WiFiTaskConfig::BEGIN_CORE, ALOO_WM_DNS_STACK_SIZE },
+  { 1, WiFiTaskConfig::BEGIN_CORE, ALOO_WM_NOTIFIER_STACK_SIZE }
+};
+static_assert(sizeof(DEFAULT_TASK_CONFIG) / sizeof(DEFAULT_TASK_CONFIG[0]) == (size_t)WiFiTaskId::COUNT,
+              "task config");
+
+//--------------------------------------------------------------------------
+// Status Transition Table
+//--------------------------------------------------------------------------
+// Indexed by the current state; bit n allows a move to WiFiStatus(n).
+// INITIALIZING is never re-entered and NO_INTERNET can only follow a
+// successful connection, so a stale internet probe cannot resurrect it.
+#define WM_BIT(s) (1 << static_cast<uint8_t>(WiFiStatus::s))
+#define WM_LINK_STATES (WM_BIT(TRYING_TO_CONNECT) | WM_BIT(AP_MODE_ACTIVE) | \
+                        WM_BIT(CONNECTED) | WM_BIT(DISCONNECTED))
+static const uint8_t STATUS_TRANSITIONS[] = {
+  /* INITIALIZING      */ WM_LINK_STATES,
+  /* TRYING_TO_CONNECT */ WM_LINK_STATES,
+  /* AP_MODE_ACTIVE    */ WM_LINK_STATES,
+  /* CONNECTED         */ WM_LINK_STATES | WM_BIT(NO_INTERNET),
+  /* DISCONNECTED      */ WM_LINK_STATES,
+  /* NO_INTERNET       */ WM_LINK_STATES,
+};
+#undef WM_LINK_STATES
+#undef WM_BIT
+
+//--------------------------------------------------------------------------
+// Disconnect Classification
+//--------------------------------------------------------------------------
+// wifi_err_reason_t codes with a class other than OTHER. Handshake timeouts
+// count as AUTH: with a wrong PSK the AP never answers message 3.
+struct DisconnectReasonClass {
+  uint8_t reason;
+  WiFiDisconnectClass cls;
+};
+static const DisconnectReasonClass DISCONNECT_CLASSES[] = {
+  { WIFI_REASON_UNSPECIFIED,              WiFiDisconnectClass::TRANSIENT },
+  { WIFI_REASON_AUTH_EXPIRE,              WiFiDisconnectClass::TRANSIENT },
+  { WIFI_REASON_AUTH_LEAVE,               WiFiDisconnectClass::TRANSIENT },
+  { WIFI_REASON_ASSOC_EXPIRE,             WiFiDisconnectClass::TRANSIENT },
+  { WIFI_REASON_NOT_AUTHED,               WiFiDisconnectClass::TRANSIENT },
+  { WIFI_REASON_NOT_ASSOCED,              WiFiDisconnectClass::TRANSIENT },
+  { WIFI_REASON_BEACON_TIMEOUT,           WiFiDisconnectClass::TRANSIENT },
+  { WIFI_REASON_AP_TSF_RESET,             WiFiDisconnectClass::TRANSIENT },
+  { WIFI_REASON_ROAMING,                  WiFiDisconnectClass::TRANSIENT },
+  { WIFI_REASON_CONNECTION_FAIL,          WiFiDisconnectClass::TRANSIENT },
+  { WIFI_REASON_MIC_FAILURE,              WiFiDisconnectClass::AUTH },
+  { WIFI_REASON_4WAY_HANDSHAKE_TIMEOUT,   WiFiDisconnectClass::AUTH },
+  { WIFI_REASON_GROUP_KEY_UPDATE_TIMEOUT, WiFiDisconnectClass::AUTH },
+  { WIFI_REASON_802_1X_AUTH_FAILED,       WiFiDisconnectClass::AUTH },
+  { WIFI_REASON_AUTH_FAIL,                WiFiDisconnectClass::AUTH },
+  { WIFI_REASON_HANDSHAKE_TIMEOUT,        WiFiDisconnectClass::AUTH },
+  { WIFI_REASON_NO_AP_FOUND,              WiFiDisconnectClass::NOT_FOUND },
+  { WIFI_REASON_ASSOC_TOOMANY,            WiFiDisconnectClass::AP_FULL },
+  { WIFI_REASON_ASSOC_FAIL,               WiFiDisconnectClass::AP_FULL },
+  { WIFI_REASON_ASSOC_LEAVE,              WiFiDisconnectClass::LOCAL },
+};
+
+// Indexed by WiFiDisconnectClass.
+static const WiFiRecovery DEFAULT_RECOVERY[] = {
+  WiFiRecovery::REASSOCIATE,  // TRANSIENT
+  WiFiRecovery::MARK_BAD,     // AUTH
+  WiFiRecovery::BACKOFF,      // NOT_FOUND
+  WiFiRecovery::BACKOFF,      // AP_FULL
+  WiFiRecovery::REASSOCIATE,  // LOCAL: reason 8 also comes from an AP reboot
+  WiFiRecovery::PORTAL,       // OTHER
+};
+static_assert(sizeof(DEFAULT_RECOVERY) / sizeof(DEFAULT_RECOVERY[0]) == (size_t)WiFiDisconnectClass::COUNT,
+              "default recovery");
 
 //--------------------------------------------------------------------------
 // Static Instance Pointer
 //--------------------------------------------------------------------------
 WiFiManager* WiFiManager::_instance = nullptr;
 
+static const char TAG[] = "WiFiManager";
+
 //--------------------------------------------------------------------------
 // Constructor & Destructor
 //--------------------------------------------------------------------------
@@ -139,30 +232,145 @@ WiFiManager::WiFiManager(const String& apSsid, const String& apPassword, bool au
   : _apSsid(apSsid),
     _apPassword(apPassword),
     _status(WiFiStatus::INITIALIZING),
+    _events{},
+    _notifications{},
+    _eventLock(portMUX_INITIALIZER_UNLOCKED),
     _pendingSsid(""),
     _pendingPassword(""),
     _newCredentialsAvailable(false),
     _server(nullptr),
     _runServerOnSeparateCore(false),
+    _serverBackend(WiFiServerBackend::SYNC),
+    _portalActive(false),
+    _dualMode(false),
+    _portalGraceMs(60000),
+    _portalCloseScheduled(false),
+    _portalCloseAt(0),
+    _serverRoutesRegistered(false),
+    _captiveLocation{},
+    _captiveResponse{},
+    _captiveResponseLength(0),
+#ifdef ALOO_WM_ASYNC_SERVER
+    _asyncServer(nullptr),
+    _asyncRoutesRegistered(false),
+    _networkEvents(nullptr),
+    _pushedGeneration(0),
+#endif
     _connectionManagerTaskHandle(nullptr),
     _serverTaskHandle(nullptr),
     _monitorTaskHandle(nullptr),
     _scanTaskHandle(nullptr),
+    _dispatcherTaskHandle(nullptr),
+    _persistTaskHandle(nullptr),
+    _dnsTaskHandle(nullptr),
+    _notifierTaskHandle(nullptr),
     _serverCore(1),
     _managerCore(1),
+    _taskConfig{},
+    _taskApplied{},
+    _sharedWorker(false),
+    _taskStatsLock(portMUX_INITIALIZER_UNLOCKED),
+    _taskRunTime{},
+    _runTimeTotal(0),
+    _taskStatsAt(0),
+    _fastReconnect(true),
+    _fastConnectTimeout(3000),
+    _leaseLifetime(3600),
+    _fastConnectChannel(0),
+    _lease{},
+    _usingStaticLease(false),
+    _fastCacheStale(false),
+    _leaseDhcp(LeaseDhcp::OFF),
     _connectTimeout(15000), // Default 15 seconds
+    _scanBuffers(createScanBuffers()),
+    _scanGeneration(0),
+    _scanHorizon(0),
+    _scanResults(_scanBuffers->pool[0]),
+    _scanResultCount(0),
+    _scanStaging(_scanBuffers->pool[1]),
+    _scanCacheTtl(15000),
+    _lastScanAt(0),
+    _internetCheckTimer(nullptr),
     _isConnecting(false),
     _autoLaunchAP(autoLaunchAP),
-    _reconnectionAttempts(reconnectionAttempts)
+    _reconnectionAttempts(reconnectionAttempts),
+    _portalIdleMs(0),
+    _portalClients(0),
+    _portalIdleSince(0),
+    _radioLock(portMUX_INITIALIZER_UNLOCKED),
+    _radioState(WiFiRadioState::IDLE),
+    _radioStateSince(0),
+    _radioStateMs{},
+    _radioScanning(false),
+    _modemSleep(false),
+    _connectStartedAt(0),
+    _lastDisconnectReason(0),
+    _lastAttemptReason(0),
+    _recoveryDelayMs(0),
+    _recoveryRetries(0),
+    _expectingDisconnect(false),
+    _attemptId(0),
+    _linkPending(false),
+    _credentialsLoaded(false),
+    _lastSsid{},
+    _lastPassword{},
+    _storedRecord{},
+    _storageDirty(false),
+    _flushDueAt(0),
+    _userAssets(nullptr),
+    _userAssetCount(0),
+    _portalFs(nullptr)
 {
+  // The constructor's attempt count is the per-network budget for stored credentials.
+  _retryPolicy.storedAttempts = reconnectionAttempts > 0 ? reconnectionAttempts : 1;
+  memcpy(_recovery, DEFAULT_RECOVERY, sizeof(_recovery));
+  memcpy(_taskConfig, DEFAULT_TASK_CONFIG, sizeof(_taskConfig));
+  _powerSettings = powerProfile(WiFiPowerProfile::BALANCED);
+  _portalIdleMs = _powerSettings.portalIdleMs;
+  _modemSleep = _powerSettings.sleep != WIFI_PS_NONE;
+  _radioStateSince = millis();
+  // Start the scan generations at a random point, so a page left open across
+  // a reboot does not apply a delta against the wrong list.
+  _scanGeneration = _scanHorizon = esp_random() & 0xFFFFFF;
+
+  _metrics.connectDurationMs.setBounds(CONNECT_DURATION_BOUNDS_MS, sizeof(CONNECT_DURATION_BOUNDS_MS) / sizeof(uint32_t));
+  _metrics.scanDurationMs.setBounds(SCAN_DURATION_BOUNDS_MS, sizeof(SCAN_DURATION_BOUNDS_MS) / sizeof(uint32_t));
+  _metrics.probeLatencyMs.setBounds(PROBE_LATENCY_BOUNDS_MS, sizeof(PROBE_LATENCY_BOUNDS_MS) / sizeof(uint32_t));
+  for (AlooHistogram& histogram : _metrics.httpDurationUs) {
+    histogram.setBounds(HTTP_DURATION_BOUNDS_US, sizeof(HTTP_DURATION_BOUNDS_US) / sizeof(uint32_t));
+  }
+  for (AlooHistogram& histogram : _metrics.mutexWaitUs) {
+    histogram.setBounds(MUTEX_WAIT_BOUNDS_US, sizeof(MUTEX_WAIT_BOUNDS_US) / sizeof(uint32_t));
+  }
+
   // Create mutexes for thread safety.
-  _statusMutex     = xSemaphoreCreateMutex();
-  _pendingMutex    = xSemaphoreCreateMutex();
-  _connectionMutex = xSemaphoreCreateMutex();
-  _networksMutex   = xSemaphoreCreateMutex();
-  _connectingMutex = xSemaphoreCreateMutex();
+  _statusMutex      = createMutex(WiFiMutexId::STATUS);
+  _pendingMutex     = createMutex(WiFiMutexId::PENDING);
+  _connectionMutex  = createMutex(WiFiMutexId::CONNECTION);
+  _networksMutex    = createMutex(WiFiMutexId::NETWORKS);
+  _connectingMutex  = createMutex(WiFiMutexId::CONNECTING);
+  _credentialsMutex = createMutex(WiFiMutexId::CREDENTIALS);
   // Create new mutex for WiFi operations
-  _wifiMutex = xSemaphoreCreateMutex();
+  _wifiMutex        = createMutex(WiFiMutexId::WIFI);
+  _subscribersMutex = createMutex(WiFiMutexId::SUBSCRIBERS);
+  _storageMutex     = createMutex(WiFiMutexId::STORAGE);
+  for (Subscriber& subscriber : _subscribers) subscriber.mask = 0;
+
+  // State event group starts out mirroring INITIALIZING.
+#ifdef ALOO_WM_STATIC_ALLOCATION
+  _stateEvents = xEventGroupCreateStatic(&_stateEventsStorage);
+  _taskEvents = xEventGroupCreateStatic(&_taskEventsStorage);
+  _events.queue = xQueueCreateStatic(ALOO_WM_EVENT_QUEUE_LENGTH, sizeof(WiFiManagerEvent),
+                                     _eventQueueBuffer, &_eventQueueStorage);
+  _notifications.queue = xQueueCreateStatic(ALOO_WM_NOTIFY_QUEUE_LENGTH, sizeof(WiFiManagerEvent),
+                                            _notifyQueueBuffer, &_notifyQueueStorage);
+#else
+  _stateEvents = xEventGroupCreate();
+  _taskEvents = xEventGroupCreate();
+  _events.queue = xQueueCreate(ALOO_WM_EVENT_QUEUE_LENGTH, sizeof(WiFiManagerEvent));
+  _notifications.queue = xQueueCreate(ALOO_WM_NOTIFY_QUEUE_LENGTH, sizeof(WiFiManagerEvent));
+#endif
+  xEventGroupSetBits(_stateEvents, stateBit(WiFiStatus::INITIALIZING) | EVT_SCAN_IDLE);
 
   // Set the singleton instance and register the WiFi event handler.
   _instance = this;
@@ -170,19 +378,27 @@ WiFiManager::WiFiManager(const String& apSsid, const String& apPassword, bool au
 }
 
 WiFiManager::~WiFiManager() {
-  if (_connectionManagerTaskHandle) vTaskDelete(_connectionManagerTaskHandle);
-  if (_serverTaskHandle) vTaskDelete(_serverTaskHandle);
-  if (_monitorTaskHandle) vTaskDelete(_monitorTaskHandle);
-  if (_scanTaskHandle) vTaskDelete(_scanTaskHandle);
+  // Stop the tasks before the kernel objects they wait on are deleted.
+  end();
   if (_internetCheckTimer) xTimerDelete(_internetCheckTimer, 0);
   if (_statusMutex)    vSemaphoreDelete(_statusMutex);
   if (_pendingMutex)   vSemaphoreDelete(_pendingMutex);
   if (_connectionMutex) vSemaphoreDelete(_connectionMutex);
   if (_connectingMutex) vSemaphoreDelete(_connectingMutex);
   if (_networksMutex)  vSemaphoreDelete(_networksMutex);
+  if (_credentialsMutex) vSemaphoreDelete(_credentialsMutex);
   // Delete WiFi mutex
   if (_wifiMutex) vSemaphoreDelete(_wifiMutex);
-  stopAPMode();
+  if (_subscribersMutex) vSemaphoreDelete(_subscribersMutex);
+  if (_storageMutex) vSemaphoreDelete(_storageMutex);
+  if (_events.queue) vQueueDelete(_events.queue);
+  if (_notifications.queue) vQueueDelete(_notifications.queue);
+  if (_stateEvents) vEventGroupDelete(_stateEvents);
+  if (_taskEvents) vEventGroupDelete(_taskEvents);
+  destroyWebServer();
+#ifndef ALOO_WM_STATIC_ALLOCATION
+  delete _scanBuffers;
+#endif
   if (_instance == this) _instance = nullptr;
 }
 
@@ -190,48 +406,82 @@ WiFiManager::~WiFiManager() {
 // Helper Functions for Shared Variables
 //--------------------------------------------------------------------------
 
-void WiFiManager::updateStatus(WiFiStatus newStatus) {
-  xSemaphoreTake(_statusMutex, portMAX_DELAY);
-  if (_status != newStatus) {
-    Serial.printf("[WM] Status: %s -> %s\n", wifiStatusToString(_status), wifiStatusToString(newStatus));
+bool WiFiManager::isTransitionAllowed(WiFiStatus from, WiFiStatus to) {
+  return (STATUS_TRANSITIONS[static_cast<uint8_t>(from)] & stateBit(to)) != 0;
+}
+
+/**
+ * @brief Moves the state machine to newStatus if the transition table allows it.
+ *
+ * Writers serialize on _statusMutex; readers only load the atomic. The event
+ * group is updated while the writer lock is held so the state bits always
+ * match _status once the lock is released.
+ * @return false if the transition was rejected.
+ */
+bool WiFiManager::updateStatus(WiFiStatus newStatus) {
+  takeMutex(_statusMutex, WiFiMutexId::STATUS);
+  WiFiStatus current = _status.load(std::memory_order_relaxed);
+  if (current == newStatus) {
+    xSemaphoreGive(_statusMutex);
+    return true;
+  }
+  if (!isTransitionAllowed(current, newStatus)) {
+    ALOO_LOGW(TAG, "Status: rejected %s -> %s", wifiStatusToString(current), wifiStatusToString(newStatus));
+    xSemaphoreGive(_statusMutex);
+    return false;
   }
-  _status = newStatus;
+  ALOO_LOGI(TAG, "Status: %s -> %s", wifiStatusToString(current), wifiStatusToString(newStatus));
+  _status.store(newStatus, std::memory_order_release);
+  xEventGroupClearBits(_stateEvents, ALL_STATE_BITS & ~stateBit(newStatus));
+  xEventGroupSetBits(_stateEvents, stateBit(newStatus) | EVT_STATE_CHANGED);
   xSemaphoreGive(_statusMutex);
 
-  // Manage internet check timer based on connection status.
-  if (newStatus == WiFiStatus::CONNECTED) {
-    if (_internetCheckTimer && xTimerIsTimerActive(_internetCheckTimer) == pdFALSE)
-      xTimerStart(_internetCheckTimer, 0);
-  } else {
-    if (_internetCheckTimer)
+  WiFiManagerEvent event = {};
+  event.type = WiFiManagerEventType::STATUS_CHANGED;
+  event.status = newStatus;
+  event.previous = current;
+  // Only the subscribers need it; the event task never waits on them.
+  postEvent(_notifications, event);
+
+  // Internet checks run while the STA link is up. Coming online starts a
+  // fresh probe window with an immediate check; the monitor then re-arms the
+  // timer after every round.
+  bool online = stateBit(newStatus) & ONLINE_STATE_BITS;
+  bool wasOnline = stateBit(current) & ONLINE_STATE_BITS;
+  if (online != wasOnline) {
+    if (online) {
+      _reachability.reset();
+      xEventGroupSetBits(_stateEvents, EVT_MONITOR_DUE);
+    } else if (_internetCheckTimer) {
       xTimerStop(_internetCheckTimer, 0);
+    }
   }
+  accountRadioState();
+  return true;
 }
 
 WiFiStatus WiFiManager::safeGetStatus() {
-  WiFiStatus stat;
-  xSemaphoreTake(_statusMutex, portMAX_DELAY);
-  stat = _status;
-  xSemaphoreGive(_statusMutex);
-  return stat;
+  return _status.load(std::memory_order_acquire);
 }
 
 void WiFiManager::setPendingCredentials(const String& ssid, const String& password) {
-  xSemaphoreTake(_pendingMutex, portMAX_DELAY);
+  takeMutex(_pendingMutex, WiFiMutexId::PENDING);
   _pendingSsid = ssid;
   _pendingPassword = password;
   _newCredentialsAvailable = true;
   xSemaphoreGive(_pendingMutex);
+  xEventGroupSetBits(_stateEvents, EVT_CREDENTIALS_PENDING);
 }
 
 bool WiFiManager::fetchPendingCredentials(String &ssid, String &password) {
   bool newCred = false;
-  xSemaphoreTake(_pendingMutex, portMAX_DELAY);
+  takeMutex(_pendingMutex, WiFiMutexId::PENDING);
   if (_newCredentialsAvailable) {
     ssid = _pendingSsid;
     password = _pendingPassword;
     _newCredentialsAvailable = false;
     newCred = true;
+    xEventGroupClearBits(_stateEvents, EVT_CREDENTIALS_PENDING);
   }
   xSemaphoreGive(_pendingMutex);
   return newCred;
@@ -243,7 +493,8 @@ bool WiFiManager::fetchPendingCredentials(String &ssid, String &password) {
 
 void WiFiManager::begin(bool runServerOnSeparateCore, int serverCore, int managerCore,
                           uint32_t managerTaskDelay, uint32_t serverTaskDelay,
-                          uint32_t monitorTaskDelay, uint32_t scanTaskDelay) {
+                          uint32_t monitorTaskDelay, uint32_t scanTaskDelay,
+                          WiFiServerBackend serverBackend) {
   _runServerOnSeparateCore = runServerOnSeparateCore;
   _serverCore = serverCore;
   _managerCore = managerCore;
@@ -252,39 +503,52 @@ void WiFiManager::begin(bool runServerOnSeparateCore, int serverCore, int manage
   _managerTaskDelay = managerTaskDelay;
   _serverTaskDelay = serverTaskDelay;
   _monitorTaskDelay = monitorTaskDelay;
-  _scanTaskDelay = scanTaskDelay;
-
-  Serial.println("WiFiManager: Starting asynchronous initialization...");
-
-  // Create the persistent connection manager task.
-  BaseType_t result = xTaskCreatePinnedToCore(
-    connectionManagerTask,
-    "WiFiConnMgrTask",
-    8192,
-    this,
-    1,
-    &_connectionManagerTaskHandle,
-    _managerCore
-  );
-  if (result != pdPASS) {
-    Serial.println("WiFiManager: Failed to create connection manager task.");
-    _connectionManagerTaskHandle = nullptr;
-  }
-
-  // Create the monitor task for checking connectivity.
-  result = xTaskCreatePinnedToCore(
-    monitorTask,
-    "WiFiMonitorTask",
-    4096,
-    this,
-    1,
-    &_monitorTaskHandle,
-    _managerCore
-  );
-  if (result != pdPASS) {
-    Serial.println("WiFiManager: Failed to create monitor task.");
-    _monitorTaskHandle = nullptr;
+  _reachability.begin(monitorTaskDelay);
+  _scanCacheTtl = scanTaskDelay;
+  applyPowerSettings();
+
+  _serverBackend = serverBackend;
+#ifndef ALOO_WM_ASYNC_SERVER
+  if (_serverBackend == WiFiServerBackend::ASYNC) {
+    ALOO_LOGW(TAG, "Async server not compiled in (define ALOO_WM_ASYNC_SERVER); using WebServer.");
+    _serverBackend = WiFiServerBackend::SYNC;
   }
+#endif
+
+  // Log records queue up until the drain task runs.
+  AlooLog::begin();
+  ALOO_LOGI(TAG, "Starting asynchronous initialization...");
+
+  // Allow a restart after end().
+  xEventGroupClearBits(_stateEvents, EVT_SHUTDOWN);
+
+  // Start the event task first so no WiFi event is handled late.
+  startTask(WiFiTaskId::DISPATCHER, eventDispatcherTask);
+  startTask(WiFiTaskId::NOTIFIER, notifierTask);
+
+  // Start the persistent connection manager task.
+  startTask(WiFiTaskId::CONNECTION_MANAGER, connectionManagerTask);
+
+  // Start the monitor task and the timer that paces its internet checks.
+  startTask(WiFiTaskId::MONITOR, monitorTask);
+  createInternetCheckTimer();
+
+  // Start the scan task; it sleeps until a scan is requested. A shared
+  // worker serves scans from the monitor task instead.
+  if (!_sharedWorker) startTask(WiFiTaskId::SCAN, scanTask);
+
+  // Start the write-behind task; it also writes changes made before begin().
+  startTask(WiFiTaskId::PERSIST, persistTask);
+}
+
+bool WiFiManager::end(uint32_t timeoutMs) {
+  ALOO_LOGI(TAG, "Stopping WiFi management tasks...");
+  stopAPMode();
+  if (_internetCheckTimer) xTimerStop(_internetCheckTimer, 0);
+  bool clean = stopTasks(timeoutMs);
+  // The tasks are gone, so nothing changes the mirror behind this last write.
+  flushStorage();
+  return clean;
 }
 
 WiFiStatus WiFiManager::getStatus() {
@@ -292,9 +556,8 @@ WiFiStatus WiFiManager::getStatus() {
 }
 
 void WiFiManager::processWebServer() {
-  if (!_runServerOnSeparateCore && _server) {
-    _server->handleClient();
-    _dnsServer.processNextRequest();
+  if (!_runServerOnSeparateCore && _portalActive) {
+    if (_server) _server->handleClient();
   }
 }
 
@@ -306,46 +569,478 @@ void WiFiManager::setConnectTimeout(unsigned long timeout) {
  * @brief Forces the device to start AP mode so that new credentials can be entered.
  */
 void WiFiManager::forceAPMode() {
-  Serial.println("WiFiManager: Forcing AP mode for new credentials...");
+  ALOO_LOGI(TAG, "Forcing AP mode for new credentials...");
   WiFi.setAutoReconnect(false);
-  WiFi.disconnect(true);
+  disconnectStation(true);
   stopAPMode();
   startAPMode();
   updateStatus(WiFiStatus::AP_MODE_ACTIVE);
 }
 
+void WiFiManager::setRetryPolicy(const WiFiRetryPolicy& policy) {
+  takeMutex(_connectionMutex, WiFiMutexId::CONNECTION);
+  _retryPolicy = policy;
+  if (_retryPolicy.pendingAttempts == 0) _retryPolicy.pendingAttempts = 1;
+  if (_retryPolicy.storedAttempts == 0) _retryPolicy.storedAttempts = 1;
+  if (_retryPolicy.multiplier < 1.0f) _retryPolicy.multiplier = 1.0f;
+  xSemaphoreGive(_connectionMutex);
+}
+
+WiFiRetryPolicy WiFiManager::getRetryPolicy() {
+  takeMutex(_connectionMutex, WiFiMutexId::CONNECTION);
+  WiFiRetryPolicy policy = _retryPolicy;
+  xSemaphoreGive(_connectionMutex);
+  return policy;
+}
+
+void WiFiManager::onConnectAttempt(ConnectAttemptCallback callback) {
+  _attemptCallback = callback;
+}
+
+void WiFiManager::setReachabilityConfig(const WiFiReachabilityConfig& config) {
+  _reachability.setConfig(config);
+}
+
+void WiFiManager::setReachabilityTargets(const WiFiProbeTarget* targets, size_t count) {
+  _reachability.setTargets(targets, count);
+}
+
+WiFiReachabilityStats WiFiManager::getReachability() {
+  return _reachability.stats();
+}
+
+WiFiPowerSettings WiFiManager::powerProfile(WiFiPowerProfile profile) {
+  WiFiPowerSettings settings;
+  switch (profile) {
+    case WiFiPowerProfile::PERFORMANCE:
+      settings.sleep = WIFI_PS_NONE;
+      settings.portalIdleMs = 0;
+      break;
+    case WiFiPowerProfile::LOW_POWER:
+      // Wake every 10th beacon (about 1 s on a 102.4 ms beacon interval);
+      // probes, scans and the portal all run at a quarter of the pace.
+      settings.sleep = WIFI_PS_MAX_MODEM;
+      settings.listenInterval = 10;
+      settings.cadenceScale = 4;
+      settings.portalIdleMs = 15000;
+      break;
+    case WiFiPowerProfile::BALANCED:
+    default:
+      break;
+  }
+  return settings;
+}
+
+void WiFiManager::setRecovery(WiFiDisconnectClass cls, WiFiRecovery recovery) {
+  if (cls >= WiFiDisconnectClass::COUNT || recovery >= WiFiRecovery::COUNT) return;
+  takeMutex(_connectionMutex, WiFiMutexId::CONNECTION);
+  _recovery[(size_t)cls] = recovery;
+  xSemaphoreGive(_connectionMutex);
+}
+
+WiFiDisconnectClass WiFiManager::classifyDisconnect(uint8_t reason) {
+  for (const DisconnectReasonClass& entry : DISCONNECT_CLASSES) {
+    if (entry.reason == reason) return entry.cls;
+  }
+  return WiFiDisconnectClass::OTHER;
+}
+
+void WiFiManager::setPowerProfile(WiFiPowerProfile profile) {
+  setPowerSettings(powerProfile(profile));
+}
+
+void WiFiManager::setPowerSettings(const WiFiPowerSettings& settings) {
+  takeMutex(_connectionMutex, WiFiMutexId::CONNECTION);
+  _powerSettings = settings;
+  if (_powerSettings.cadenceScale == 0) _powerSettings.cadenceScale = 1;
+  xSemaphoreGive(_connectionMutex);
+  applyPowerSettings();
+}
+
+WiFiPowerSettings WiFiManager::getPowerSettings() {
+  takeMutex(_connectionMutex, WiFiMutexId::CONNECTION);
+  WiFiPowerSettings settings = _powerSettings;
+  xSemaphoreGive(_connectionMutex);
+  return settings;
+}
+
+//--------------------------------------------------------------------------
+// Power Management
+//--------------------------------------------------------------------------
+
+/**
+ * @brief Pushes the power settings to the radio, the prober and the portal.
+ *        The Arduino core keeps the sleep type and re-applies it on mode changes.
+ */
+void WiFiManager::applyPowerSettings() {
+  WiFiPowerSettings settings = getPowerSettings();
+  _portalIdleMs = settings.portalIdleMs;
+  _modemSleep = settings.sleep != WIFI_PS_NONE;
+  _reachability.setIntervalScale(settings.cadenceScale);
+  takeMutex(_wifiMutex, WiFiMutexId::WIFI);
+  WiFi.setSleep(settings.sleep);
+  xSemaphoreGive(_wifiMutex);
+  // A portal that was parked under a shorter idle limit starts counting again.
+  _portalIdleSince = millis();
+  if (_portalActive && _runServerOnSeparateCore) resumeTask(WiFiTaskId::SERVER);
+  accountRadioState();
+}
+
+/**
+ * @brief Applies modem sleep once the station is associated and the softAP is down.
+ */
+void WiFiManager::applyStationPowerSave() {
+  WiFiPowerSettings settings = getPowerSettings();
+  takeMutex(_wifiMutex, WiFiMutexId::WIFI);
+  WiFi.setSleep(settings.sleep);
+  xSemaphoreGive(_wifiMutex);
+}
+
+/**
+ * @brief Writes the profile's listen interval into the station config.
+ *        Caller holds _wifiMutex; the station must not be associated.
+ *
+ * WiFi.begin() rebuilds the config with the default interval, and rewriting
+ * the config of a live association makes the IDF drop it (reason 8), so
+ * startConnection() lets WiFi.begin() stop short of connecting, patches the
+ * interval here and then connects.
+ */
+void WiFiManager::applyListenInterval(uint16_t listenInterval) {
+#ifdef ESP32
+  wifi_config_t config;
+  if (listenInterval != 0 && esp_wifi_get_config(WIFI_IF_STA, &config) == ESP_OK &&
+      config.sta.listen_interval != listenInterval) {
+    config.sta.listen_interval = listenInterval;
+    if (esp_wifi_set_config(WIFI_IF_STA, &config) != ESP_OK) {
+      ALOO_LOGW(TAG, "Failed to set listen interval %u.", listenInterval);
+    }
+  }
+#endif
+}
+
+/**
+ * @brief Scan cache lifetime under the current power profile.
+ */
+uint32_t WiFiManager::scanCacheTtl() {
+  return _scanCacheTtl * getPowerSettings().cadenceScale;
+}
+
+/**
+ * @brief Derives the radio state from the manager's own view of the link.
+ */
+WiFiRadioState WiFiManager::currentRadioState() {
+  if (_radioScanning) return WiFiRadioState::SCAN;
+  if (_portalActive) return WiFiRadioState::AP;
+  switch (safeGetStatus()) {
+    case WiFiStatus::CONNECTED:
+    case WiFiStatus::NO_INTERNET:
+      return _modemSleep ? WiFiRadioState::MODEM_SLEEP : WiFiRadioState::ACTIVE;
+    case WiFiStatus::TRYING_TO_CONNECT:
+      return WiFiRadioState::CONNECTING;
+    default:
+      return WiFiRadioState::IDLE;
+  }
+}
+
+/**
+ * @brief Charges the time since the last call to the previous radio state
+ *        and enters the current one. Called on every input change and before
+ *        the times are read.
+ */
+void WiFiManager::accountRadioState() {
+  WiFiRadioState state = currentRadioState();
+  uint32_t now = millis();
+  portENTER_CRITICAL(&_radioLock);
+  _radioStateMs[(size_t)_radioState] += now - _radioStateSince;
+  _radioStateSince = now;
+  _radioState = state;
+  portEXIT_CRITICAL(&_radioLock);
+}
+
+int WiFiManager::subscribe(EventCallback callback, uint32_t mask) {
+  if (!callback || !mask) return -1;
+  // Callbacks run with _subscribersMutex held by the notifier task.
+  bool locked = xTaskGetCurrentTaskHandle() != _notifierTaskHandle;
+  if (locked) takeMutex(_subscribersMutex, WiFiMutexId::SUBSCRIBERS);
+  int id = -1;
+  for (size_t i = 0; i < ALOO_WM_MAX_SUBSCRIBERS; i++) {
+    if (!_subscribers[i].callback) {
+      _subscribers[i].callback = callback;
+      _subscribers[i].mask = mask;
+      id = (int)i;
+      break;
+    }
+  }
+  if (locked) xSemaphoreGive(_subscribersMutex);
+  return id;
+}
+
+void WiFiManager::unsubscribe(int id) {
+  if (id < 0 || id >= ALOO_WM_MAX_SUBSCRIBERS) return;
+  if (xTaskGetCurrentTaskHandle() == _notifierTaskHandle) {
+    // From a callback: the callback may be the one running, so only disable
+    // the slot; publishEvent() frees it after the loop.
+    _subscribers[id].mask = 0;
+    return;
+  }
+  takeMutex(_subscribersMutex, WiFiMutexId::SUBSCRIBERS);
+  _subscribers[id].callback = nullptr;
+  _subscribers[id].mask = 0;
+  xSemaphoreGive(_subscribersMutex);
+}
+
+void WiFiManager::setFastReconnect(bool enabled, unsigned long timeout, uint32_t leaseLifetime) {
+  _fastReconnect = enabled;
+  _fastConnectTimeout = timeout;
+  _leaseLifetime = leaseLifetime;
+}
+
+void WiFiManager::setDualMode(bool enabled, uint32_t graceMs) {
+  _dualMode = enabled;
+  _portalGraceMs = graceMs;
+}
+
 /**
  * @brief Initiates a connection attempt using the given credentials.
  *        This is non-blocking; the result is handled via events.
  */
 bool WiFiManager::tryConnect(const String &ssid, const String &password) {
-  if (xSemaphoreTake(_connectingMutex, portMAX_DELAY) != pdTRUE) return false;
-  
+  startConnection(ssid, password, true);
+  return true;
+}
+
+/**
+ * @brief Starts a connection attempt, using the directed fast path when allowed
+ *        and the fast reconnect cache belongs to the given SSID.
+ * @return true if the attempt targets the cached BSSID/channel.
+ */
+bool WiFiManager::startConnection(const String &ssid, const String &password, bool allowFast) {
+  if (takeMutex(_connectingMutex, WiFiMutexId::CONNECTING) != pdTRUE) return false;
+
   // Save the credentials for later storage upon successful connection.
   _currentSsid = ssid;
   _currentPassword = password;
 
+  // Snapshot the fast reconnect cache; saveLastCredentials() may rewrite it.
+  takeMutex(_credentialsMutex, WiFiMutexId::CREDENTIALS);
+  bool fast = allowFast && _fastReconnect && !_fastCacheStale && _fastConnectChannel != 0 &&
+              ssid == _fastConnectSsid;
+  bool useLease = fast && isLeaseValid();
+  IpLease lease = _lease;
+  uint8_t bssid[6];
+  memcpy(bssid, _fastConnectBssid, sizeof(bssid));
+  uint8_t channel = _fastConnectChannel;
+  xSemaphoreGive(_credentialsMutex);
+  if (!fast) channel = scannedChannel(ssid);
+  uint16_t listenInterval = getPowerSettings().listenInterval;
+
   updateStatus(WiFiStatus::TRYING_TO_CONNECT);
-  Serial.printf("WiFiManager: Attempting to connect to %s\n", ssid.c_str());
-  
+  ALOO_LOGI(TAG, "Attempting to %sconnect to %s", fast ? "fast-" : "", ssid.c_str());
+
   // Use WiFi mutex to ensure exclusive access during connection attempts.
-  xSemaphoreTake(_wifiMutex, portMAX_DELAY);
-  WiFi.setAutoReconnect(true);
-  WiFi.begin(ssid.c_str(), password.c_str());
+  takeMutex(_wifiMutex, WiFiMutexId::WIFI);
+  // The manager runs every retry itself (see attemptConnection()); a link the
+  // core restarted on its own would belong to no attempt.
+  WiFi.setAutoReconnect(false);
+  // A DHCP client left running from the last link is reset by esp_netif's
+  // DHCP start below, or restarted by startLeaseRenewal() on GOT_IP.
+  _leaseDhcp = LeaseDhcp::OFF;
+  if (useLease) {
+    WiFi.config(IPAddress(lease.ip), IPAddress(lease.gateway), IPAddress(lease.subnet), IPAddress(lease.dns));
+  } else if (_usingStaticLease) {
+    // Return to DHCP after a previous attempt ran on the cached lease.
+    WiFi.config(IPAddress((uint32_t)0), IPAddress((uint32_t)0), IPAddress((uint32_t)0));
+  }
+  _usingStaticLease = useLease;
+  _connectStartedAt = millis();
+  // The channel only tells the driver where to look first; without the fast
+  // path's BSSID any BSSID of the SSID may still be picked. WiFi.begin() only
+  // writes the config, so the listen interval is in place before associating.
+  WiFi.begin(ssid.c_str(), password.c_str(), channel, fast ? bssid : nullptr, false);
+  applyListenInterval(listenInterval);
+  _attemptId++;
+  _linkPending = true;
+  if (esp_wifi_connect() != ESP_OK) {
+    _linkPending = false;
+    ALOO_LOGW(TAG, "Failed to start connecting to %s.", ssid.c_str());
+  }
   xSemaphoreGive(_wifiMutex);
-  
+
   // Brief delay to allow the connection attempt to start.
   vTaskDelay(pdMS_TO_TICKS(100));
   xSemaphoreGive(_connectingMutex);
-  return true;
+  return fast;
+}
+
+/**
+ * @brief Channel of the strongest BSSID of ssid in the last scan, if that
+ *        scan is still within the cache TTL.
+ * @return The channel, or 0 (no hint).
+ */
+uint8_t WiFiManager::scannedChannel(const String &ssid) {
+  uint8_t channel = 0;
+  uint32_t ttl = scanCacheTtl();
+  if (takeMutex(_networksMutex, WiFiMutexId::NETWORKS) == pdTRUE) {
+    if (_lastScanAt != 0 && millis() - _lastScanAt < ttl) {
+      for (size_t n = 0; n < _scanResultCount; n++) {
+        if (strcmp(_scanResults[n].ssid, ssid.c_str()) == 0) {
+          channel = _scanResults[n].channel;
+          break;
+        }
+      }
+    }
+    xSemaphoreGive(_networksMutex);
+  }
+  return channel;
+}
+
+//--------------------------------------------------------------------------
+// Cached DHCP Lease
+//--------------------------------------------------------------------------
+
+// Copy of the last lease stamp in RTC memory, which like the RTC timer behind
+// time() is only cleared by a power-on reset. A matching copy shows that a
+// stamp taken before wall-clock time was set is on the clock still running.
+static const uint32_t LEASE_STAMP_MAGIC = 0x4C454153;  // "LEAS"
+RTC_NOINIT_ATTR static uint32_t leaseStampMagic;
+RTC_NOINIT_ATTR static uint32_t leaseStampIp;
+RTC_NOINIT_ATTR static uint32_t leaseStampAt;
+
+/**
+ * @brief Whether the cached lease may still be used. Caller holds _credentialsMutex.
+ *
+ * Without wall-clock time, time() counts on the RTC timer from the last
+ * power-on; a lease from an earlier power cycle would look fresh forever, so
+ * such a stamp is only trusted while its RTC copy survived.
+ */
+bool WiFiManager::isLeaseValid() const {
+  if (_lease.ip == 0 || _lease.obtainedAt == 0 || _leaseLifetime == 0) return false;
+  uint32_t now = (uint32_t)time(nullptr);
+  bool wallClock = _lease.obtainedAt >= ALOO_WM_MIN_VALID_EPOCH;
+  // The clock was set, or lost with the power, since the stamp.
+  if (wallClock != (now >= ALOO_WM_MIN_VALID_EPOCH)) return false;
+  if (!wallClock && (leaseStampMagic != LEASE_STAMP_MAGIC || leaseStampIp != _lease.ip ||
+                     leaseStampAt != _lease.obtainedAt)) {
+    return false;
+  }
+  return now >= _lease.obtainedAt && now - _lease.obtainedAt < _leaseLifetime;
+}
+
+/**
+ * @brief Caches the station's current DHCP lease. Caller holds _credentialsMutex.
+ */
+void WiFiManager::recordLease() {
+  _lease.ip = (uint32_t)WiFi.localIP();
+  _lease.gateway = (uint32_t)WiFi.gatewayIP();
+  _lease.subnet = (uint32_t)WiFi.subnetMask();
+  _lease.dns = (uint32_t)WiFi.dnsIP();
+  stampLease();
+}
+
+/**
+ * @brief Dates the cached lease as granted now. Caller holds _credentialsMutex.
+ */
+void WiFiManager::stampLease() {
+  uint32_t now = (uint32_t)time(nullptr);
+  _lease.obtainedAt = now ? now : 1;
+  leaseStampIp = _lease.ip;
+  leaseStampAt = _lease.obtainedAt;
+  leaseStampMagic = LEASE_STAMP_MAGIC;
+}
+
+// esp_netif only returns a static interface to DHCP by clearing its address
+// first. The lwIP DHCP client is therefore driven directly, on the TCP/IP
+// thread: started next to the cached address, it negotiates and then renews
+// in the background without touching the address unless the server moves it.
+// esp_netif is not told, so the manager polls the client.
+enum class LeaseDhcpOp : uint8_t { START, POLL };
+struct LeaseDhcpCall {
+  struct tcpip_api_call_data call;  // First, as lwIP passes a pointer to it
+  struct netif* netif;
+  LeaseDhcpOp op;
+  bool bound;
+  uint32_t ip;
+  uint32_t subnet;
+  uint32_t gateway;
+};
+
+static err_t leaseDhcpOnTcpip(struct tcpip_api_call_data* call) {
+  LeaseDhcpCall* msg = reinterpret_cast<LeaseDhcpCall*>(call);
+  if (msg->op == LeaseDhcpOp::START) return dhcp_start(msg->netif);
+  msg->bound = dhcp_supplied_address(msg->netif) != 0;
+  msg->ip = netif_ip4_addr(msg->netif)->addr;
+  msg->subnet = netif_ip4_netmask(msg->netif)->addr;
+  msg->gateway = netif_ip4_gw(msg->netif)->addr;
+  return ERR_OK;
+}
+
+static bool runLeaseDhcp(LeaseDhcpCall& msg, LeaseDhcpOp op) {
+  esp_netif_t* sta = esp_netif_get_handle_from_ifkey("WIFI_STA_DEF");
+  msg.netif = sta ? static_cast<struct netif*>(esp_netif_get_netif_impl(sta)) : nullptr;
+  if (!msg.netif) return false;
+  msg.op = op;
+  return tcpip_api_call(leaseDhcpOnTcpip, &msg.call) == ERR_OK;
+}
+
+/**
+ * @brief Starts DHCP next to the cached address after a connect on it, so
+ *        the lease is renewed without the station dropping its address.
+ */
+void WiFiManager::startLeaseRenewal() {
+  LeaseDhcpCall msg = {};
+  if (!runLeaseDhcp(msg, LeaseDhcpOp::START)) {
+    ALOO_LOGW(TAG, "Could not start DHCP next to the cached lease.");
+    return;
+  }
+  _leaseDhcp = LeaseDhcp::RENEWING;
+}
+
+/**
+ * @brief Polled by the connection manager while online: records the lease
+ *        once DHCP confirms the cached address, and hands the interface to
+ *        esp_netif's DHCP client if the server moved it (or revoked it).
+ */
+void WiFiManager::checkLeaseRenewal() {
+  LeaseDhcp state = _leaseDhcp.load();
+  if (state != LeaseDhcp::RENEWING && state != LeaseDhcp::BOUND) return;
+  LeaseDhcpCall msg = {};
+  if (!runLeaseDhcp(msg, LeaseDhcpOp::POLL)) return;
+  if (state == LeaseDhcp::RENEWING && !msg.bound) return;  // Still negotiating
+
+  takeMutex(_credentialsMutex, WiFiMutexId::CREDENTIALS);
+  bool kept = msg.bound && msg.ip == _lease.ip;
+  if (kept && state == LeaseDhcp::RENEWING) {
+    _lease.subnet = msg.subnet;
+    _lease.gateway = msg.gateway;
+    stampLease();
+    markStorageDirty(false);
+  }
+  xSemaphoreGive(_credentialsMutex);
+
+  if (kept) {
+    // A disconnect meanwhile reset the state; leave it alone then.
+    if (state == LeaseDhcp::RENEWING && _leaseDhcp.compare_exchange_strong(state, LeaseDhcp::BOUND)) {
+      ALOO_LOGI(TAG, "DHCP confirmed the cached lease %s.", IPAddress(msg.ip).toString().c_str());
+    }
+    return;
+  }
+  // lwIP changed the address behind esp_netif; esp_netif's client restarts
+  // on a clean interface and its GOT_IP records the new lease.
+  if (!_leaseDhcp.compare_exchange_strong(state, LeaseDhcp::HANDOVER)) return;
+  ALOO_LOGW(TAG, "DHCP moved the station off the cached lease; restarting DHCP.");
+  takeMutex(_wifiMutex, WiFiMutexId::WIFI);
+  WiFi.config(IPAddress((uint32_t)0), IPAddress((uint32_t)0), IPAddress((uint32_t)0));
+  _usingStaticLease = false;
+  xSemaphoreGive(_wifiMutex);
 }
+
 bool WiFiManager::resetWiFi() {
-    xSemaphoreTake(_wifiMutex, portMAX_DELAY);
+    takeMutex(_wifiMutex, WiFiMutexId::WIFI);
     
-    Serial.println("WiFiManager: Performing full WiFi reset...");
+    ALOO_LOGI(TAG, "Performing full WiFi reset...");
     
     // Force disconnect and disable interfaces
-    WiFi.disconnect(true, true);  // Disconnect + disable STA
+    disconnectStation(true, true);  // Disconnect + disable STA
     WiFi.enableAP(false);
     delay(100);
     
@@ -369,7 +1064,7 @@ bool WiFiManager::resetWiFi() {
     
     xSemaphoreGive(_wifiMutex);
     
-    Serial.println("WiFiManager: WiFi stack fully reset");
+    ALOO_LOGI(TAG, "WiFi stack fully reset");
     return true;
 }
 
@@ -377,96 +1072,698 @@ bool WiFiManager::resetWiFi() {
 // Web Server Helpers (Default Embedded Web Files)
 //--------------------------------------------------------------------------
 void WiFiManager::setupDefaultEndpoints() {
-  // Setup endpoints to serve the default embedded HTML, CSS, and JS files.
-  _server->on("/", [this]() {
-    _server->send(200, "text/html", defaultIndexHtml);
-  });
-  _server->on("/index.html", [this]() {
-    _server->send(200, "text/html", defaultIndexHtml);
-  });
-  _server->on("/connect", [this]() {
-    _server->send(200, "text/html", defaultConnectHtml);
-  });
-  _server->on("/style.css", [this]() {
-    _server->send(200, "text/css", defaultStyleCss);
-  });
-  _server->on("/script.js", [this]() {
-    _server->send(200, "application/javascript", defaultScriptJs);
-  });
+  // A portal filesystem replaces the embedded files entirely. Its static
+  // handler also serves "<file>.gz" variants when present.
+  if (_portalFs) {
+    _server->serveStatic("/", *_portalFs, _portalFsRoot.c_str(), _portalFsCacheControl.c_str());
+    return;
+  }
+  // A registered bundle overrides embedded assets with the same path; handlers
+  // registered first win.
+  for (size_t i = 0; i < _userAssetCount; i++) {
+    const WiFiPortalAsset* asset = &_userAssets[i];
+    _server->on(asset->path, HTTP_GET, [this, asset]() { servePortalAsset(*asset); });
+  }
+  for (const WiFiPortalAsset& asset : defaultPortalAssets) {
+    const WiFiPortalAsset* entry = &asset;
+    _server->on(entry->path, HTTP_GET, [this, entry]() { servePortalAsset(*entry); });
+  }
+}
+
+// Cache-Control value for an embedded asset (shared by both server backends).
+static void formatCacheControl(const WiFiPortalAsset& asset, char* buffer, size_t size) {
+  if (asset.maxAge) {
+    snprintf(buffer, size, "public, max-age=%lu, immutable", (unsigned long)asset.maxAge);
+  } else {
+    strlcpy(buffer, "no-cache", size);
+  }
+}
+
+// Whether to answer with the gzip body given the request's Accept-Encoding.
+static bool selectGzip(const WiFiPortalAsset& asset, const String& acceptEncoding) {
+  return asset.gzipData && (!asset.data || acceptEncoding.indexOf("gzip") >= 0);
+}
+
+/**
+ * @brief Serves a PROGMEM asset, honouring If-None-Match and Accept-Encoding.
+ */
+void WiFiManager::servePortalAsset(const WiFiPortalAsset& asset) {
+  AlooScopedTimer timer(routeMetric(WiFiHttpRoute::PORTAL));
+  if (asset.etag) {
+    _server->sendHeader("ETag", asset.etag);
+  }
+  char cacheControl[48];
+  formatCacheControl(asset, cacheControl, sizeof(cacheControl));
+  _server->sendHeader("Cache-Control", cacheControl);
+  if (asset.etag && _server->header("If-None-Match") == asset.etag) {
+    _server->send(304);
+    return;
+  }
+
+  bool gzip = selectGzip(asset, _server->header("Accept-Encoding"));
+  if (asset.gzipData && asset.data) {
+    _server->sendHeader("Vary", "Accept-Encoding");
+  }
+  if (gzip) {
+    _server->sendHeader("Content-Encoding", "gzip");
+    _server->send_P(200, asset.contentType, (PGM_P)asset.gzipData, asset.gzipLength);
+  } else {
+    _server->send_P(200, asset.contentType, (PGM_P)asset.data, asset.length);
+  }
+}
+
+void WiFiManager::registerPortalAssets(const WiFiPortalAsset* assets, size_t count) {
+  _userAssets = assets;
+  _userAssetCount = assets ? count : 0;
+}
+
+void WiFiManager::setPortalFilesystem(fs::FS* fs, const char* root, const char* cacheControl) {
+  _portalFs = fs;
+  _portalFsRoot = root;
+  _portalFsCacheControl = cacheControl;
 }
 
 //--------------------------------------------------------------------------
 // Credential Storage Helpers
 //--------------------------------------------------------------------------
+// Credentials, the fast reconnect cache and the lease are kept in RAM and
+// written to flash as one record by the persist task. Nothing on the connect
+// path touches NVS; see markStorageDirty() and flushStorage().
+
+// CRC-32 (IEEE 802.3, reflected). Bitwise: the record is checked once per
+// boot and per write, which does not justify a table.
+static uint32_t recordCrc32(const uint8_t* data, size_t length) {
+  uint32_t crc = 0xFFFFFFFF;
+  while (length--) {
+    crc ^= *data++;
+    for (int bit = 0; bit < 8; bit++) crc = (crc >> 1) ^ (0xEDB88320 & (0u - (crc & 1)));
+  }
+  return ~crc;
+}
 
 bool WiFiManager::resetCredentials() {
+  // Holding _storageMutex keeps a flush in progress from rewriting the old record afterwards.
+  takeMutex(_storageMutex, WiFiMutexId::STORAGE);
   if (!_preferences.begin(PREF_NAMESPACE, false)) {
-    Serial.println("WiFiManager: Failed to initialize preferences for reset.");
+    ALOO_LOGE(TAG, "Failed to initialize preferences for reset.");
+    xSemaphoreGive(_storageMutex);
     return false;
   }
+  takeMutex(_credentialsMutex, WiFiMutexId::CREDENTIALS);
   bool success = _preferences.clear();
   _preferences.end();
+  _credentialsLoaded = false;
+  _storageDirty = false;
   if (success) {
-    Serial.println("WiFiManager: Credentials reset successfully.");
+    _lastSsid[0] = '\0';
+    _lastPassword[0] = '\0';
+    _fastConnectSsid = "";
+    _fastConnectChannel = 0;
+    _lease = IpLease{};
+  }
+  xSemaphoreGive(_credentialsMutex);
+  xSemaphoreGive(_storageMutex);
+  if (success) {
+    ALOO_LOGI(TAG, "Credentials reset successfully.");
   } else {
-    Serial.println("WiFiManager: Failed to reset credentials.");
+    ALOO_LOGE(TAG, "Failed to reset credentials.");
   }
   return success;
 }
 
+/**
+ * @brief Returns the last successful network from the RAM mirror; flash is
+ *        only read the first time.
+ */
 bool WiFiManager::loadLastCredentials(String &ssid, String &password) {
-  if (!_preferences.begin(PREF_NAMESPACE, true)) {
-    Serial.println("WiFiManager: Failed to initialize preferences (read-only).");
-    return false;
-  }
-  ssid = _preferences.getString(PREF_SSID_KEY, "");
-  password = _preferences.getString(PREF_PASS_KEY, "");
-  _preferences.end();
+  takeMutex(_credentialsMutex, WiFiMutexId::CREDENTIALS);
+  ensureCredentialTableLoaded();
+  ssid = _lastSsid;
+  password = _lastPassword;
+  xSemaphoreGive(_credentialsMutex);
   return (!ssid.isEmpty() && !password.isEmpty());
 }
 
+/**
+ * @brief Records a successful connection in RAM and schedules the write.
+ *
+ * Runs on every GOT_IP, so it never touches flash itself. Reconnecting to
+ * the same network with the same password only updates statistics and the
+ * fast reconnect cache, which are written after ALOO_WM_PERSIST_STATS_DELAY_MS
+ * (or with the next credential change); new credentials are written after
+ * ALOO_WM_PERSIST_DELAY_MS.
+ */
 bool WiFiManager::saveLastCredentials(const String &ssid, const String &password) {
-  if (!_preferences.begin(PREF_NAMESPACE, false)) {
-    Serial.println("WiFiManager: Failed to initialize preferences (read-write).");
+  takeMutex(_credentialsMutex, WiFiMutexId::CREDENTIALS);
+  ensureCredentialTableLoaded();
+  int idx = findCredential(ssid);
+  bool credentialsChanged = strcmp(_lastSsid, ssid.c_str()) != 0 || strcmp(_lastPassword, password.c_str()) != 0 ||
+                            idx < 0 || strcmp(_credentials.entries[idx].password, password.c_str()) != 0;
+  strlcpy(_lastSsid, ssid.c_str(), sizeof(_lastSsid));
+  strlcpy(_lastPassword, password.c_str(), sizeof(_lastPassword));
+
+  // Cache the AP and lease of this connection for the next fast reconnect.
+  const uint8_t* bssid = WiFi.BSSID();
+  if (bssid) {
+    memcpy(_fastConnectBssid, bssid, sizeof(_fastConnectBssid));
+    _fastConnectChannel = (uint8_t)WiFi.channel();
+    _fastConnectSsid = ssid;
+    _fastCacheStale = false;
+  }
+  // A connection made on the cached lease keeps it until DHCP renews it.
+  if (!_usingStaticLease) recordLease();
+
+  // Record the success in the known-network table.
+  CredentialEntry* entry = upsertCredential(ssid, password);
+  if (entry) {
+    uint32_t latency = millis() - _connectStartedAt;
+    if (latency > UINT16_MAX) latency = UINT16_MAX;
+    if (entry->successCount < UINT16_MAX) entry->successCount++;
+    entry->authFailures = 0;
+    entry->lastConnected = ++_credentials.sequence;
+    entry->avgConnectMs = entry->avgConnectMs ? (entry->avgConnectMs * 3 + latency) / 4 : latency;
+  }
+  markStorageDirty(credentialsChanged);
+  xSemaphoreGive(_credentialsMutex);
+
+  if (!entry) {
+    ALOO_LOGE(TAG, "Credentials for %s do not fit the credential table.", ssid.c_str());
     return false;
   }
-  bool ssidSuccess = _preferences.putString(PREF_SSID_KEY, ssid);
-  bool passSuccess = _preferences.putString(PREF_PASS_KEY, password);
-  _preferences.end();
+  ALOO_LOGD(TAG, "Connection to %s recorded%s.", ssid.c_str(), credentialsChanged ? " (new credentials)" : "");
+  return true;
+}
+
+/**
+ * @brief Schedules the persist task. Caller holds _credentialsMutex.
+ *
+ * A pending deadline is never pushed back, so a stream of changes still
+ * reaches flash in bounded time.
+ * @param credentialsChanged Use the short delay (credentials added, changed
+ *                           or removed) rather than the statistics delay.
+ */
+void WiFiManager::markStorageDirty(bool credentialsChanged) {
+  TickType_t due = xTaskGetTickCount() +
+                   pdMS_TO_TICKS(credentialsChanged ? ALOO_WM_PERSIST_DELAY_MS : ALOO_WM_PERSIST_STATS_DELAY_MS);
+  if (!_storageDirty || (int32_t)(due - _flushDueAt) < 0) _flushDueAt = due;
+  _storageDirty = true;
+  if (_persistTaskHandle) xTaskNotifyGive(_persistTaskHandle);
+}
+
+/**
+ * @brief Writes the RAM state to flash if it differs from the stored record.
+ *
+ * The record is built under _credentialsMutex and compared with the image of
+ * what flash holds, so a flush that would write identical bytes costs no
+ * flash write. The NVS write itself runs without _credentialsMutex, so
+ * connection attempts are never held up by it.
+ */
+bool WiFiManager::flushStorage() {
+  takeMutex(_storageMutex, WiFiMutexId::STORAGE);
+  takeMutex(_credentialsMutex, WiFiMutexId::CREDENTIALS);
+  if (!_storageDirty) {
+    xSemaphoreGive(_credentialsMutex);
+    xSemaphoreGive(_storageMutex);
+    return true;
+  }
+  PersistentRecord record;
+  buildPersistentRecord(record);
+  _storageDirty = false;
+  xSemaphoreGive(_credentialsMutex);
+
+  const size_t payloadStart = offsetof(PersistentRecord, lastSsid);
+  const size_t payloadLength = offsetof(PersistentRecord, crc) - payloadStart;
+  if (memcmp(reinterpret_cast<const uint8_t*>(&record) + payloadStart,
+             reinterpret_cast<const uint8_t*>(&_storedRecord) + payloadStart, payloadLength) == 0) {
+    _metrics.storageWritesSkipped.increment();
+    xSemaphoreGive(_storageMutex);
+    return true;
+  }
 
-  if (ssidSuccess && passSuccess) {
-    Serial.println("WiFiManager: Credentials saved to preferences.");
+  record.generation = _storedRecord.generation + 1;
+  record.crc = recordCrc32(reinterpret_cast<const uint8_t*>(&record), offsetof(PersistentRecord, crc));
+  bool success = false;
+  if (_preferences.begin(PREF_NAMESPACE, false)) {
+    success = _preferences.putBytes(PREF_STATE_KEY, &record, sizeof(record)) == sizeof(record);
+    if (success && _storedRecord.generation == 0) {
+      // First write of this layout: drop the keys it replaces.
+      const char* const legacyKeys[] = {
+        PREF_SSID_KEY, PREF_PASS_KEY, PREF_BSSID_KEY, PREF_CHANNEL_KEY, PREF_LEASE_KEY, PREF_TABLE_KEY
+      };
+      for (const char* key : legacyKeys) {
+        if (_preferences.isKey(key)) _preferences.remove(key);
+      }
+    }
+    _preferences.end();
+  }
+  if (success) {
+    _storedRecord = record;
+    _metrics.storageWrites.increment();
+    ALOO_LOGD(TAG, "Stored record written (generation %lu).", (unsigned long)record.generation);
   } else {
-    Serial.println("WiFiManager: Failed to save credentials properly.");
+    _metrics.storageWriteFailures.increment();
+    ALOO_LOGE(TAG, "Failed to write the stored record; retrying later.");
+    takeMutex(_credentialsMutex, WiFiMutexId::CREDENTIALS);
+    markStorageDirty(true);
+    xSemaphoreGive(_credentialsMutex);
   }
-  return ssidSuccess && passSuccess;
+  xSemaphoreGive(_storageMutex);
+  return success;
 }
 
 //--------------------------------------------------------------------------
-// AP Mode & Captive Portal Functions
+// Known-Network Credential Table
 //--------------------------------------------------------------------------
+// All helpers below expect the caller to hold _credentialsMutex.
 
-void WiFiManager::setupCaptivePortal() {
-  // Start DNS server to catch all DNS requests and redirect to the AP IP.
-  _dnsServer.start(53, "*", WiFi.softAPIP());
-  // Redirect common captive portal requests.
-  _server->on("/generate_204", [this]() { handleRedirect(); });
-  _server->on("/hotspot-detect.html", [this]() { handleRedirect(); });
-  _server->on("/connecttest.txt", [this]() { handleRedirect(); });
-  _server->on("/ncsi.txt", [this]() { handleRedirect(); });
-  _server->onNotFound([this]() {
-    if (!isIp(_server->hostHeader())) {
-      handleRedirect();
+/**
+ * @brief Loads the stored record into RAM on first use.
+ *
+ * A record that fails its size, version or CRC check is ignored. Without a
+ * record, the old one-key-per-field layout is read and written back as a
+ * record by the persist task.
+ */
+void WiFiManager::ensureCredentialTableLoaded() {
+  if (_credentialsLoaded) return;
+  PersistentRecord& record = _storedRecord;
+  memset(&record, 0, sizeof(record));
+
+  bool stored = false;
+  bool migrated = false;
+  if (_preferences.begin(PREF_NAMESPACE, true)) {
+    if (_preferences.isKey(PREF_STATE_KEY)) {
+      stored = _preferences.getBytes(PREF_STATE_KEY, &record, sizeof(record)) == sizeof(record) &&
+               record.version == PERSISTENT_RECORD_VERSION && record.size == sizeof(record) &&
+               record.crc == recordCrc32(reinterpret_cast<const uint8_t*>(&record), offsetof(PersistentRecord, crc)) &&
+               record.credentials.count <= ALOO_WM_MAX_CREDENTIALS;
+      if (!stored) ALOO_LOGW(TAG, "Stored record is invalid; starting empty.");
     } else {
-      _server->send(404, "text/plain", "404: Not Found");
+      migrated = readLegacyRecord(record);
     }
-  });
+    _preferences.end();
+  }
+  if (!stored && !migrated) memset(&record, 0, sizeof(record));
+  applyPersistentRecord(record);
+  _credentialsLoaded = true;
+
+  if (!stored) {
+    // Flash does not hold this state as a record yet.
+    memset(&_storedRecord, 0, sizeof(_storedRecord));
+    if (migrated) {
+      ALOO_LOGI(TAG, "Migrating stored credentials to the single-record layout.");
+      markStorageDirty(true);
+    }
+  }
+}
+
+/**
+ * @brief Reads the pre-record layout (separate keys per field) into record.
+ *        Preferences must be open.
+ * @return true if any of it was present.
+ */
+bool WiFiManager::readLegacyRecord(PersistentRecord& record) {
+  bool hasTable = false;
+  if (_preferences.isKey(PREF_TABLE_KEY)) {
+    hasTable = _preferences.getBytes(PREF_TABLE_KEY, &record.credentials, sizeof(record.credentials)) ==
+                   sizeof(record.credentials) &&
+               record.credentials.version == CREDENTIAL_TABLE_VERSION &&
+               record.credentials.count <= ALOO_WM_MAX_CREDENTIALS;
+  }
+  if (!hasTable) memset(&record.credentials, 0, sizeof(record.credentials));
+
+  String ssid = _preferences.getString(PREF_SSID_KEY, "");
+  String password = _preferences.getString(PREF_PASS_KEY, "");
+  strlcpy(record.lastSsid, ssid.c_str(), sizeof(record.lastSsid));
+  strlcpy(record.lastPassword, password.c_str(), sizeof(record.lastPassword));
+  record.lastChannel = _preferences.getUChar(PREF_CHANNEL_KEY, 0);
+  if (record.lastChannel != 0 &&
+      _preferences.getBytes(PREF_BSSID_KEY, record.lastBssid, sizeof(record.lastBssid)) != sizeof(record.lastBssid)) {
+    record.lastChannel = 0;
+  }
+  if (_preferences.getBytes(PREF_LEASE_KEY, &record.lease, sizeof(record.lease)) != sizeof(record.lease)) {
+    record.lease = IpLease{};
+  }
+
+  // The single-network layout predates the table; seed the table with it.
+  if (!hasTable && !ssid.isEmpty() && !password.isEmpty()) {
+    record.credentials.count = 1;
+    strlcpy(record.credentials.entries[0].ssid, record.lastSsid, sizeof(CredentialEntry::ssid));
+    strlcpy(record.credentials.entries[0].password, record.lastPassword, sizeof(CredentialEntry::password));
+  }
+  return hasTable || !ssid.isEmpty();
+}
+
+void WiFiManager::buildPersistentRecord(PersistentRecord& record) {
+  // Zeroed first so padding and unused entries compare equal byte for byte.
+  memset(&record, 0, sizeof(record));
+  record.version = PERSISTENT_RECORD_VERSION;
+  record.size = sizeof(record);
+  strlcpy(record.lastSsid, _lastSsid, sizeof(record.lastSsid));
+  strlcpy(record.lastPassword, _lastPassword, sizeof(record.lastPassword));
+  if (!_fastConnectSsid.isEmpty() && _fastConnectSsid == _lastSsid) {
+    memcpy(record.lastBssid, _fastConnectBssid, sizeof(record.lastBssid));
+    record.lastChannel = _fastConnectChannel;
+  }
+  record.lease = _lease;
+  record.credentials.version = CREDENTIAL_TABLE_VERSION;
+  record.credentials.count = _credentials.count;
+  record.credentials.sequence = _credentials.sequence;
+  memcpy(record.credentials.entries, _credentials.entries, _credentials.count * sizeof(CredentialEntry));
+}
+
+void WiFiManager::applyPersistentRecord(const PersistentRecord& record) {
+  _credentials = record.credentials;
+  _credentials.version = CREDENTIAL_TABLE_VERSION;
+  strlcpy(_lastSsid, record.lastSsid, sizeof(_lastSsid));
+  strlcpy(_lastPassword, record.lastPassword, sizeof(_lastPassword));
+  _fastConnectSsid = "";
+  _fastConnectChannel = record.lastChannel;
+  if (_fastConnectChannel != 0) {
+    memcpy(_fastConnectBssid, record.lastBssid, sizeof(_fastConnectBssid));
+    _fastConnectSsid = _lastSsid;
+  }
+  _lease = record.lease;
+}
+
+int WiFiManager::findCredential(const String &ssid) const {
+  for (uint8_t i = 0; i < _credentials.count; i++) {
+    if (strcmp(_credentials.entries[i].ssid, ssid.c_str()) == 0) return i;
+  }
+  return -1;
+}
+
+/**
+ * @brief Returns the entry for ssid, creating it (and evicting the
+ *        lowest-ranked entry if the table is full) when needed.
+ */
+WiFiManager::CredentialEntry* WiFiManager::upsertCredential(const String &ssid, const String &password) {
+  if (ssid.isEmpty() || ssid.length() >= sizeof(CredentialEntry::ssid) ||
+      password.length() >= sizeof(CredentialEntry::password)) {
+    return nullptr;
+  }
+  int idx = findCredential(ssid);
+  if (idx < 0) {
+    if (_credentials.count < ALOO_WM_MAX_CREDENTIALS) {
+      idx = _credentials.count++;
+    } else {
+      idx = 0;
+      for (uint8_t i = 1; i < _credentials.count; i++) {
+        if (scoreCredential(_credentials.entries[i], 0) < scoreCredential(_credentials.entries[idx], 0)) idx = i;
+      }
+      ALOO_LOGW(TAG, "Credential table full, evicting %s", _credentials.entries[idx].ssid);
+    }
+    memset(&_credentials.entries[idx], 0, sizeof(CredentialEntry));
+    strlcpy(_credentials.entries[idx].ssid, ssid.c_str(), sizeof(CredentialEntry::ssid));
+  }
+  CredentialEntry& entry = _credentials.entries[idx];
+  if (strcmp(entry.password, password.c_str()) != 0) {
+    // A new password gets a fresh chance.
+    strlcpy(entry.password, password.c_str(), sizeof(CredentialEntry::password));
+    entry.authFailures = 0;
+  }
+  return &entry;
+}
+
+/**
+ * @brief Ranks an entry by signal, history and connect latency.
+ * @param rssi Strongest RSSI seen for the SSID in the last scan, or 0 if unseen.
+ */
+int32_t WiFiManager::scoreCredential(const CredentialEntry &entry, int32_t rssi) const {
+  int32_t score = 0;
+  // Networks in range always outrank those missing from the scan.
+  if (rssi < 0) score += 10000 + constrain(rssi + 100, 0, 100) * 10;
+  uint32_t attempts = (uint32_t)entry.successCount + entry.failCount;
+  score += attempts ? (int32_t)(entry.successCount * 500UL / attempts) : 250;
+  if (entry.lastConnected) {
+    uint32_t age = _credentials.sequence - entry.lastConnected;
+    if (age < 10) score += 300 - (int32_t)age * 30;
+  }
+  score -= entry.avgConnectMs / 20;
+  return score;
+}
+
+/**
+ * @brief Copies the known networks into out, best candidate first, ranked
+ *        against the RSSI values of the last completed scan. A scan older
+ *        than the cache TTL is ignored: the round then ranks by history only.
+ * @param rssi Receives each candidate's strongest RSSI (0 = not in the scan).
+ * @param scanned Set when the cache holds a completed, non-empty scan within
+ *                its TTL, i.e. when a missing network can be taken as out of range.
+ * @return Number of candidates written.
+ */
+size_t WiFiManager::rankCredentials(CredentialEntry* out, int32_t* rssi, bool& scanned) {
+  int32_t scores[ALOO_WM_MAX_CREDENTIALS];
+
+  takeMutex(_credentialsMutex, WiFiMutexId::CREDENTIALS);
+  ensureCredentialTableLoaded();
+  size_t count = _credentials.count;
+  memcpy(out, _credentials.entries, count * sizeof(CredentialEntry));
+  xSemaphoreGive(_credentialsMutex);
+
+  for (size_t i = 0; i < count; i++) rssi[i] = 0;
+  scanned = false;
+  uint32_t ttl = scanCacheTtl();
+  if (takeMutex(_networksMutex, WiFiMutexId::NETWORKS) == pdTRUE) {
+    // A fast round skips the scan refresh, so the cache may be from long ago.
+    scanned = _lastScanAt != 0 && millis() - _lastScanAt < ttl && _scanResultCount > 0;
+    // The pool lists each SSID's strongest BSSID first, so the first match wins.
+    for (size_t n = 0; scanned && n < _scanResultCount; n++) {
+      const WiFiNetwork &net = _scanResults[n];
+      for (size_t i = 0; i < count; i++) {
+        if (rssi[i] == 0 && strcmp(net.ssid, out[i].ssid) == 0) rssi[i] = net.rssi;
+      }
+    }
+    xSemaphoreGive(_networksMutex);
+  }
+
+  takeMutex(_credentialsMutex, WiFiMutexId::CREDENTIALS);
+  for (size_t i = 0; i < count; i++) scores[i] = scoreCredential(out[i], rssi[i]);
+  xSemaphoreGive(_credentialsMutex);
+
+  // Insertion sort, highest score first (the table is tiny).
+  for (size_t i = 1; i < count; i++) {
+    CredentialEntry entry = out[i];
+    int32_t score = scores[i];
+    int32_t level = rssi[i];
+    size_t j = i;
+    for (; j > 0 && scores[j - 1] < score; j--) {
+      out[j] = out[j - 1];
+      scores[j] = scores[j - 1];
+      rssi[j] = rssi[j - 1];
+    }
+    out[j] = entry;
+    scores[j] = score;
+    rssi[j] = level;
+  }
+  return count;
+}
+
+/**
+ * @brief Builds the candidate list for a reconnect round.
+ *
+ * The radio can only associate with one AP at a time, so candidates run in
+ * sequence; the scheduler makes each one cheap instead. It refreshes a stale
+ * scan (unless the fast reconnect cache lets the first candidate skip it), drops
+ * networks the scan did not see, and gives each candidate a first-attempt
+ * timeout derived from its own history rather than the full connect timeout.
+ * @param timeouts Receives the first-attempt timeout per candidate.
+ * @return Number of candidates written to out.
+ */
+size_t WiFiManager::scheduleCandidates(CredentialEntry* out, uint32_t* timeouts) {
+  WiFiRetryPolicy policy = getRetryPolicy();
+  takeMutex(_credentialsMutex, WiFiMutexId::CREDENTIALS);
+  ensureCredentialTableLoaded();
+  bool hasFast = _fastReconnect && !_fastCacheStale && _fastConnectChannel != 0 &&
+                 findCredential(_fastConnectSsid) >= 0;
+  String fastSsid = hasFast ? _fastConnectSsid : String();
+  xSemaphoreGive(_credentialsMutex);
+
+  // A scan within the cache TTL is ranked as it is, even with another scan
+  // in flight; only a stale table is worth waiting for.
+  uint32_t ttl = scanCacheTtl();
+  bool fresh = false;
+  WiFiScanOptions options;
+  if (takeMutex(_networksMutex, WiFiMutexId::NETWORKS) == pdTRUE) {
+    fresh = _lastScanAt != 0 && millis() - _lastScanAt < ttl;
+    options = _scanOptions;
+    xSemaphoreGive(_networksMutex);
+  }
+  if (!hasFast && !fresh && requestScan()) {
+    waitForScan(14 * options.msPerChannel + 2000);
+  }
+
+  int32_t rssi[ALOO_WM_MAX_CREDENTIALS];
+  bool scanned = false;
+  size_t known = rankCredentials(out, rssi, scanned);
+  size_t count = 0;
+  for (size_t i = 0; i < known; i++) {
+    if (out[i].authFailures >= ALOO_WM_AUTH_FAILURE_LIMIT) {
+      // Retrying a rejected password only locks the AP; wait for new credentials.
+      ALOO_LOGW(TAG, "Skipping %s: %u authentication failures.", out[i].ssid, (unsigned)out[i].authFailures);
+      continue;
+    }
+    bool fast = hasFast && fastSsid == out[i].ssid;
+    // A fast candidate is tried first: its attempt needs no scan.
+    if (!fast && policy.skipUnseen && scanned && rssi[i] == 0) {
+      ALOO_LOGD(TAG, "Skipping %s: not in the last scan.", out[i].ssid);
+      continue;
+    }
+    CredentialEntry entry = out[i];
+    uint32_t timeout = _connectTimeout;
+    if (policy.attemptTimeoutFactor && entry.avgConnectMs) {
+      timeout = constrain((uint32_t)entry.avgConnectMs * policy.attemptTimeoutFactor,
+                          policy.minAttemptTimeoutMs, (uint32_t)_connectTimeout);
+    }
+    size_t slot = count++;
+    if (fast) {
+      for (; slot > 0; slot--) {
+        out[slot] = out[slot - 1];
+        timeouts[slot] = timeouts[slot - 1];
+      }
+    }
+    out[slot] = entry;
+    timeouts[slot] = timeout;
+  }
+  ALOO_LOGI(TAG, "%u of %u known networks scheduled%s.", (unsigned)count, (unsigned)known,
+            scanned ? "" : " (no scan results)");
+  return count;
+}
+
+void WiFiManager::recordConnectFailure(const String &ssid, uint8_t reason) {
+  // Statistics only; written with the next flush.
+  takeMutex(_credentialsMutex, WiFiMutexId::CREDENTIALS);
+  int idx = findCredential(ssid);
+  if (idx >= 0) {
+    CredentialEntry& entry = _credentials.entries[idx];
+    if (entry.failCount < UINT16_MAX) entry.failCount++;
+    if (classifyDisconnect(reason) == WiFiDisconnectClass::AUTH && entry.authFailures < UINT8_MAX) {
+      entry.authFailures++;
+    }
+    markStorageDirty(false);
+  }
+  xSemaphoreGive(_credentialsMutex);
+}
+
+bool WiFiManager::addCredentials(const String &ssid, const String &password) {
+  takeMutex(_credentialsMutex, WiFiMutexId::CREDENTIALS);
+  ensureCredentialTableLoaded();
+  bool success = upsertCredential(ssid, password) != nullptr;
+  if (success) markStorageDirty(true);
+  xSemaphoreGive(_credentialsMutex);
+  return success;
+}
+
+bool WiFiManager::removeCredentials(const String &ssid) {
+  takeMutex(_credentialsMutex, WiFiMutexId::CREDENTIALS);
+  ensureCredentialTableLoaded();
+  int idx = findCredential(ssid);
+  bool found = idx >= 0;
+  if (found) {
+    for (uint8_t i = idx; i + 1 < _credentials.count; i++) {
+      _credentials.entries[i] = _credentials.entries[i + 1];
+    }
+    _credentials.count--;
+    // Forget the last network and its fast reconnect cache if they belonged to this network.
+    if (ssid == _lastSsid || ssid == _fastConnectSsid) {
+      _lastSsid[0] = '\0';
+      _lastPassword[0] = '\0';
+      _fastConnectSsid = "";
+      _fastConnectChannel = 0;
+      _lease = IpLease{};
+    }
+    markStorageDirty(true);
+  }
+  xSemaphoreGive(_credentialsMutex);
+  return found;
+}
+
+size_t WiFiManager::getStoredNetworkCount() {
+  takeMutex(_credentialsMutex, WiFiMutexId::CREDENTIALS);
+  ensureCredentialTableLoaded();
+  size_t count = _credentials.count;
+  xSemaphoreGive(_credentialsMutex);
+  return count;
+}
+
+//--------------------------------------------------------------------------
+// AP Mode & Captive Portal Functions
+//--------------------------------------------------------------------------
+
+/**
+ * @brief Claims OS connectivity checks by path before the WebServer has read
+ *        the Host header, then answers them with the prebuilt redirect.
+ */
+class WiFiManager::CaptiveProbeHandler : public RequestHandler {
+public:
+  explicit CaptiveProbeHandler(WiFiManager& manager) : _manager(manager) {}
+
+  bool canHandle(HTTPMethod method, String uri) override {
+    return (method == HTTP_GET || method == HTTP_HEAD) && matchCaptiveProbe(uri);
+  }
+
+  bool handle(WebServer& server, HTTPMethod method, String uri) override {
+    (void)method;
+    _manager.handleRedirect(captiveProbeOs(server.hostHeader(), uri));
+    return true;
+  }
+
+private:
+  WiFiManager& _manager;
+};
+
+void WiFiManager::setupCaptivePortal() {
+  // Redirect the OS connectivity checks, then anything for a foreign host.
+  _server->addHandler(new CaptiveProbeHandler(*this));
+  _server->onNotFound([this]() {
+    if (!isIp(_server->hostHeader())) {
+      handleRedirect(WiFiProbeOs::OTHER);
+    } else {
+      AlooScopedTimer timer(routeMetric(WiFiHttpRoute::NOT_FOUND));
+      _server->send(404, "text/plain", "404: Not Found");
+    }
+  });
 }
 
-void WiFiManager::handleRedirect() {
-  String redirectUrl = "http://" + _server->client().localIP().toString() + "/";
-  _server->sendHeader("Location", redirectUrl);
-  _server->send(302, "text/plain", "Redirecting to setup portal");
+/**
+ * @brief Builds the redirect to the portal once per AP start, so answering a
+ *        probe is a single write of a ready buffer.
+ */
+void WiFiManager::buildCaptiveResponse(const IPAddress& ip) {
+  snprintf(_captiveLocation, sizeof(_captiveLocation), "http://%u.%u.%u.%u/", ip[0], ip[1], ip[2], ip[3]);
+  int length = snprintf(_captiveResponse, sizeof(_captiveResponse),
+                        "HTTP/1.1 302 Found\r\n"
+                        "Location: %s\r\n"
+                        "Cache-Control: no-store\r\n"
+                        "Content-Length: 0\r\n"
+                        "Connection: close\r\n"
+                        "\r\n",
+                        _captiveLocation);
+  _captiveResponseLength = length > 0 && length < (int)sizeof(_captiveResponse) ? (size_t)length : 0;
+}
+
+bool WiFiManager::matchCaptiveProbe(const String& path) {
+  uint32_t hash = captivePathHash(path.c_str());
+  for (const CaptiveProbeRoute& route : captiveProbeRoutes) {
+    if (route.pathHash == hash && strcasecmp(path.c_str(), route.path) == 0) return true;
+  }
+  return false;
+}
+
+WiFiProbeOs WiFiManager::captiveProbeOs(const String& host, const String& path) {
+  uint32_t hash = captiveProbeHash(host.c_str(), path.c_str());
+  for (const CaptiveProbeRoute& route : captiveProbeRoutes) {
+    if (route.hash == hash && strcasecmp(host.c_str(), route.host) == 0 &&
+        strcasecmp(path.c_str(), route.path) == 0) {
+      return route.os;
+    }
+  }
+  return WiFiProbeOs::OTHER;
+}
+
+void WiFiManager::handleRedirect(WiFiProbeOs os) {
+  AlooScopedTimer timer(routeMetric(WiFiHttpRoute::CAPTIVE));
+  _metrics.captiveProbes[(size_t)os].increment();
+  _server->client().write((const uint8_t*)_captiveResponse, _captiveResponseLength);
 }
 
 bool WiFiManager::isIp(const String& str) {
@@ -480,215 +1777,1182 @@ bool WiFiManager::isIp(const String& str) {
 void WiFiManager::startAPMode() {
   // If already in AP mode with an active web server, do nothing.
   if (WiFi.getMode() == WIFI_AP || WiFi.getMode() == WIFI_AP_STA) {
-    if (_server) {
-      Serial.println("WiFiManager: AP mode already active.");
+    if (_portalActive) {
+      ALOO_LOGI(TAG, "AP mode already active.");
       return;
     }
   }
 
-  Serial.println("WiFiManager: Starting AP mode for WiFi setup...");
-  WiFi.disconnect(true);
-  delay(100);
-  // Use AP+STA mode so that WiFi scanning is allowed.
-  WiFi.mode(WIFI_AP_STA);
-  if (_apPassword.length() >= 8) {
-    WiFi.softAP(_apSsid.c_str(), _apPassword.c_str());
-  } else {
-    WiFi.softAP(_apSsid.c_str());
+  ALOO_LOGI(TAG, "Starting AP mode for WiFi setup...");
+  if (!_dualMode) {
+    disconnectStation(true);
+    delay(100);
+  }
+  // Use AP+STA mode so that WiFi scanning is allowed.
+  WiFi.mode(WIFI_AP_STA);
+  uint8_t channel = portalChannel();
+  if (_apPassword.length() >= 8) {
+    WiFi.softAP(_apSsid.c_str(), _apPassword.c_str(), channel);
+  } else {
+    WiFi.softAP(_apSsid.c_str(), nullptr, channel);
+  }
+
+  IPAddress apIP = WiFi.softAPIP();
+  ALOO_LOGI(TAG, "AP IP: %s", apIP.toString().c_str());
+  buildCaptiveResponse(apIP);
+
+  // Answer every DNS query with the AP IP so clients open the portal.
+  if (_captiveDns.start(apIP)) {
+    startTask(WiFiTaskId::DNS, dnsTask);
+  }
+
+#ifdef ALOO_WM_ASYNC_SERVER
+  if (_serverBackend == WiFiServerBackend::ASYNC) {
+    startAsyncServer();
+  }
+#endif
+  if (_serverBackend == WiFiServerBackend::SYNC) {
+    // The server object is created once and reused; only the listener is
+    // restarted on each AP cycle.
+    if (!_server) {
+      _server = createWebServer();
+    }
+    if (!_serverRoutesRegistered) {
+      // Request headers needed for conditional and compressed asset responses.
+      static const char* assetHeaders[] = { "Accept-Encoding", "If-None-Match" };
+      _server->collectHeaders(assetHeaders, 2);
+
+      // Endpoint to return cached WiFi networks as JSON.
+      _server->on("/wifinetworks", [this]() { handleWifiNetworks(); });
+      // Status endpoint to return current status as JSON.
+      _server->on(STATUS_ENDPOINT, [this]() { handleStatus(); });
+      // Metrics in Prometheus text format.
+      _server->on(METRICS_ENDPOINT, HTTP_GET, [this]() { handleMetrics(); });
+      // Endpoint for submitting WiFi credentials.
+      _server->on("/submit", HTTP_POST, [this]() { handleSubmitCredentials(); });
+      // Setup captive portal redirection endpoints.
+      setupCaptivePortal();
+      // Setup default endpoints to serve the portal files. Registered last so a
+      // portal filesystem cannot shadow the endpoints above.
+      setupDefaultEndpoints();
+      _serverRoutesRegistered = true;
+    }
+    _server->begin();
+  }
+  _portalActive = true;
+  _portalClients = 0;
+  _portalIdleSince = millis();
+  accountRadioState();
+
+  // Optionally, run the web server on a separate core (the async backend has
+  // its own task). The task is created on the first AP cycle and parked, not
+  // deleted, between cycles.
+  if (_runServerOnSeparateCore && _serverBackend == WiFiServerBackend::SYNC) {
+    startTask(WiFiTaskId::SERVER, serverTask);
+  }
+
+  // Warm the scan cache so the network list is ready when the portal opens.
+  requestScan();
+}
+
+/**
+ * @brief Channel for the softAP. The radio has one channel, so a softAP on
+ *        another channel than the station is moved (and its clients dropped)
+ *        when the station associates; in dual mode it starts on the station's
+ *        channel, or the cached one while the station is not connected.
+ */
+uint8_t WiFiManager::portalChannel() {
+  if (!_dualMode) return 1;
+  if (stateBit(safeGetStatus()) & ONLINE_STATE_BITS) return WiFi.channel();
+  return _fastConnectChannel ? _fastConnectChannel : 1;
+}
+
+void WiFiManager::stopAPMode() {
+  ALOO_LOGI(TAG, "Stopping AP mode");
+  _portalCloseScheduled = false;
+
+  // Park the server task between two polls before the servers it polls are stopped.
+  if (!parkTask(WiFiTaskId::SERVER, SERVER_PARK_TIMEOUT_MS)) {
+    ALOO_LOGW(TAG, "Server task did not park within %lu ms", (unsigned long)SERVER_PARK_TIMEOUT_MS);
+  }
+
+  if (!parkTask(WiFiTaskId::DNS, SERVER_PARK_TIMEOUT_MS)) {
+    ALOO_LOGW(TAG, "DNS task did not park within %lu ms", (unsigned long)SERVER_PARK_TIMEOUT_MS);
+  }
+  _captiveDns.stop();
+  if (_server && _portalActive) {
+    ALOO_LOGD(TAG, "Stopping web server");
+    _server->stop();
+  }
+#ifdef ALOO_WM_ASYNC_SERVER
+  if (_asyncServer && _portalActive && _serverBackend == WiFiServerBackend::ASYNC) {
+    ALOO_LOGD(TAG, "Stopping async web server");
+    _asyncServer->end();
+  }
+#endif
+  _portalActive = false;
+
+  if (WiFi.getMode() == WIFI_AP || WiFi.getMode() == WIFI_AP_STA) {
+    WiFi.softAPdisconnect(true);
+  }
+  accountRadioState();
+}
+
+//--------------------------------------------------------------------------
+// Web Server HTTP Handlers
+//--------------------------------------------------------------------------
+
+void WiFiManager::handleSubmitCredentials() {
+  AlooScopedTimer timer(routeMetric(WiFiHttpRoute::SUBMIT));
+  if (!_server->hasArg("ssid") || _server->arg("ssid").isEmpty()) {
+    _server->send(400, "text/plain", F("SSID is required"));
+    return;
+  }
+  // Save submitted credentials.
+  setPendingCredentials(_server->arg("ssid"), _server->arg("password"));
+
+  char html[sizeof(connectingHtml) + 64];
+  snprintf_P(html, sizeof(html), connectingHtml,
+             _server->arg("ssid").c_str(), _connectTimeout / 1000);
+  _server->send(200, "text/html", html);
+}
+
+// Flush callback streaming writer output (JSON, metrics) as HTTP chunks.
+static void sendResponseChunk(void* context, const char* data, size_t length) {
+  static_cast<WebServer*>(context)->sendContent(data, length);
+}
+
+void WiFiManager::handleWifiNetworks() {
+  AlooScopedTimer timer(routeMetric(WiFiHttpRoute::NETWORKS));
+  // Serve the cache right away; a stale cache triggers a background refresh.
+  bool scanning = requestScan();
+  uint32_t since = _server->hasArg("since") ? strtoul(_server->arg("since").c_str(), nullptr, 10) : 0;
+  uint32_t generation;
+  bool full;
+  size_t count = snapshotNetworks(since, generation, full);
+
+  _server->setContentLength(CONTENT_LENGTH_UNKNOWN);
+  _server->send(200, "application/json", "");
+  char buffer[256];
+  AlooJsonWriter json(buffer, sizeof(buffer), sendResponseChunk, _server);
+  writeNetworksJson(json, count, scanning, generation, full);
+  json.flush();
+}
+
+void WiFiManager::handleStatus() {
+  AlooScopedTimer timer(routeMetric(WiFiHttpRoute::STATUS));
+  char buffer[96];
+  AlooJsonWriter json(buffer, sizeof(buffer), nullptr, nullptr);
+  writeStatusJson(json);
+  _server->send_P(200, "application/json", json.data(), json.length());
+}
+
+void WiFiManager::handleMetrics() {
+  AlooScopedTimer timer(routeMetric(WiFiHttpRoute::METRICS));
+  _server->setContentLength(CONTENT_LENGTH_UNKNOWN);
+  _server->send(200, "text/plain; version=0.0.4", "");
+  char buffer[512];
+  AlooPrometheusWriter out(buffer, sizeof(buffer), sendResponseChunk, _server);
+  writeMetrics(out);
+  out.flush();
+}
+
+/**
+ * @brief Copies the scan cache changes after generation since into
+ *        _scanBuffers->snapshot under the lock, so the response can be streamed
+ *        without holding _networksMutex.
+ * @param since Generation the client has (0 = none).
+ * @param generation Set to the current generation.
+ * @param full Set when the client needs the whole list: it has none, or its
+ *             generation is older than the horizon or from before a reboot.
+ * @return Number of entries copied.
+ */
+size_t WiFiManager::snapshotNetworks(uint32_t since, uint32_t& generation, bool& full) {
+  size_t count = 0;
+  generation = 0;
+  full = true;
+  if (takeMutex(_networksMutex, WiFiMutexId::NETWORKS) == pdTRUE) {
+    generation = _scanGeneration;
+    full = since == 0 || since < _scanHorizon || since > _scanGeneration;
+    for (const ScanEntry& entry : _scanBuffers->table) {
+      if (entry.generation == 0 || (full ? !entry.present : entry.generation <= since)) continue;
+      NetworkSnapshot& out = _scanBuffers->snapshot[count++];
+      out.net = entry.net;
+      out.present = entry.present;
+    }
+    xSemaphoreGive(_networksMutex);
+  }
+  return count;
+}
+
+// A scanned network as a JSON object (shared by /wifinetworks and the event stream).
+static void writeNetworkJson(AlooJsonWriter& json, const WiFiNetwork& net) {
+  const uint8_t* bssid = net.bssid;
+  char text[18];
+  snprintf(text, sizeof(text), "%02x:%02x:%02x:%02x:%02x:%02x", bssid[0], bssid[1], bssid[2], bssid[3], bssid[4],
+           bssid[5]);
+  json.beginObject();
+  json.key("bssid");
+  json.value(text);
+  json.key("ssid");
+  json.value(net.ssid);
+  json.key("rssi");
+  json.value((int)net.rssi);
+  json.key("channel");
+  json.value((unsigned)net.channel);
+  json.key("auth");
+  json.value((unsigned)net.auth);
+  json.endObject();
+}
+
+static void writeBssidJson(AlooJsonWriter& json, const uint8_t* bssid) {
+  char text[18];
+  snprintf(text, sizeof(text), "%02x:%02x:%02x:%02x:%02x:%02x", bssid[0], bssid[1], bssid[2], bssid[3], bssid[4],
+           bssid[5]);
+  json.value(text);
+}
+
+void WiFiManager::writeNetworksJson(AlooJsonWriter& json, size_t count, bool scanning, uint32_t generation,
+                                    bool full) {
+  json.beginObject();
+  json.key("scanning");
+  json.value(scanning);
+  json.key("generation");
+  json.value((unsigned long)generation);
+  json.key("full");
+  json.value(full);
+  json.key("networks");
+  json.beginArray();
+  for (size_t i = 0; i < count; i++) {
+    if (_scanBuffers->snapshot[i].present) writeNetworkJson(json, _scanBuffers->snapshot[i].net);
+  }
+  json.endArray();
+  json.key("removed");
+  json.beginArray();
+  for (size_t i = 0; i < count; i++) {
+    if (!_scanBuffers->snapshot[i].present) writeBssidJson(json, _scanBuffers->snapshot[i].net.bssid);
+  }
+  json.endArray();
+  json.endObject();
+}
+
+void WiFiManager::writeStatusJson(AlooJsonWriter& json) {
+  WiFiStatus status = safeGetStatus();
+  json.beginObject();
+  json.key("status");
+  json.value(wifiStatusToString(status));
+  // A dual-mode portal outlives GOT_IP; tell the page where the device went.
+  if (stateBit(status) & ONLINE_STATE_BITS) {
+    json.key("ip");
+    json.value(WiFi.localIP().toString().c_str());
+  }
+  json.endObject();
+}
+
+#ifdef ALOO_WM_ASYNC_SERVER
+//--------------------------------------------------------------------------
+// Asynchronous Web Server Backend
+//--------------------------------------------------------------------------
+// Handlers run on the AsyncTCP task, one request at a time, so they share
+// _scanBuffers->snapshot safely. They must not block: every lock they take is
+// held only for a copy.
+
+// Flush callback appending writer output to a response stream.
+static void printResponseChunk(void* context, const char* data, size_t length) {
+  static_cast<Print*>(context)->write(reinterpret_cast<const uint8_t*>(data), length);
+}
+
+void WiFiManager::startAsyncServer() {
+  if (!_asyncServer) {
+#ifdef ALOO_WM_STATIC_ALLOCATION
+    _asyncServer = new (_asyncServerStorage) AsyncWebServer(80);
+#else
+    _asyncServer = new AsyncWebServer(80);
+#endif
+  }
+  // Handlers stay registered across AP cycles; only the listener is restarted.
+  if (!_asyncRoutesRegistered) {
+    setupAsyncEndpoints();
+    _asyncRoutesRegistered = true;
+  }
+  _asyncServer->begin();
+}
+
+/**
+ * @brief Async counterpart of CaptiveProbeHandler. Headers are parsed by the
+ *        time handlers are matched, so the OS is known here already.
+ */
+class WiFiManager::AsyncCaptiveProbeHandler : public AsyncWebHandler {
+public:
+  explicit AsyncCaptiveProbeHandler(WiFiManager& manager) : _manager(manager) {}
+
+  bool canHandle(AsyncWebServerRequest* request) override {
+    return (request->method() == HTTP_GET || request->method() == HTTP_HEAD) && matchCaptiveProbe(request->url());
+  }
+
+  void handleRequest(AsyncWebServerRequest* request) override {
+    _manager.handleRedirect(request, captiveProbeOs(request->host(), request->url()));
+  }
+
+private:
+  WiFiManager& _manager;
+};
+
+void WiFiManager::setupAsyncEndpoints() {
+  _asyncServer->on("/wifinetworks", [this](AsyncWebServerRequest* request) { handleWifiNetworks(request); });
+  _asyncServer->on(STATUS_ENDPOINT, [this](AsyncWebServerRequest* request) { handleStatus(request); });
+  _asyncServer->on(METRICS_ENDPOINT, HTTP_GET, [this](AsyncWebServerRequest* request) { handleMetrics(request); });
+  _asyncServer->on("/submit", HTTP_POST, [this](AsyncWebServerRequest* request) { handleSubmitCredentials(request); });
+  // Scan cache changes pushed as they happen; see pushNetworkChanges().
+  _networkEvents = new AsyncEventSource(NETWORK_EVENTS_ENDPOINT);
+  _asyncServer->addHandler(_networkEvents);
+
+  // Captive portal redirection: OS connectivity checks, then foreign hosts.
+  _asyncServer->addHandler(new AsyncCaptiveProbeHandler(*this));
+  _asyncServer->onNotFound([this](AsyncWebServerRequest* request) {
+    if (!isIp(request->host())) {
+      handleRedirect(request, WiFiProbeOs::OTHER);
+    } else {
+      AlooScopedTimer timer(routeMetric(WiFiHttpRoute::NOT_FOUND));
+      request->send(404, "text/plain", "404: Not Found");
+    }
+  });
+
+  // Portal files, registered last as in setupDefaultEndpoints().
+  if (_portalFs) {
+    _asyncServer->serveStatic("/", *_portalFs, _portalFsRoot.c_str(), _portalFsCacheControl.c_str());
+    return;
+  }
+  for (size_t i = 0; i < _userAssetCount; i++) {
+    const WiFiPortalAsset* asset = &_userAssets[i];
+    _asyncServer->on(asset->path, HTTP_GET, [this, asset](AsyncWebServerRequest* request) {
+      servePortalAsset(request, *asset);
+    });
+  }
+  for (const WiFiPortalAsset& asset : defaultPortalAssets) {
+    const WiFiPortalAsset* entry = &asset;
+    _asyncServer->on(entry->path, HTTP_GET, [this, entry](AsyncWebServerRequest* request) {
+      servePortalAsset(request, *entry);
+    });
+  }
+}
+
+void WiFiManager::servePortalAsset(AsyncWebServerRequest* request, const WiFiPortalAsset& asset) {
+  AlooScopedTimer timer(routeMetric(WiFiHttpRoute::PORTAL));
+  AsyncWebServerResponse* response;
+  if (asset.etag && request->hasHeader("If-None-Match") &&
+      request->getHeader("If-None-Match")->value() == asset.etag) {
+    response = request->beginResponse(304);
+  } else {
+    String acceptEncoding;
+    if (request->hasHeader("Accept-Encoding")) {
+      acceptEncoding = request->getHeader("Accept-Encoding")->value();
+    }
+    if (selectGzip(asset, acceptEncoding)) {
+      response = request->beginResponse_P(200, asset.contentType, asset.gzipData, asset.gzipLength);
+      response->addHeader("Content-Encoding", "gzip");
+    } else {
+      response = request->beginResponse_P(200, asset.contentType, asset.data, asset.length);
+    }
+    if (asset.gzipData && asset.data) {
+      response->addHeader("Vary", "Accept-Encoding");
+    }
+  }
+  if (asset.etag) {
+    response->addHeader("ETag", asset.etag);
+  }
+  char cacheControl[48];
+  formatCacheControl(asset, cacheControl, sizeof(cacheControl));
+  response->addHeader("Cache-Control", cacheControl);
+  request->send(response);
+}
+
+void WiFiManager::handleRedirect(AsyncWebServerRequest* request, WiFiProbeOs os) {
+  AlooScopedTimer timer(routeMetric(WiFiHttpRoute::CAPTIVE));
+  _metrics.captiveProbes[(size_t)os].increment();
+  AsyncWebServerResponse* response = request->beginResponse(302);
+  response->addHeader("Location", _captiveLocation);
+  response->addHeader("Cache-Control", "no-store");
+  request->send(response);
+}
+
+void WiFiManager::handleSubmitCredentials(AsyncWebServerRequest* request) {
+  AlooScopedTimer timer(routeMetric(WiFiHttpRoute::SUBMIT));
+  if (!request->hasArg("ssid") || request->arg("ssid").isEmpty()) {
+    request->send(400, "text/plain", "SSID is required");
+    return;
+  }
+  setPendingCredentials(request->arg("ssid"), request->arg("password"));
+
+  char html[sizeof(connectingHtml) + 64];
+  snprintf_P(html, sizeof(html), connectingHtml,
+             request->arg("ssid").c_str(), _connectTimeout / 1000);
+  request->send(200, "text/html", html);
+}
+
+void WiFiManager::handleWifiNetworks(AsyncWebServerRequest* request) {
+  AlooScopedTimer timer(routeMetric(WiFiHttpRoute::NETWORKS));
+  bool scanning = requestScan();
+  uint32_t since = request->hasArg("since") ? strtoul(request->arg("since").c_str(), nullptr, 10) : 0;
+  uint32_t generation;
+  bool full;
+  size_t count = snapshotNetworks(since, generation, full);
+
+  AsyncResponseStream* response = request->beginResponseStream("application/json");
+  char buffer[256];
+  AlooJsonWriter json(buffer, sizeof(buffer), printResponseChunk, static_cast<Print*>(response));
+  writeNetworksJson(json, count, scanning, generation, full);
+  json.flush();
+  request->send(response);
+}
+
+void WiFiManager::handleStatus(AsyncWebServerRequest* request) {
+  AlooScopedTimer timer(routeMetric(WiFiHttpRoute::STATUS));
+  // The body has to outlive this call, so write it into the response stream.
+  AsyncResponseStream* response = request->beginResponseStream("application/json", 96);
+  char buffer[96];
+  AlooJsonWriter json(buffer, sizeof(buffer), printResponseChunk, static_cast<Print*>(response));
+  writeStatusJson(json);
+  json.flush();
+  request->send(response);
+}
+
+void WiFiManager::handleMetrics(AsyncWebServerRequest* request) {
+  AlooScopedTimer timer(routeMetric(WiFiHttpRoute::METRICS));
+  AsyncResponseStream* response = request->beginResponseStream("text/plain; version=0.0.4", 2048);
+  char buffer[512];
+  AlooPrometheusWriter out(buffer, sizeof(buffer), printResponseChunk, static_cast<Print*>(response));
+  writeMetrics(out);
+  out.flush();
+  request->send(response);
+}
+#endif
+
+//--------------------------------------------------------------------------
+// Kernel Object Allocation
+//--------------------------------------------------------------------------
+
+SemaphoreHandle_t WiFiManager::createMutex(WiFiMutexId id) {
+#ifdef ALOO_WM_STATIC_ALLOCATION
+  return xSemaphoreCreateMutexStatic(&_mutexStorage[(size_t)id]);
+#else
+  return xSemaphoreCreateMutex();
+#endif
+}
+
+/**
+ * @brief Creates one of the manager tasks with its configured stack, priority
+ *        and core (see setTaskConfig()).
+ * @return false (and a logged error) if the task could not be created.
+ */
+bool WiFiManager::createTask(WiFiTaskId id, TaskFunction_t function) {
+  TaskHandle_t* handle = taskHandleSlot(id);
+  if (!handle) return false;
+  const char* name = TASK_NAMES[(size_t)id];
+  WiFiTaskConfig config = _taskConfig[(size_t)id];
+  config.core = taskCore(id);
+
+#ifdef ALOO_WM_STATIC_ALLOCATION
+  StackType_t* const stacks[] = {
+    _managerStack, _serverStack, _monitorStack, _scanStack, _dispatcherStack, _persistStack, _dnsStack,
+    _notifierStack
+  };
+  const uint32_t capacities[] = {
+    sizeof(_managerStack), sizeof(_serverStack), sizeof(_monitorStack), sizeof(_scanStack),
+    sizeof(_dispatcherStack), sizeof(_persistStack), sizeof(_dnsStack), sizeof(_notifierStack)
+  };
+  if (config.stackSize > capacities[(size_t)id]) {
+    ALOO_LOGW(TAG, "%s: stack capped at %lu bytes by its static storage.", name,
+              (unsigned long)capacities[(size_t)id]);
+    config.stackSize = capacities[(size_t)id];
+  }
+  *handle = xTaskCreateStaticPinnedToCore(function, name, config.stackSize, this, config.priority,
+                                          stacks[(size_t)id], &_taskStorage[(size_t)id], config.core);
+#else
+  if (xTaskCreatePinnedToCore(function, name, config.stackSize, this, config.priority,
+                              handle, config.core) != pdPASS) {
+    *handle = nullptr;
+  }
+#endif
+  if (!*handle) {
+    ALOO_LOGE(TAG, "Failed to create %s.", name);
+    return false;
+  }
+  _taskApplied[(size_t)id] = config;
+  return true;
+}
+
+/**
+ * @brief Core a task is created on: its configured core, or the one begin()
+ *        assigned to its group.
+ */
+int WiFiManager::taskCore(WiFiTaskId id) const {
+  int core = _taskConfig[(size_t)id].core;
+  if (core != WiFiTaskConfig::BEGIN_CORE) return core;
+  return (id == WiFiTaskId::SERVER || id == WiFiTaskId::DNS) ? _serverCore : _managerCore;
+}
+
+void WiFiManager::createInternetCheckTimer() {
+  if (_internetCheckTimer) return;
+  TickType_t period = pdMS_TO_TICKS(_monitorTaskDelay);
+  if (period == 0) period = 1;
+#ifdef ALOO_WM_STATIC_ALLOCATION
+  _internetCheckTimer = xTimerCreateStatic("WiFiInetCheck", period, pdFALSE, this,
+                                           internetCheckTimerCallback, &_internetCheckTimerStorage);
+#else
+  _internetCheckTimer = xTimerCreate("WiFiInetCheck", period, pdFALSE, this, internetCheckTimerCallback);
+#endif
+  if (!_internetCheckTimer) {
+    ALOO_LOGE(TAG, "Failed to create internet check timer.");
+  } else if (stateBit(safeGetStatus()) & ONLINE_STATE_BITS) {
+    xEventGroupSetBits(_stateEvents, EVT_MONITOR_DUE);
+  }
+}
+
+// Runs on the timer service task; only wakes the monitor.
+void WiFiManager::internetCheckTimerCallback(TimerHandle_t timer) {
+  WiFiManager* manager = static_cast<WiFiManager*>(pvTimerGetTimerID(timer));
+  if (manager) xEventGroupSetBits(manager->_stateEvents, EVT_MONITOR_DUE);
+}
+
+WebServer* WiFiManager::createWebServer() {
+#ifdef ALOO_WM_STATIC_ALLOCATION
+  return new (_serverStorage) WebServer(80);
+#else
+  return new WebServer(80);
+#endif
+}
+
+void WiFiManager::destroyWebServer() {
+#ifdef ALOO_WM_STATIC_ALLOCATION
+  if (_server) _server->~WebServer();
+#ifdef ALOO_WM_ASYNC_SERVER
+  if (_asyncServer) _asyncServer->~AsyncWebServer();
+#endif
+#else
+  delete _server;
+#ifdef ALOO_WM_ASYNC_SERVER
+  delete _asyncServer;
+#endif
+#endif
+  _server = nullptr;
+#ifdef ALOO_WM_ASYNC_SERVER
+  _asyncServer = nullptr;
+  _networkEvents = nullptr;
+#endif
+}
+
+WiFiManager::ScanBuffers* WiFiManager::createScanBuffers() {
+#ifdef ALOO_WM_STATIC_ALLOCATION
+  return &_scanBuffersStorage;
+#else
+  return new ScanBuffers();
+#endif
+}
+
+//--------------------------------------------------------------------------
+// Task Supervisor
+//--------------------------------------------------------------------------
+// Tasks are never deleted while they run. The supervisor clears a task's run
+// bit (park) or raises EVT_SHUTDOWN (stop) and waits for the task to
+// acknowledge from taskCheckpoint() or taskExit(), where it holds no lock.
+
+TaskHandle_t* WiFiManager::taskHandleSlot(WiFiTaskId id) {
+  switch (id) {
+    case WiFiTaskId::CONNECTION_MANAGER: return &_connectionManagerTaskHandle;
+    case WiFiTaskId::SERVER: return &_serverTaskHandle;
+    case WiFiTaskId::MONITOR: return &_monitorTaskHandle;
+    case WiFiTaskId::SCAN: return &_scanTaskHandle;
+    case WiFiTaskId::DISPATCHER: return &_dispatcherTaskHandle;
+    case WiFiTaskId::PERSIST: return &_persistTaskHandle;
+    case WiFiTaskId::DNS: return &_dnsTaskHandle;
+    case WiFiTaskId::NOTIFIER: return &_notifierTaskHandle;
+    default: return nullptr;
+  }
+}
+
+/**
+ * @brief Creates the task on first use and resumes it if it is parked.
+ */
+bool WiFiManager::startTask(WiFiTaskId id, TaskFunction_t function) {
+  TaskHandle_t* handle = taskHandleSlot(id);
+  if (!handle) return false;
+  if (*handle && (xEventGroupGetBits(_taskEvents) & taskExitedBit(id))) {
+    // Left behind by an end() issued from this very task; it is suspended in taskExit().
+    vTaskDelete(*handle);
+    *handle = nullptr;
+  }
+  if (!*handle) {
+    xEventGroupClearBits(_taskEvents, taskParkedBit(id) | taskExitedBit(id));
+  }
+  resumeTask(id);
+  return *handle || createTask(id, function);
+}
+
+void WiFiManager::resumeTask(WiFiTaskId id) {
+  xEventGroupSetBits(_taskEvents, taskRunBit(id));
+}
+
+/**
+ * @brief Asks a task to park at its next checkpoint and waits until it has.
+ *
+ * Returns at once when called from the task itself; it parks when control
+ * gets back to its loop.
+ * @return false if the task did not park within timeoutMs.
+ */
+bool WiFiManager::parkTask(WiFiTaskId id, uint32_t timeoutMs) {
+  xEventGroupClearBits(_taskEvents, taskRunBit(id));
+  TaskHandle_t handle = taskHandle(id);
+  if (!handle || handle == xTaskGetCurrentTaskHandle()) return true;
+  // Wake a task sleeping on its notification so it reaches the checkpoint.
+  xTaskNotifyGive(handle);
+  return (xEventGroupWaitBits(_taskEvents, taskParkedBit(id), pdFALSE, pdFALSE,
+                              pdMS_TO_TICKS(timeoutMs)) & taskParkedBit(id)) != 0;
+}
+
+/**
+ * @brief Stops every task within timeoutMs.
+ *
+ * EVT_SHUTDOWN is part of every wait in the task loops and parked tasks are
+ * released, so each task reaches taskExit() after at most one step of work
+ * (a scan, an internet check). Tasks that acknowledge are deleted while
+ * suspended there; a task that does not is deleted anyway once the deadline
+ * passes, which is the only case left where a lock may be lost.
+ * @return false if a task had to be deleted without acknowledging.
+ */
+bool WiFiManager::stopTasks(uint32_t timeoutMs) {
+  TaskHandle_t self = xTaskGetCurrentTaskHandle();
+  xEventGroupSetBits(_stateEvents, EVT_SHUTDOWN);
+  xEventGroupSetBits(_taskEvents, ALL_TASK_RUN_BITS);
+  for (size_t i = 0; i < (size_t)WiFiTaskId::COUNT; i++) {
+    TaskHandle_t handle = taskHandle((WiFiTaskId)i);
+    if (handle && handle != self) xTaskNotifyGive(handle);
+  }
+  // The event and notifier tasks block on their queues rather than a notification.
+  WiFiManagerEvent wake = {};
+  wake.type = WiFiManagerEventType::COUNT;
+  xQueueSend(_events.queue, &wake, 0);
+  xQueueSend(_notifications.queue, &wake, 0);
+
+  TickType_t started = xTaskGetTickCount();
+  TickType_t budget = pdMS_TO_TICKS(timeoutMs);
+  bool clean = true;
+  for (size_t i = 0; i < (size_t)WiFiTaskId::COUNT; i++) {
+    WiFiTaskId id = (WiFiTaskId)i;
+    TaskHandle_t* handle = taskHandleSlot(id);
+    if (!*handle) continue;
+    if (*handle == self) {
+      // Cannot wait on ourselves; the task exits at its next checkpoint and
+      // the next begin() reclaims it.
+      ALOO_LOGW(TAG, "end() called from %s; it stops on return.", TASK_NAMES[i]);
+      continue;
+    }
+    TickType_t elapsed = xTaskGetTickCount() - started;
+    TickType_t wait = elapsed < budget ? budget - elapsed : 0;
+    if (!(xEventGroupWaitBits(_taskEvents, taskExitedBit(id), pdFALSE, pdFALSE, wait) & taskExitedBit(id))) {
+      ALOO_LOGE(TAG, "%s did not stop within %lu ms; deleting it.", TASK_NAMES[i], (unsigned long)timeoutMs);
+      clean = false;
+    }
+    vTaskDelete(*handle);
+    *handle = nullptr;
+  }
+  return clean;
+}
+
+/**
+ * @brief Called by a task between units of work. Blocks while the task is
+ *        parked and reports whether it should keep running.
+ * @return false once end() asked the task to stop.
+ */
+bool WiFiManager::taskCheckpoint(WiFiTaskId id) {
+  EventBits_t run = taskRunBit(id);
+  EventBits_t parked = taskParkedBit(id);
+  // The parked bit is only set inside this loop, so a supervisor that sees it
+  // knows the task is not doing work; it is cleared before the run bit is
+  // re-checked so it can never be stale once the task leaves.
+  while (!(xEventGroupGetBits(_taskEvents) & run)) {
+    xEventGroupSetBits(_taskEvents, parked);
+    xEventGroupWaitBits(_taskEvents, run, pdFALSE, pdFALSE, portMAX_DELAY);
+    xEventGroupClearBits(_taskEvents, parked);
+  }
+  return !shutdownRequested();
+}
+
+/**
+ * @brief Acknowledges a stop request and waits to be deleted by stopTasks().
+ */
+void WiFiManager::taskExit(WiFiTaskId id) {
+  ALOO_LOGD(TAG, "%s stopped.", TASK_NAMES[(size_t)id]);
+  xEventGroupSetBits(_taskEvents, taskExitedBit(id));
+  for (;;) {
+    vTaskSuspend(nullptr);
+  }
+}
+
+bool WiFiManager::shutdownRequested() const {
+  return (xEventGroupGetBits(_stateEvents) & EVT_SHUTDOWN) != 0;
+}
+
+// The task that runs scans and receives the driver's scan-done notification.
+TaskHandle_t WiFiManager::scanWorker() const {
+  return _sharedWorker ? _monitorTaskHandle : _scanTaskHandle;
+}
+
+void WiFiManager::setTaskConfig(WiFiTaskId id, const WiFiTaskConfig& config) {
+  if (id >= WiFiTaskId::COUNT) return;
+  _taskConfig[(size_t)id] = config;
+}
+
+WiFiTaskConfig WiFiManager::getTaskConfig(WiFiTaskId id) const {
+  return id < WiFiTaskId::COUNT ? _taskConfig[(size_t)id] : WiFiTaskConfig{};
+}
+
+bool WiFiManager::setSharedWorker(bool enabled) {
+  if (_monitorTaskHandle || _scanTaskHandle) {
+    ALOO_LOGW(TAG, "Shared worker can only change before begin() or after end().");
+    return false;
+  }
+  _sharedWorker = enabled;
+  return true;
+}
+
+void WiFiManager::getTaskStats(WiFiTaskStatsSnapshot& out) {
+  uint32_t now = millis();
+  uint32_t runTime[(size_t)WiFiTaskId::COUNT] = {};
+  uint32_t total = 0;
+#if configUSE_TRACE_FACILITY && configGENERATE_RUN_TIME_STATS
+  total = portGET_RUN_TIME_COUNTER_VALUE();
+  out.cpuAvailable = true;
+#else
+  out.cpuAvailable = false;
+#endif
+  for (size_t i = 0; i < (size_t)WiFiTaskId::COUNT; i++) {
+    WiFiTaskId id = (WiFiTaskId)i;
+    WiFiTaskStats& task = out.tasks[i];
+    TaskHandle_t handle = taskHandle(id);
+    task.running = handle != nullptr;
+    if (handle) {
+      task.priority = uxTaskPriorityGet(handle);
+      task.core = _taskApplied[i].core;
+      task.stackSize = _taskApplied[i].stackSize;
+      task.stackFreeMin = uxTaskGetStackHighWaterMark(handle);
+#if configUSE_TRACE_FACILITY && configGENERATE_RUN_TIME_STATS
+      TaskStatus_t status;
+      vTaskGetInfo(handle, &status, pdFALSE, eInvalid);
+      runTime[i] = status.ulRunTimeCounter;
+#endif
+    } else {
+      task.priority = _taskConfig[i].priority;
+      task.core = taskCore(id);
+      task.stackSize = _taskConfig[i].stackSize;
+      task.stackFreeMin = 0;
+    }
+  }
+
+  portENTER_CRITICAL(&_taskStatsLock);
+  uint32_t elapsed = total - _runTimeTotal;
+  for (size_t i = 0; i < (size_t)WiFiTaskId::COUNT; i++) {
+    // A task created since the previous call starts from zero.
+    uint32_t used = runTime[i] >= _taskRunTime[i] ? runTime[i] - _taskRunTime[i] : runTime[i];
+    uint64_t permille = elapsed ? (uint64_t)used * 1000 / elapsed : 0;
+    out.tasks[i].cpuPermille = (uint16_t)(permille > 1000 ? 1000 : permille);
+    _taskRunTime[i] = runTime[i];
+  }
+  _runTimeTotal = total;
+  out.windowMs = now - _taskStatsAt;
+  _taskStatsAt = now;
+  portEXIT_CRITICAL(&_taskStatsLock);
+}
+
+//--------------------------------------------------------------------------
+// Metrics
+//--------------------------------------------------------------------------
+
+/**
+ * @brief Takes a mutex, recording how long the caller waited for it.
+ *        The uncontended case skips the clock reads.
+ */
+BaseType_t WiFiManager::takeMutex(SemaphoreHandle_t mutex, WiFiMutexId id) {
+  AlooHistogram& waits = _metrics.mutexWaitUs[(size_t)id];
+  if (xSemaphoreTake(mutex, 0) == pdTRUE) {
+    waits.observe(0);
+    return pdTRUE;
+  }
+  unsigned long start = micros();
+  BaseType_t taken = xSemaphoreTake(mutex, portMAX_DELAY);
+  waits.observe(micros() - start);
+  return taken;
+}
+
+TaskHandle_t WiFiManager::taskHandle(WiFiTaskId id) const {
+  switch (id) {
+    case WiFiTaskId::CONNECTION_MANAGER: return _connectionManagerTaskHandle;
+    case WiFiTaskId::SERVER: return _serverTaskHandle;
+    case WiFiTaskId::MONITOR: return _monitorTaskHandle;
+    case WiFiTaskId::SCAN: return _scanTaskHandle;
+    case WiFiTaskId::DISPATCHER: return _dispatcherTaskHandle;
+    case WiFiTaskId::PERSIST: return _persistTaskHandle;
+    case WiFiTaskId::DNS: return _dnsTaskHandle;
+    case WiFiTaskId::NOTIFIER: return _notifierTaskHandle;
+    default: return nullptr;
+  }
+}
+
+void WiFiManager::getMetrics(WiFiMetricsSnapshot& out) {
+  out.connectAttempts = _metrics.connectAttempts.value();
+  out.connectFailures = _metrics.connectFailures.value();
+  out.eventsCoalesced = _metrics.eventsCoalesced.value();
+  out.storageWrites = _metrics.storageWrites.value();
+  out.storageWritesSkipped = _metrics.storageWritesSkipped.value();
+  out.storageWriteFailures = _metrics.storageWriteFailures.value();
+  _metrics.connectDurationMs.snapshot(out.connectDurationMs);
+  _metrics.scanDurationMs.snapshot(out.scanDurationMs);
+  _metrics.probeLatencyMs.snapshot(out.probeLatencyMs);
+  for (size_t i = 0; i < (size_t)WiFiHttpRoute::COUNT; i++) {
+    _metrics.httpDurationUs[i].snapshot(out.httpDurationUs[i]);
+  }
+  for (size_t i = 0; i < (size_t)WiFiMutexId::COUNT; i++) {
+    _metrics.mutexWaitUs[i].snapshot(out.mutexWaitUs[i]);
+  }
+  for (size_t i = 0; i < ALOO_WM_DISCONNECT_REASON_SLOTS; i++) {
+    out.disconnects[i] = _metrics.disconnects[i].value();
+  }
+  for (size_t i = 0; i < (size_t)WiFiDisconnectClass::COUNT; i++) {
+    out.disconnectClasses[i] = _metrics.disconnectClasses[i].value();
+  }
+  for (size_t i = 0; i < (size_t)WiFiRecovery::COUNT; i++) {
+    out.recoveries[i] = _metrics.recoveries[i].value();
+  }
+  for (size_t i = 0; i < (size_t)WiFiTaskId::COUNT; i++) {
+    TaskHandle_t handle = taskHandle((WiFiTaskId)i);
+    out.stackHighWater[i] = handle ? uxTaskGetStackHighWaterMark(handle) : 0;
+  }
+  accountRadioState();
+  portENTER_CRITICAL(&_radioLock);
+  memcpy(out.radioStateMs, _radioStateMs, sizeof(out.radioStateMs));
+  portEXIT_CRITICAL(&_radioLock);
+  out.dns = _captiveDns.stats();
+  for (size_t i = 0; i < (size_t)WiFiProbeOs::COUNT; i++) {
+    out.captiveProbes[i] = _metrics.captiveProbes[i].value();
+  }
+}
+
+void WiFiManager::writeMetrics(AlooPrometheusWriter& out) {
+  out.family("aloo_wifi_connect_attempts_total", "counter", "Connection attempts by result.");
+  out.sample("aloo_wifi_connect_attempts_total", "result=\"success\"",
+             _metrics.connectAttempts.value() - _metrics.connectFailures.value());
+  out.sample("aloo_wifi_connect_attempts_total", "result=\"failure\"", _metrics.connectFailures.value());
+
+  out.family("aloo_wifi_connect_duration_ms", "histogram", "Time from WiFi.begin() to GOT_IP or failure.");
+  out.histogram("aloo_wifi_connect_duration_ms", nullptr, _metrics.connectDurationMs);
+
+  out.family("aloo_wifi_disconnects_total", "counter", "STA disconnects by wifi_err_reason_t.");
+  for (size_t i = 0; i < ALOO_WM_DISCONNECT_REASON_SLOTS; i++) {
+    uint32_t count = _metrics.disconnects[i].value();
+    if (!count) continue;
+    char labels[16];
+    snprintf(labels, sizeof(labels), "reason=\"%u\"", WiFiMetricsSnapshot::disconnectReasonForSlot(i));
+    out.sample("aloo_wifi_disconnects_total", labels, count);
   }
 
-  IPAddress apIP = WiFi.softAPIP();
-  Serial.printf("WiFiManager: AP IP: %s\n", apIP.toString().c_str());
-
-  if (_server) {
-    delete _server;
-    _server = nullptr;
-  }
-  _server = new WebServer(80);
-
-  // Setup default endpoints to serve embedded web files.
-  setupDefaultEndpoints();
-
-  // Endpoint to return cached WiFi networks as JSON.
-  _server->on("/wifinetworks", [this]() { handleWifiNetworks(); });
-  // Status endpoint to return current status as JSON.
-  _server->on(STATUS_ENDPOINT, [this]() {
-    static constexpr char jsonTemplate[] = R"({"status":"%s"})";
-    char response[sizeof(jsonTemplate) + 20];
-    const char* statusStr = [this]() -> const char* {
-      switch(safeGetStatus()) {
-        case WiFiStatus::INITIALIZING: return "INITIALIZING";
-        case WiFiStatus::TRYING_TO_CONNECT: return "TRYING_TO_CONNECT";
-        case WiFiStatus::AP_MODE_ACTIVE: return "AP_MODE_ACTIVE";
-        case WiFiStatus::CONNECTED: return "CONNECTED";
-        case WiFiStatus::DISCONNECTED: return "DISCONNECTED";
-        default: return "UNKNOWN";
-      }
-    }();
-    snprintf_P(response, sizeof(response), jsonTemplate, statusStr);
-    _server->send(200, "application/json", response);
-  });
-  // Endpoint for submitting WiFi credentials.
-  _server->on("/submit", HTTP_POST, [this]() { handleSubmitCredentials(); });
-  // Setup captive portal redirection endpoints.
-  setupCaptivePortal();
-  _server->begin();
-
-  // Optionally, run the web server on a separate core.
-  if (_runServerOnSeparateCore && !_serverTaskHandle) {
-    BaseType_t result = xTaskCreatePinnedToCore(
-      serverTask,
-      "WiFiServerTask",
-      4096,
-      this,
-      1,
-      &_serverTaskHandle,
-      _serverCore
-    );
-    if (result != pdPASS) {
-      Serial.println("WiFiManager: Failed to create server task");
-      _serverTaskHandle = nullptr;
-    }
-  }
-
-  // Create scan task to update available WiFi networks periodically.
-  if (!_scanTaskHandle) {
-    BaseType_t result = xTaskCreatePinnedToCore(
-      scanTask,
-      "WiFiScanTask",
-      4096,
-      this,
-      1,
-      &_scanTaskHandle,
-      _managerCore
-    );
-    if (result != pdPASS) {
-      Serial.println("WiFiManager: Failed to create scan task");
-      _scanTaskHandle = nullptr;
-    }
+  out.family("aloo_wifi_disconnect_class_total", "counter", "STA disconnects by class.");
+  for (size_t i = 0; i < (size_t)WiFiDisconnectClass::COUNT; i++) {
+    out.sample("aloo_wifi_disconnect_class_total", DISCONNECT_CLASS_LABELS[i], _metrics.disconnectClasses[i].value());
+  }
+  out.family("aloo_wifi_recoveries_total", "counter", "Recoveries taken for links lost while online.");
+  for (size_t i = 0; i < (size_t)WiFiRecovery::COUNT; i++) {
+    out.sample("aloo_wifi_recoveries_total", RECOVERY_LABELS[i], _metrics.recoveries[i].value());
   }
-}
 
-void WiFiManager::stopAPMode() {
-  Serial.println("WiFiManager: Stopping AP mode");
+  out.family("aloo_wifi_events_coalesced_total", "counter",
+             "Events merged into a newer event of the same type because a queue was full.");
+  out.sample("aloo_wifi_events_coalesced_total", nullptr, _metrics.eventsCoalesced.value());
+
+  out.family("aloo_wifi_storage_flushes_total", "counter", "Write-behind flushes of the stored record by result.");
+  out.sample("aloo_wifi_storage_flushes_total", "result=\"written\"", _metrics.storageWrites.value());
+  out.sample("aloo_wifi_storage_flushes_total", "result=\"unchanged\"", _metrics.storageWritesSkipped.value());
+  out.sample("aloo_wifi_storage_flushes_total", "result=\"failed\"", _metrics.storageWriteFailures.value());
+
+  uint64_t radioStateMs[(size_t)WiFiRadioState::COUNT];
+  accountRadioState();
+  portENTER_CRITICAL(&_radioLock);
+  memcpy(radioStateMs, _radioStateMs, sizeof(radioStateMs));
+  portEXIT_CRITICAL(&_radioLock);
+  out.family("aloo_wifi_radio_state_seconds_total", "counter", "Time spent in each radio state.");
+  for (size_t i = 0; i < (size_t)WiFiRadioState::COUNT; i++) {
+    out.sample("aloo_wifi_radio_state_seconds_total", RADIO_STATE_LABELS[i], (uint32_t)(radioStateMs[i] / 1000));
+  }
 
-  // Stop the server and scan tasks to prevent resource conflicts.
-  if (_serverTaskHandle) {
-    Serial.printf("[DEBUG] Deleting server task: %p\n", _serverTaskHandle);
-    vTaskDelete(_serverTaskHandle);
-    _serverTaskHandle = nullptr;
+  WiFiCaptiveDnsStats dns = _captiveDns.stats();
+  out.family("aloo_wifi_dns_queries_total", "counter", "Captive DNS queries answered, by query type.");
+  for (size_t i = 0; i < (size_t)WiFiDnsQueryType::COUNT; i++) {
+    out.sample("aloo_wifi_dns_queries_total", DNS_QUERY_LABELS[i], dns.queries[i]);
+  }
+  out.family("aloo_wifi_dns_dropped_total", "counter", "Malformed or unsupported DNS packets dropped.");
+  out.sample("aloo_wifi_dns_dropped_total", nullptr, dns.dropped);
+  out.family("aloo_wifi_dns_queries_per_second", "gauge", "Captive DNS queries answered in the last full second.");
+  out.sample("aloo_wifi_dns_queries_per_second", nullptr, dns.lastSecond);
+  out.family("aloo_wifi_dns_queries_per_second_peak", "gauge", "Highest per-second captive DNS query rate seen.");
+  out.sample("aloo_wifi_dns_queries_per_second_peak", nullptr, dns.peakPerSecond);
+
+  out.family("aloo_wifi_captive_probes_total", "counter", "Requests redirected to the portal, by probing OS.");
+  for (size_t i = 0; i < (size_t)WiFiProbeOs::COUNT; i++) {
+    out.sample("aloo_wifi_captive_probes_total", PROBE_OS_LABELS[i], _metrics.captiveProbes[i].value());
   }
 
-  if (_scanTaskHandle) {
-    Serial.printf("[DEBUG] Deleting scan task: %p\n", _scanTaskHandle);
-    vTaskDelete(_scanTaskHandle);
-    _scanTaskHandle = nullptr;
+  out.family("aloo_wifi_scan_duration_ms", "histogram", "Duration of completed WiFi scans.");
+  out.histogram("aloo_wifi_scan_duration_ms", nullptr, _metrics.scanDurationMs);
+
+  WiFiReachabilityStats reach = _reachability.stats();
+  out.family("aloo_wifi_reachability_state", "gauge", "0 unknown, 1 reachable, 2 captive portal, 3 unreachable.");
+  out.sample("aloo_wifi_reachability_state", nullptr, (uint32_t)reach.state);
+  out.family("aloo_wifi_probe_interval_ms", "gauge", "Current interval between reachability rounds.");
+  out.sample("aloo_wifi_probe_interval_ms", nullptr, reach.intervalMs);
+  out.family("aloo_wifi_probe_window_rounds", "gauge", "Reachability rounds in the rolling window by result.");
+  out.sample("aloo_wifi_probe_window_rounds", "result=\"success\"", reach.windowSuccesses);
+  out.sample("aloo_wifi_probe_window_rounds", "result=\"failure\"", reach.windowRounds - reach.windowSuccesses);
+  out.family("aloo_wifi_probe_latency_ms", "histogram", "Fastest successful probe per reachability round.");
+  out.histogram("aloo_wifi_probe_latency_ms", nullptr, _metrics.probeLatencyMs);
+
+  out.family("aloo_http_request_duration_us", "histogram", "Portal request handling time by route.");
+  for (size_t i = 0; i < (size_t)WiFiHttpRoute::COUNT; i++) {
+    out.histogram("aloo_http_request_duration_us", HTTP_ROUTE_LABELS[i], _metrics.httpDurationUs[i]);
   }
 
-  _dnsServer.stop();
-  if (_server) {
-    Serial.println("WiFiManager: Stopping web server");
-    _server->stop();
-    delete _server;
-    _server = nullptr;
+  out.family("aloo_mutex_wait_us", "histogram", "Time spent waiting to acquire internal mutexes.");
+  for (size_t i = 0; i < (size_t)WiFiMutexId::COUNT; i++) {
+    out.histogram("aloo_mutex_wait_us", MUTEX_LABELS[i], _metrics.mutexWaitUs[i]);
   }
 
-  if (WiFi.getMode() == WIFI_AP || WiFi.getMode() == WIFI_AP_STA) {
-    WiFi.softAPdisconnect(true);
+  out.family("aloo_task_stack_free_bytes", "gauge", "Minimum free stack observed per manager task.");
+  for (size_t i = 0; i < (size_t)WiFiTaskId::COUNT; i++) {
+    TaskHandle_t handle = taskHandle((WiFiTaskId)i);
+    if (handle) out.sample("aloo_task_stack_free_bytes", TASK_LABELS[i], uxTaskGetStackHighWaterMark(handle));
   }
 }
 
 //--------------------------------------------------------------------------
-// Web Server HTTP Handlers
+// Task Functions
 //--------------------------------------------------------------------------
 
-void WiFiManager::handleSubmitCredentials() {
-  if (!_server->hasArg("ssid") || _server->arg("ssid").isEmpty()) {
-    _server->send(400, "text/plain", F("SSID is required"));
-    return;
+/**
+ * @brief Runs up to budget attempts for one network, backing off between them
+ *        according to the retry policy.
+ *
+ * A directed fast-connect attempt does not count against the budget. The
+ * backoff sleep is cut short (and the run abandoned) when new credentials are
+ * submitted through the portal.
+ */
+bool WiFiManager::attemptConnection(const String &ssid, const String &password, const char* type, uint8_t budget,
+                                    uint32_t firstTimeoutMs) {
+  WiFiRetryPolicy policy = getRetryPolicy();
+  bool allowFast = true;
+  for (uint8_t attempt = 0; attempt < budget;) {
+    uint32_t backoff = 0;
+    if (attempt > 0) {
+      backoff = computeBackoff(policy.initialBackoffMs, policy.maxBackoffMs, attempt - 1);
+      if (backoff && (xEventGroupWaitBits(_stateEvents, EVT_CREDENTIALS_PENDING | EVT_SHUTDOWN, pdFALSE, pdFALSE,
+                                          pdMS_TO_TICKS(backoff)) & EVT_CREDENTIALS_PENDING)) {
+        ALOO_LOGI(TAG, "New credentials submitted, abandoning retries.");
+        return false;
+      }
+    }
+    if (shutdownRequested()) return false;
+    ALOO_LOGI(TAG, "Attempt %d to connect with %s credentials: %s", attempt + 1, type, ssid.c_str());
+    // Cleared before the old link is dropped: startConnection() sleeps, and
+    // a failure of the new link inside that window must still be seen.
+    xEventGroupClearBits(_stateEvents, EVT_CONNECT_FAILED | EVT_LINK_DOWN);
+    disconnectStation(false);
+    // Let the dropped link's DISCONNECTED be queued under the old attempt id,
+    // so that handleEvent() discards it instead of failing this attempt.
+    if (_linkPending) {
+      xEventGroupWaitBits(_stateEvents, EVT_LINK_DOWN | EVT_SHUTDOWN, pdFALSE, pdFALSE,
+                          pdMS_TO_TICKS(STALE_DISCONNECT_WAIT_MS));
+    }
+    unsigned long started = millis();
+    bool fast = startConnection(ssid, password, allowFast);
+    allowFast = false;
+    uint32_t timeout = _connectTimeout;
+    if (fast) {
+      timeout = _fastConnectTimeout;
+    } else if (attempt == 0 && firstTimeoutMs) {
+      timeout = firstTimeoutMs;
+    }
+    EventBits_t bits = xEventGroupWaitBits(_stateEvents,
+                                           stateBit(WiFiStatus::CONNECTED) | EVT_CONNECT_FAILED | EVT_SHUTDOWN,
+                                           pdFALSE, pdFALSE, pdMS_TO_TICKS(timeout));
+    if (bits & EVT_SHUTDOWN) return false;
+    bool success = (bits & stateBit(WiFiStatus::CONNECTED)) != 0;
+    uint8_t reason = (!success && (bits & EVT_CONNECT_FAILED)) ? _lastDisconnectReason.load() : 0;
+    _lastAttemptReason = reason;
+    reportAttempt(ssid, type, attempt + 1, millis() - started, backoff, fast, success, reason, timeout);
+    if (success) return true;
+    if (fast) {
+      // Stale BSSID/channel or lease: fall back to a full scan and DHCP.
+      ALOO_LOGW(TAG, "Fast reconnect failed, falling back to full connect.");
+      // RAM only: the stored cache is replaced by the next successful connect,
+      // and a reboot may well find the AP back.
+      takeMutex(_credentialsMutex, WiFiMutexId::CREDENTIALS);
+      _fastCacheStale = true;
+      xSemaphoreGive(_credentialsMutex);
+      continue;
+    }
+    if (isCandidateFatal(reason)) {
+      // Retrying cannot help: the AP is not there or the password is wrong.
+      ALOO_LOGW(TAG, "Abandoning %s (reason %u).", ssid.c_str(), reason);
+      return false;
+    }
+    ALOO_LOGW(TAG, "Attempt %d failed.", attempt + 1);
+    attempt++;
   }
-  // Save submitted credentials.
-  setPendingCredentials(_server->arg("ssid"), _server->arg("password"));
+  return false;
+}
 
-  char html[sizeof(connectingHtml) + 64];
-  snprintf_P(html, sizeof(html), connectingHtml,
-             _server->arg("ssid").c_str(), _connectTimeout / 1000);
-  _server->send(200, "text/html", html);
+/**
+ * @brief Disconnect reasons after which further attempts on the same network
+ *        are pointless until something changes: the AP is gone, or the
+ *        handshake failed (a wrong PSK mostly shows up as reason 15 or 204,
+ *        not as AUTH_FAIL). Shares classifyDisconnect() with the recovery
+ *        table and the authFailures count in recordConnectFailure().
+ */
+bool WiFiManager::isCandidateFatal(uint8_t reason) {
+  WiFiDisconnectClass cls = classifyDisconnect(reason);
+  return cls == WiFiDisconnectClass::AUTH || cls == WiFiDisconnectClass::NOT_FOUND;
 }
 
-void WiFiManager::handleWifiNetworks() {
-  String json = "{ \"networks\": [";
-  if (xSemaphoreTake(_networksMutex, portMAX_DELAY) == pdTRUE) {
-    for (size_t i = 0; i < _cachedNetworks.size(); i++) {
-      json += "{ \"ssid\": \"" + _cachedNetworks[i].ssid + "\", \"rssi\": " + String(_cachedNetworks[i].rssi) + " }";
-      if (i < _cachedNetworks.size() - 1) json += ", ";
-    }
-    xSemaphoreGive(_networksMutex);
+/**
+ * @brief Exponential backoff for the given retry index, capped at maxMs and
+ *        optionally spread with full jitter (uniform in [0, backoff]).
+ */
+uint32_t WiFiManager::computeBackoff(uint32_t initialMs, uint32_t maxMs, uint32_t retryIndex) {
+  WiFiRetryPolicy policy = getRetryPolicy();
+  uint32_t backoff = min(initialMs, maxMs);
+  for (uint32_t i = 0; i < retryIndex && backoff < maxMs; i++) {
+    backoff = (uint32_t)min((float)maxMs, backoff * policy.multiplier);
+  }
+  if (policy.fullJitter && backoff > 0) {
+    backoff = esp_random() % (backoff + 1);
   }
-  json += "] }";
-  _server->send(200, "application/json", json);
+  return backoff;
 }
 
-//--------------------------------------------------------------------------
-// Task Functions
-//--------------------------------------------------------------------------
+void WiFiManager::reportAttempt(const String &ssid, const char* type, uint8_t attempt, uint32_t durationMs,
+                                uint32_t backoffMs, bool fast, bool success, uint8_t reason, uint32_t timeoutMs) {
+  _metrics.connectAttempts.increment();
+  if (!success) _metrics.connectFailures.increment();
+  _metrics.connectDurationMs.observe(durationMs);
+  ALOO_LOGI(TAG, "Attempt %u (%s%s) %s after %lu ms (backoff %lu ms)",
+            attempt, type, fast ? ", fast" : "", success ? "succeeded" : "failed",
+            (unsigned long)durationMs, (unsigned long)backoffMs);
+  if (_attemptCallback) {
+    WiFiConnectAttempt report;
+    report.ssid = ssid.c_str();
+    report.source = type;
+    report.attempt = attempt;
+    report.durationMs = durationMs;
+    report.backoffMs = backoffMs;
+    report.fast = fast;
+    report.success = success;
+    report.reason = reason;
+    report.timeoutMs = timeoutMs;
+    _attemptCallback(report);
+  }
+}
 
 /**
  * @brief Persistent connection manager task.
  *
- * This task continuously monitors the connection status. If not connected
- * (and not in a NO_INTERNET state), it checks for pending credentials first,
- * then attempts stored credentials (only once per disconnection). The actual
- * connection attempt is done via a helper lambda that calls tryConnect() and
- * waits (non-blocking) for a notification from the WiFi event callback.
+ * This task sleeps on the state event group. While online it waits for an
+ * offline state bit; while offline it checks for pending credentials first,
+ * then tries the known networks in ranked order (once per disconnection, or
+ * again after the policy's round delay), and then waits for new credentials,
+ * the next state transition or the next round. Each network gets its own
+ * attempt budget from the retry policy, see attemptConnection(). Every wait
+ * also wakes on EVT_SHUTDOWN, so end() stops the task between attempts.
  */
 void WiFiManager::connectionManagerTask(void* param) {
   WiFiManager* manager = static_cast<WiFiManager*>(param);
   bool attemptedStored = false;
-  static const int MAX_RETRIES = 5;
-  // Helper lambda for attempting a connection.
-  auto attemptConnection = [manager](const String &ssid, const String &password, const char* type) -> bool {
-    for (int attempt = 0; attempt < MAX_RETRIES; attempt++) {
-      Serial.printf("WiFiManager: Attempt %d to connect with %s credentials: %s\n", attempt + 1, type, ssid.c_str());
-      // Ensure autoReconnect is enabled.
-      WiFi.disconnect(false, false);
-      manager->tryConnect(ssid, password);
-      xTaskNotifyStateClear(NULL);
-      if (xTaskNotifyWait(0, 0, NULL, pdMS_TO_TICKS(manager->_connectTimeout)) == pdTRUE) {
-        if (manager->safeGetStatus() == WiFiStatus::CONNECTED)
-          return true;
-      }
-      vTaskDelay(pdMS_TO_TICKS(100));
-      Serial.printf("WiFiManager: Attempt %d failed.\n", attempt + 1);
-    }
-    return false;
-  };
+  uint32_t failedRounds = 0;
+  bool roundScheduled = false;
+  unsigned long nextRoundAt = 0;
 
   manager->resetWiFi();
+  manager->applyPowerSettings();
 
-  for (;;) {
-    // If already connected (or in NO_INTERNET state), reset flag.
-    if (manager->safeGetStatus() == WiFiStatus::CONNECTED ||
-        manager->safeGetStatus() == WiFiStatus::NO_INTERNET) {
+  while (manager->taskCheckpoint(WiFiTaskId::CONNECTION_MANAGER)) {
+    // If already connected (or in NO_INTERNET state), reset flags and sleep
+    // until the link drops.
+    WiFiStatus status = manager->safeGetStatus();
+    if (status == WiFiStatus::CONNECTED || status == WiFiStatus::NO_INTERNET) {
       attemptedStored = false;
-      vTaskDelay(pdMS_TO_TICKS(manager->_managerTaskDelay));
+      failedRounds = 0;
+      roundScheduled = false;
+      // A dual-mode portal closes once its grace window after GOT_IP is over.
+      TickType_t wait = portMAX_DELAY;
+      if (manager->_portalCloseScheduled) {
+        long remaining = (long)(manager->_portalCloseAt - millis());
+        if (remaining <= 0) {
+          manager->stopAPMode();
+          manager->applyStationPowerSave();
+          continue;
+        }
+        wait = pdMS_TO_TICKS(remaining);
+      }
+      LeaseDhcp leaseDhcp = manager->_leaseDhcp.load();
+      if (leaseDhcp == LeaseDhcp::RENEWING || leaseDhcp == LeaseDhcp::BOUND) {
+        TickType_t poll = pdMS_TO_TICKS(leaseDhcp == LeaseDhcp::RENEWING ? LEASE_BIND_POLL_MS : LEASE_WATCH_POLL_MS);
+        if (poll < wait) wait = poll;
+      }
+      EventBits_t bits = xEventGroupWaitBits(manager->_stateEvents, OFFLINE_STATE_BITS | EVT_SHUTDOWN, pdFALSE,
+                                             pdFALSE, wait);
+      if (!(bits & (OFFLINE_STATE_BITS | EVT_SHUTDOWN))) manager->checkLeaseRenewal();
+      // A BACKOFF recovery holds off the round instead of opening the portal.
+      uint32_t recoveryDelayMs = manager->_recoveryDelayMs.exchange(0);
+      if (recoveryDelayMs) {
+        ALOO_LOGI(TAG, "Reconnecting in %lu ms.", (unsigned long)recoveryDelayMs);
+        attemptedStored = true;
+        roundScheduled = true;
+        nextRoundAt = millis() + recoveryDelayMs;
+      }
       continue;
     }
+    WiFiRetryPolicy policy = manager->getRetryPolicy();
     // Try pending credentials first.
     String newSsid, newPassword;
     if (manager->fetchPendingCredentials(newSsid, newPassword)) {
-      if (!attemptConnection(newSsid, newPassword, "pending")) {
-        Serial.println("WiFiManager: Pending credentials connection failed.");
+      if (!manager->attemptConnection(newSsid, newPassword, "pending", policy.pendingAttempts)) {
+        ALOO_LOGW(TAG, "Pending credentials connection failed.");
         manager->ensureAPModeActive();
       }
     }
-    // Otherwise, try stored credentials if not yet attempted.
+    // Otherwise, try the known networks in ranked order if not yet attempted.
     else if (!attemptedStored) {
-      String storedSsid, storedPassword;
-      if (manager->loadLastCredentials(storedSsid, storedPassword)) {
-        if (!attemptConnection(storedSsid, storedPassword, "stored")) {
-          Serial.println("WiFiManager: Stored credentials connection failed.");
+      CredentialEntry candidates[ALOO_WM_MAX_CREDENTIALS];
+      uint32_t timeouts[ALOO_WM_MAX_CREDENTIALS];
+      size_t count = manager->scheduleCandidates(candidates, timeouts);
+      // Known networks that are all out of range count as a failed round.
+      if (count > 0 || manager->getStoredNetworkCount() > 0) {
+        bool connected = false;
+        for (size_t i = 0; i < count && !connected; i++) {
+          // Credentials submitted through the portal take priority.
+          if (xEventGroupGetBits(manager->_stateEvents) & (EVT_CREDENTIALS_PENDING | EVT_SHUTDOWN)) break;
+          String storedSsid(candidates[i].ssid);
+          connected = manager->attemptConnection(storedSsid, String(candidates[i].password), "stored",
+                                                 policy.storedAttempts, timeouts[i]);
+          if (!connected) manager->recordConnectFailure(storedSsid, manager->_lastAttemptReason);
+        }
+        if (!connected) {
+          ALOO_LOGW(TAG, "Stored credentials connection failed.");
           manager->ensureAPModeActive();
+          // Schedule another pass so devices recover once the AP is back,
+          // spread out so a fleet does not retry in lockstep.
+          if (policy.roundRetryMs) {
+            uint32_t delayMs = manager->computeBackoff(policy.roundRetryMs, policy.maxRoundRetryMs, failedRounds++);
+            ALOO_LOGI(TAG, "Next reconnect round in %lu ms.", (unsigned long)delayMs);
+            nextRoundAt = millis() + delayMs;
+            roundScheduled = true;
+          }
         }
         attemptedStored = true;
       } else {
@@ -696,90 +2960,487 @@ void WiFiManager::connectionManagerTask(void* param) {
         manager->ensureAPModeActive();
       }
     }
-    vTaskDelay(pdMS_TO_TICKS(manager->_managerTaskDelay));
+    // Nothing left to try: sleep until credentials arrive, the state moves,
+    // or the next reconnect round is due.
+    TickType_t wait = portMAX_DELAY;
+    if (roundScheduled) {
+      long remaining = (long)(nextRoundAt - millis());
+      if (remaining <= 0) {
+        roundScheduled = false;
+        attemptedStored = false;
+        continue;
+      }
+      wait = pdMS_TO_TICKS(remaining);
+    }
+    // EVT_SHUTDOWN must survive the wait, so the wake-up bits are cleared separately.
+    xEventGroupWaitBits(manager->_stateEvents, EVT_CREDENTIALS_PENDING | EVT_STATE_CHANGED | EVT_SHUTDOWN,
+                        pdFALSE, pdFALSE, wait);
+    xEventGroupClearBits(manager->_stateEvents, EVT_CREDENTIALS_PENDING | EVT_STATE_CHANGED);
   }
+  manager->taskExit(WiFiTaskId::CONNECTION_MANAGER);
 }
 
+/**
+ * @brief Polls the portal servers while the portal is up.
+ *
+ * stopAPMode() parks the task, which happens between two polls, so the
+ * servers are never stopped underneath a request.
+ */
 void WiFiManager::serverTask(void* param) {
   WiFiManager* manager = static_cast<WiFiManager*>(param);
-  for (;;) {
-    if (manager->_server) {
-      manager->_server->handleClient();
-      manager->_dnsServer.processNextRequest();
+  while (manager->taskCheckpoint(WiFiTaskId::SERVER)) {
+    if (manager->_server) manager->_server->handleClient();
+
+    // Nobody can reach the portal without joining the AP, so stop polling
+    // until a client associates (handleEvent() resumes the task).
+    uint32_t idleMs = manager->_portalIdleMs;
+    if (idleMs && manager->_portalClients == 0 && millis() - manager->_portalIdleSince >= idleMs) {
+      ALOO_LOGI(TAG, "No portal client for %lu ms; parking the server task.", (unsigned long)idleMs);
+      manager->parkTask(WiFiTaskId::SERVER, 0);
+      // A client that joined after the check must not find the server parked.
+      if (manager->_portalClients != 0) manager->resumeTask(WiFiTaskId::SERVER);
+      continue;
     }
     vTaskDelay(pdMS_TO_TICKS(manager->_serverTaskDelay));
   }
+  manager->taskExit(WiFiTaskId::SERVER);
 }
 
+/**
+ * @brief Answers captive DNS queries while the portal is up. Each pass blocks
+ *        on the socket for at most DNS_WAIT_MS and then drains the queue.
+ */
+void WiFiManager::dnsTask(void* param) {
+  WiFiManager* manager = static_cast<WiFiManager*>(param);
+  while (manager->taskCheckpoint(WiFiTaskId::DNS)) {
+    manager->_captiveDns.serve(DNS_WAIT_MS);
+  }
+  manager->taskExit(WiFiTaskId::DNS);
+}
+
+/**
+ * @brief Runs a reachability round each time EVT_MONITOR_DUE is raised
+ *        (link-up or the internet check timer). With a shared worker it also
+ *        serves scan requests, see setSharedWorker().
+ */
 void WiFiManager::monitorTask(void* param) {
   WiFiManager* manager = static_cast<WiFiManager*>(param);
+  EventBits_t scanBits = manager->_sharedWorker ? EVT_SCAN_REQUESTED : 0;
   for (;;) {
-    Serial.printf("WiFiManager monitorTask: Current status: %s\n", manager->wifiStatusToString(manager->safeGetStatus()));
-    // Only monitor internet connectivity.
-    if (manager->safeGetStatus() == WiFiStatus::CONNECTED && !manager->hasInternetAccess()) {
-      manager->updateStatus(WiFiStatus::NO_INTERNET);
-    }
-    if (manager->safeGetStatus() == WiFiStatus::NO_INTERNET && manager->hasInternetAccess()) {
-      Serial.println("WiFiManager: Internet access restored.");
-      manager->updateStatus(WiFiStatus::CONNECTED);
-    }
-    vTaskDelay(pdMS_TO_TICKS(manager->_monitorTaskDelay));
+    TickType_t wait = scanBits ? manager->scanIdleWait() : portMAX_DELAY;
+    EventBits_t bits = xEventGroupWaitBits(manager->_stateEvents, EVT_MONITOR_DUE | scanBits | EVT_SHUTDOWN,
+                                           pdFALSE, pdFALSE, wait);
+    // Cleared before the round, so a wake-up during the round is not lost.
+    if (bits & EVT_MONITOR_DUE) xEventGroupClearBits(manager->_stateEvents, EVT_MONITOR_DUE);
+    if (!manager->taskCheckpoint(WiFiTaskId::MONITOR)) break;
+    if (scanBits && !(bits & (EVT_MONITOR_DUE | scanBits))) manager->requestScan();
+    if (scanBits && (xEventGroupGetBits(manager->_stateEvents) & EVT_SCAN_REQUESTED)) manager->runScan();
+    if (bits & EVT_MONITOR_DUE) manager->runReachabilityRound();
+  }
+  if (scanBits) xEventGroupSetBits(manager->_stateEvents, EVT_SCAN_IDLE);
+  manager->taskExit(WiFiTaskId::MONITOR);
+}
+
+/**
+ * @brief Runs one reachability round and re-arms the internet check timer
+ *        with the prober's next interval. Probes are non-blocking and run
+ *        concurrently, so a round takes at most probeTimeoutMs.
+ */
+void WiFiManager::runReachabilityRound() {
+  if (!(stateBit(safeGetStatus()) & ONLINE_STATE_BITS)) return;
+
+  uint32_t latencyMs = 0;
+  WiFiReachability reachability = _reachability.runRound(WiFi.dnsIP(), latencyMs);
+  if (reachability == WiFiReachability::REACHABLE) _metrics.probeLatencyMs.observe(latencyMs);
+
+  WiFiStatus status = safeGetStatus();
+  ALOO_LOGD(TAG, "Current status: %s, reachability %u", wifiStatusToString(status), (unsigned)reachability);
+  if (status == WiFiStatus::NO_INTERNET && reachability == WiFiReachability::REACHABLE) {
+    ALOO_LOGI(TAG, "Internet access restored.");
+    updateStatus(WiFiStatus::CONNECTED);
+  } else if (status == WiFiStatus::CONNECTED && (reachability == WiFiReachability::UNREACHABLE ||
+                                                 reachability == WiFiReachability::CAPTIVE)) {
+    ALOO_LOGW(TAG, "Internet access lost%s.", reachability == WiFiReachability::CAPTIVE ? " (captive portal)" : "");
+    updateStatus(WiFiStatus::NO_INTERNET);
+  }
+
+  if (_internetCheckTimer && (stateBit(safeGetStatus()) & ONLINE_STATE_BITS)) {
+    TickType_t period = pdMS_TO_TICKS(_reachability.nextIntervalMs());
+    xTimerChangePeriod(_internetCheckTimer, period ? period : 1, 0);
   }
 }
 
+/**
+ * @brief Demand-driven scan task.
+ *
+ * Sleeps until requestScan() raises EVT_SCAN_REQUESTED, runs one scan (or one
+ * channel sweep) and goes back to sleep. Requests arriving while a scan runs
+ * only re-raise the bit, so they coalesce into at most one follow-up scan.
+ */
 void WiFiManager::scanTask(void* param) {
   WiFiManager* manager = static_cast<WiFiManager*>(param);
   for (;;) {
-    // Use WiFi mutex to prevent concurrent operations.
-    xSemaphoreTake(manager->_wifiMutex, portMAX_DELAY);
-    Serial.println("[WM] Starting WiFi scan...");
-    int ret = WiFi.scanNetworks(true);
-    if(ret == WIFI_SCAN_RUNNING) {
-      Serial.println("[WM] Scan initiated asynchronously.");
-    }
-    // Clear any previous notifications.
-    xTaskNotifyStateClear(NULL);
-    // Wait for scan completion notification from the WiFi event handler,
-    // with a timeout of 10 seconds.
-    BaseType_t notifyResult = xTaskNotifyWait(0, 0, NULL, pdMS_TO_TICKS(10000));
-    if (notifyResult == pdTRUE) {
-       Serial.println("[WM] Scan notification received.");
-    } else {
-       Serial.println("[WM] Scan notification timeout.");
-    }
-    int n = WiFi.scanComplete();
-    Serial.printf("[WM] WiFi scan complete, found %d networks.\n", n);
-    if(n >= 0) {
-      std::vector<WiFiNetwork> tempNetworks;
-      for (int i = 0; i < n; i++) {
-        WiFiNetwork net;
-        net.ssid = WiFi.SSID(i);
-        net.rssi = WiFi.RSSI(i);
-        tempNetworks.push_back(net);
+    EventBits_t bits = xEventGroupWaitBits(manager->_stateEvents, EVT_SCAN_REQUESTED | EVT_SHUTDOWN, pdFALSE, pdFALSE,
+                                           manager->scanIdleWait());
+    if (!(bits & (EVT_SCAN_REQUESTED | EVT_SHUTDOWN)) && !manager->requestScan()) continue;
+    if (!manager->taskCheckpoint(WiFiTaskId::SCAN)) break;
+    manager->runScan();
+  }
+  // Release waitForScan() callers.
+  xEventGroupSetBits(manager->_stateEvents, EVT_SCAN_IDLE);
+  manager->taskExit(WiFiTaskId::SCAN);
+}
+
+// While pages follow the event stream, the scan worker wakes on the cache TTL
+// to keep their list fresh; otherwise it sleeps until a request.
+TickType_t WiFiManager::scanIdleWait() {
+  return hasNetworkListeners() ? pdMS_TO_TICKS(scanCacheTtl()) : portMAX_DELAY;
+}
+
+/**
+ * @brief Serves the pending scan request on the calling worker.
+ */
+void WiFiManager::runScan() {
+  xEventGroupClearBits(_stateEvents, EVT_SCAN_REQUESTED);
+  _radioScanning = true;
+  accountRadioState();
+  performScan();
+  _radioScanning = false;
+  accountRadioState();
+  if (takeMutex(_networksMutex, WiFiMutexId::NETWORKS) == pdTRUE) {
+    if (!(xEventGroupGetBits(_stateEvents) & EVT_SCAN_REQUESTED)) {
+      xEventGroupSetBits(_stateEvents, EVT_SCAN_IDLE);
+    }
+    xSemaphoreGive(_networksMutex);
+  }
+}
+
+/**
+ * @brief Orders a scan pool by SSID group: groups by their strongest BSSID,
+ *        strongest first, and each group's BSSIDs by RSSI. Hidden networks
+ *        are not grouped. The pool is small, so both passes are in place.
+ */
+static void groupBySsid(WiFiNetwork* pool, size_t count) {
+  for (size_t i = 1; i < count; i++) {
+    WiFiNetwork net = pool[i];
+    size_t j = i;
+    for (; j > 0 && pool[j - 1].rssi < net.rssi; j--) pool[j] = pool[j - 1];
+    pool[j] = net;
+  }
+  for (size_t i = 0; i < count; i++) {
+    if (!pool[i].ssid[0]) continue;
+    for (size_t j = i + 1; j < count; j++) {
+      if (strcmp(pool[j].ssid, pool[i].ssid) != 0) continue;
+      // Pull the match up behind its group; the rest keep their order.
+      WiFiNetwork net = pool[j];
+      memmove(&pool[i + 2], &pool[i + 1], (j - i - 1) * sizeof(WiFiNetwork));
+      pool[++i] = net;
+    }
+  }
+}
+
+void WiFiManager::performScan() {
+  WiFiScanOptions options;
+  if (takeMutex(_networksMutex, WiFiMutexId::NETWORKS) == pdTRUE) {
+    options = _scanOptions;
+    xSemaphoreGive(_networksMutex);
+  }
+  unsigned long started = millis();
+  size_t count = 0;
+
+  if (!options.incremental || options.channel != 0) {
+    if (!scanChannel(options, options.channel, count)) {
+      ALOO_LOGW(TAG, "Scan failed or no networks found.");
+      return;
+    }
+    if (applyScanResults(_scanStaging, count, options.channel)) pushNetworkChanges();
+  } else {
+    // Incremental sweep: merge one channel at a time so readers see partial
+    // results after the first channel instead of after the sweep.
+    for (uint8_t channel = 1; channel <= 13 && !shutdownRequested(); channel++) {
+      size_t first = count;
+      if (!scanChannel(options, channel, count)) continue;
+      if (applyScanResults(_scanStaging + first, count - first, channel)) pushNetworkChanges();
+    }
+  }
+
+  groupBySsid(_scanStaging, count);
+  if (takeMutex(_networksMutex, WiFiMutexId::NETWORKS) == pdTRUE) {
+    WiFiNetwork* published = _scanResults;
+    _scanResults = _scanStaging;
+    _scanResultCount = count;
+    _scanStaging = published;
+    _lastScanAt = millis();
+    xSemaphoreGive(_networksMutex);
+  }
+  _metrics.scanDurationMs.observe(millis() - started);
+  ALOO_LOGD(TAG, "WiFi scan complete in %lu ms.", millis() - started);
+}
+
+/**
+ * @brief Merges one scan into the BSSID-keyed cache.
+ *
+ * Unknown BSSIDs are added; known ones are updated when their SSID, channel
+ * or auth mode changed or their RSSI moved by ALOO_WM_RSSI_UPDATE_DB or more.
+ * Entries on the scanned channel(s) that the scan did not report become
+ * tombstones. All changes carry the next generation, which becomes current
+ * only if something changed, so an unchanged scan costs the portal nothing.
+ * When the table is full, the oldest tombstone is reused (or the weakest
+ * network evicted) and the horizon moves up so older pollers get a full list.
+ * @param channel Channel that was scanned (0 = all channels).
+ * @return true if the cache changed.
+ */
+bool WiFiManager::applyScanResults(const WiFiNetwork* results, size_t count, uint8_t channel) {
+  if (takeMutex(_networksMutex, WiFiMutexId::NETWORKS) != pdTRUE) return false;
+  uint32_t next = _scanGeneration + 1;
+  uint32_t now = millis();
+  bool seen[ALOO_WM_MAX_NETWORKS] = {};
+  bool changed = false;
+
+  for (size_t n = 0; n < count; n++) {
+    const WiFiNetwork& net = results[n];
+    ScanEntry* entry = nullptr;
+    ScanEntry* freeSlot = nullptr;
+    ScanEntry* oldestTombstone = nullptr;
+    ScanEntry* weakest = nullptr;
+    for (ScanEntry& candidate : _scanBuffers->table) {
+      if (candidate.generation == 0) {
+        if (!freeSlot) freeSlot = &candidate;
+      } else if (memcmp(candidate.net.bssid, net.bssid, sizeof(net.bssid)) == 0) {
+        entry = &candidate;
+        break;
+      } else if (!candidate.present) {
+        if (!oldestTombstone || candidate.generation < oldestTombstone->generation) oldestTombstone = &candidate;
+      } else if (!weakest || candidate.net.rssi < weakest->net.rssi) {
+        weakest = &candidate;
       }
-      if(xSemaphoreTake(manager->_networksMutex, portMAX_DELAY) == pdTRUE) {
-        manager->_cachedNetworks = tempNetworks;
-        xSemaphoreGive(manager->_networksMutex);
+    }
+    bool added = !entry || !entry->present;
+    if (!entry) {
+      if (freeSlot) {
+        entry = freeSlot;
+      } else if (oldestTombstone) {
+        _scanHorizon = max(_scanHorizon, oldestTombstone->generation);
+        entry = oldestTombstone;
+      } else if (weakest && weakest->net.rssi < net.rssi) {
+        // The evicted network's removal is not recorded.
+        _scanHorizon = next;
+        entry = weakest;
+      } else {
+        continue;
+      }
+    }
+    seen[entry - _scanBuffers->table] = true;
+    entry->lastSeen = now;
+    int delta = net.rssi - entry->net.rssi;
+    if (added || strcmp(entry->net.ssid, net.ssid) != 0 || entry->net.channel != net.channel ||
+        entry->net.auth != net.auth || delta >= ALOO_WM_RSSI_UPDATE_DB || -delta >= ALOO_WM_RSSI_UPDATE_DB) {
+      entry->net = net;
+      entry->present = true;
+      entry->generation = next;
+      changed = true;
+    }
+  }
+
+  for (size_t i = 0; i < ALOO_WM_MAX_NETWORKS; i++) {
+    ScanEntry& entry = _scanBuffers->table[i];
+    if (!entry.present || seen[i] || (channel && entry.net.channel != channel)) continue;
+    entry.present = false;
+    entry.generation = next;
+    changed = true;
+  }
+  if (changed) _scanGeneration = next;
+  xSemaphoreGive(_networksMutex);
+  return changed;
+}
+
+/**
+ * @brief Pushes the scan cache changes since the last push to the portal's
+ *        event stream. Runs on the scan task; the async backend only.
+ */
+void WiFiManager::pushNetworkChanges() {
+#ifdef ALOO_WM_ASYNC_SERVER
+  if (!_networkEvents) return;
+  uint32_t since = _pushedGeneration;
+  uint32_t generation = since;
+  size_t length = 0;
+  bool resync = false;
+  if (takeMutex(_networksMutex, WiFiMutexId::NETWORKS) == pdTRUE) {
+    generation = _scanGeneration;
+    resync = since < _scanHorizon;
+    if (generation != since && !resync && _networkEvents->count()) {
+      // One byte is kept for the terminator; a full buffer means truncation.
+      AlooJsonWriter json(_scanBuffers->networkEvent, sizeof(_scanBuffers->networkEvent) - 1, nullptr, nullptr);
+      json.beginObject();
+      json.key("generation");
+      json.value((unsigned long)generation);
+      json.key("since");
+      json.value((unsigned long)since);
+      json.key("networks");
+      json.beginArray();
+      for (const ScanEntry& entry : _scanBuffers->table) {
+        if (entry.present && entry.generation > since) writeNetworkJson(json, entry.net);
       }
+      json.endArray();
+      json.key("removed");
+      json.beginArray();
+      for (const ScanEntry& entry : _scanBuffers->table) {
+        if (!entry.present && entry.generation > since) writeBssidJson(json, entry.net.bssid);
+      }
+      json.endArray();
+      json.endObject();
+      length = json.length();
+      resync = length >= sizeof(_scanBuffers->networkEvent) - 1;
+    }
+    xSemaphoreGive(_networksMutex);
+  }
+  _pushedGeneration = generation;
+  if (generation == since || !_networkEvents->count()) return;
+  if (resync) {
+    // Too much changed for one event: clients fetch the list instead.
+    length = snprintf(_scanBuffers->networkEvent, sizeof(_scanBuffers->networkEvent), "{\"generation\":%lu,\"resync\":true}",
+                      (unsigned long)generation);
+  }
+  _scanBuffers->networkEvent[length] = '\0';
+  _networkEvents->send(_scanBuffers->networkEvent, "networks", generation);
+#endif
+}
+
+/**
+ * @brief Runs one asynchronous scan and appends its results to _scanStaging.
+ *
+ * _wifiMutex is held only while the scan is started and while the results
+ * are read out, so connection attempts are not blocked for the scan duration.
+ * Records are read straight from the driver's AP records; the SSID/RSSI
+ * getters would build a String per BSSID. When the pool is full, a stronger
+ * BSSID replaces the weakest one of this scan.
+ * @param channel Channel to scan (0 = all channels).
+ * @param count Records in _scanStaging; advanced by the records added.
+ */
+bool WiFiManager::scanChannel(const WiFiScanOptions& options, uint8_t channel, size_t& count) {
+  // Clear any previous notifications.
+  xTaskNotifyStateClear(NULL);
+  takeMutex(_wifiMutex, WiFiMutexId::WIFI);
+  int16_t ret = WiFi.scanNetworks(true, options.showHidden, options.passive, options.msPerChannel, channel);
+  xSemaphoreGive(_wifiMutex);
+  if (ret == WIFI_SCAN_FAILED) return false;
+
+  // Wait for scan completion notification from the WiFi event handler.
+  uint32_t timeout = (channel ? 1 : 14) * options.msPerChannel + 2000;
+  if (xTaskNotifyWait(0, 0, NULL, pdMS_TO_TICKS(timeout)) != pdTRUE) {
+    ALOO_LOGW(TAG, "Scan notification timeout.");
+  }
+
+  takeMutex(_wifiMutex, WiFiMutexId::WIFI);
+  int16_t n = WiFi.scanComplete();
+  size_t first = count;
+  for (int16_t i = 0; i < n; i++) {
+    const wifi_ap_record_t* record = static_cast<const wifi_ap_record_t*>(WiFi.getScanInfoByIndex(i));
+    if (!record) continue;
+    WiFiNetwork* net = nullptr;
+    if (count < ALOO_WM_MAX_NETWORKS) {
+      net = &_scanStaging[count++];
     } else {
-      Serial.println("[WM] Scan failed or no networks found.");
+      // Only this scan's records are replaced: earlier channels of a sweep
+      // have already been merged.
+      WiFiNetwork* weakest = nullptr;
+      for (size_t k = first; k < count; k++) {
+        if (!weakest || _scanStaging[k].rssi < weakest->rssi) weakest = &_scanStaging[k];
+      }
+      if (!weakest || weakest->rssi >= record->rssi) continue;
+      net = weakest;
+    }
+    memcpy(net->ssid, record->ssid, sizeof(net->ssid) - 1);
+    net->ssid[sizeof(net->ssid) - 1] = '\0';
+    memcpy(net->bssid, record->bssid, sizeof(net->bssid));
+    net->channel = record->primary;
+    net->auth = (uint8_t)record->authmode;
+    net->rssi = record->rssi;
+  }
+  WiFi.scanDelete();
+  xSemaphoreGive(_wifiMutex);
+  return n >= 0;
+}
+
+bool WiFiManager::hasNetworkListeners() const {
+#ifdef ALOO_WM_ASYNC_SERVER
+  return _networkEvents && _networkEvents->count() > 0;
+#else
+  return false;
+#endif
+}
+
+bool WiFiManager::requestScan(bool force) {
+  if (!scanWorker()) return false;
+  bool queued = false;
+  uint32_t ttl = scanCacheTtl();
+  if (takeMutex(_networksMutex, WiFiMutexId::NETWORKS) == pdTRUE) {
+    bool running = !(xEventGroupGetBits(_stateEvents) & EVT_SCAN_IDLE);
+    bool fresh = _lastScanAt != 0 && millis() - _lastScanAt < ttl;
+    if (running) {
+      queued = true;  // Coalesce onto the scan in flight.
+    } else if (force || !fresh) {
+      xEventGroupClearBits(_stateEvents, EVT_SCAN_IDLE);
+      xEventGroupSetBits(_stateEvents, EVT_SCAN_REQUESTED);
+      queued = true;
     }
-    WiFi.scanDelete();
-    xSemaphoreGive(manager->_wifiMutex);
-    vTaskDelay(pdMS_TO_TICKS(manager->_scanTaskDelay));
+    xSemaphoreGive(_networksMutex);
+  }
+  return queued;
+}
+
+bool WiFiManager::waitForScan(uint32_t timeoutMs) {
+  return (xEventGroupWaitBits(_stateEvents, EVT_SCAN_IDLE, pdFALSE, pdFALSE,
+                              pdMS_TO_TICKS(timeoutMs)) & EVT_SCAN_IDLE) != 0;
+}
+
+void WiFiManager::setScanOptions(const WiFiScanOptions& options) {
+  if (takeMutex(_networksMutex, WiFiMutexId::NETWORKS) == pdTRUE) {
+    _scanOptions = options;
+    if (_scanOptions.msPerChannel == 0) _scanOptions.msPerChannel = 300;
+    if (_scanOptions.channel > 13) _scanOptions.channel = 0;
+    xSemaphoreGive(_networksMutex);
+  }
+}
+
+void WiFiManager::setScanCacheTtl(uint32_t ttlMs) {
+  if (takeMutex(_networksMutex, WiFiMutexId::NETWORKS) == pdTRUE) {
+    _scanCacheTtl = ttlMs;
+    xSemaphoreGive(_networksMutex);
   }
 }
 
-bool WiFiManager::hasInternetAccess() {
-  if (WiFi.status() != WL_CONNECTED) return false;
-  WiFiClient client;
-  bool connected = client.connect(IPAddress(1, 1, 1, 1), 80, 3000);
-  client.stop();
-  return connected;
+/**
+ * @brief Write-behind task: sleeps until the earliest pending deadline set by
+ *        markStorageDirty(), then flushes. end() performs the final flush
+ *        once every task has stopped.
+ */
+void WiFiManager::persistTask(void* param) {
+  WiFiManager* manager = static_cast<WiFiManager*>(param);
+  while (manager->taskCheckpoint(WiFiTaskId::PERSIST)) {
+    TickType_t wait = portMAX_DELAY;
+    manager->takeMutex(manager->_credentialsMutex, WiFiMutexId::CREDENTIALS);
+    if (manager->_storageDirty) {
+      int32_t remaining = (int32_t)(manager->_flushDueAt - xTaskGetTickCount());
+      wait = remaining > 0 ? (TickType_t)remaining : 0;
+    }
+    xSemaphoreGive(manager->_credentialsMutex);
+    if (wait == 0) {
+      manager->flushStorage();
+      continue;
+    }
+    // Woken early by new changes (which may bring the deadline forward) and by end().
+    ulTaskNotifyTake(pdTRUE, wait);
+  }
+  manager->taskExit(WiFiTaskId::PERSIST);
 }
 
 void WiFiManager::ensureAPModeActive() {
-  if (safeGetStatus() != WiFiStatus::AP_MODE_ACTIVE || WiFi.getMode() != WIFI_AP_STA || !_server) {
+  // No new portal while end() is winding the tasks down.
+  if (shutdownRequested()) return;
+  // A portal kept open after GOT_IP stays open now.
+  _portalCloseScheduled = false;
+  if (safeGetStatus() != WiFiStatus::AP_MODE_ACTIVE || WiFi.getMode() != WIFI_AP_STA || !_portalActive) {
     startAPMode();
     updateStatus(WiFiStatus::AP_MODE_ACTIVE);
   }
@@ -798,65 +3459,294 @@ const char* WiFiManager::wifiStatusToString(WiFiStatus status) {
 }
 
 //--------------------------------------------------------------------------
-// Event-based WiFi Event Handler
+// Event-based WiFi Event Handler and Dispatcher
 //--------------------------------------------------------------------------
 
+/**
+ * @brief Runs on the system event task, which every WiFi/LwIP consumer on the
+ *        device shares. It only copies the event into the queue; the manager's
+ *        event task does the work (see handleEvent()).
+ */
 void WiFiManager::wifiEventHandler(WiFiEvent_t event, WiFiEventInfo_t info) {
   if (!_instance) return;
 
+  WiFiManagerEvent record = {};
   switch (event) {
     case ARDUINO_EVENT_WIFI_STA_GOT_IP:
-      Serial.printf("WiFiManager Callback: Got IP on SSID %s\n", WiFi.SSID().c_str());
-      _instance->updateStatus(WiFiStatus::CONNECTED);
-      _instance->saveLastCredentials(_instance->_currentSsid, _instance->_currentPassword);
-      _instance->stopAPMode();
-      // Notify the connection manager of success.
-      if (_instance->_connectionManagerTaskHandle) {
-          xTaskNotifyGive(_instance->_connectionManagerTaskHandle);
+      record.type = WiFiManagerEventType::GOT_IP;
+      record.ip = info.got_ip.ip_info.ip.addr;
+      break;
+    case ARDUINO_EVENT_WIFI_STA_DISCONNECTED:
+      record.type = WiFiManagerEventType::DISCONNECTED;
+      record.reason = info.wifi_sta_disconnected.reason;
+      record.attempt = _instance->_attemptId;
+      break;
+    case ARDUINO_EVENT_WIFI_STA_CONNECTED:
+      record.type = WiFiManagerEventType::STA_CONNECTED;
+      record.channel = info.wifi_sta_connected.channel;
+      memcpy(record.mac, info.wifi_sta_connected.bssid, sizeof(record.mac));
+      break;
+    case ARDUINO_EVENT_WIFI_AP_STACONNECTED:
+      record.type = WiFiManagerEventType::AP_CLIENT_CONNECTED;
+      memcpy(record.mac, info.wifi_ap_staconnected.mac, sizeof(record.mac));
+      break;
+    case ARDUINO_EVENT_WIFI_AP_STADISCONNECTED:
+      record.type = WiFiManagerEventType::AP_CLIENT_DISCONNECTED;
+      memcpy(record.mac, info.wifi_ap_stadisconnected.mac, sizeof(record.mac));
+      break;
+    case ARDUINO_EVENT_WIFI_SCAN_DONE:
+      record.type = WiFiManagerEventType::SCAN_DONE;
+      break;
+    default:
+      return;
+  }
+  _instance->postEvent(_instance->_events, record);
+  if (record.type == WiFiManagerEventType::DISCONNECTED) {
+    _instance->_linkPending = false;
+    xEventGroupSetBits(_instance->_stateEvents, EVT_LINK_DOWN);
+  }
+}
+
+/**
+ * @brief Stamps and queues an event without blocking (see queueEvent()).
+ */
+bool WiFiManager::postEvent(EventChannel& channel, WiFiManagerEvent& event) {
+  event.timestampMs = millis();
+  return queueEvent(channel, event);
+}
+
+/**
+ * @brief Queues an event without blocking. No event is lost: when the queue
+ *        is full, or events are already latched, the event replaces the
+ *        latched one of its type, which only drops intermediate states.
+ * @return false if the event was latched instead of queued.
+ */
+bool WiFiManager::queueEvent(EventChannel& channel, const WiFiManagerEvent& event) {
+  if (!channel.queue) return false;
+  // Once an event is latched, newer ones latch too so they stay behind it.
+  if (!channel.latchedMask && xQueueSend(channel.queue, &event, 0) == pdTRUE) return true;
+
+  uint32_t bit = wifiManagerEventMask(event.type);
+  WiFiManagerEvent& slot = channel.latched[(size_t)event.type];
+  portENTER_CRITICAL(&_eventLock);
+  bool merged = channel.latchedMask & bit;
+  WiFiStatus previous = slot.previous;
+  slot = event;
+  // A merged status change still reports where the skipped ones started.
+  if (merged && event.type == WiFiManagerEventType::STATUS_CHANGED) slot.previous = previous;
+  channel.latchedMask |= bit;
+  portEXIT_CRITICAL(&_eventLock);
+  if (merged) _metrics.eventsCoalesced.increment();
+
+  // The consumer may have drained the queue in the meantime; a full queue
+  // means it is busy and takes the latch after the queued events.
+  WiFiManagerEvent wake = {};
+  wake.type = WiFiManagerEventType::COUNT;
+  xQueueSend(channel.queue, &wake, 0);
+  return false;
+}
+
+/**
+ * @brief Waits for the next event: queued events first, then the latched
+ *        ones, oldest first. A record typed COUNT is only a wake-up.
+ */
+bool WiFiManager::takeEvent(EventChannel& channel, WiFiManagerEvent& event) {
+  if (xQueueReceive(channel.queue, &event, 0) == pdTRUE) return true;
+  if (takeLatchedEvent(channel, event)) return true;
+  return xQueueReceive(channel.queue, &event, portMAX_DELAY) == pdTRUE;
+}
+
+bool WiFiManager::takeLatchedEvent(EventChannel& channel, WiFiManagerEvent& event) {
+  bool found = false;
+  portENTER_CRITICAL(&_eventLock);
+  size_t oldest = 0;
+  for (size_t i = 0; i < (size_t)WiFiManagerEventType::COUNT; i++) {
+    if (!(channel.latchedMask & (1u << i))) continue;
+    if (!found || (int32_t)(channel.latched[i].timestampMs - channel.latched[oldest].timestampMs) < 0) oldest = i;
+    found = true;
+  }
+  if (found) {
+    event = channel.latched[oldest];
+    channel.latchedMask &= ~(1u << oldest);
+  }
+  portEXIT_CRITICAL(&_eventLock);
+  return found;
+}
+
+/**
+ * @brief Handles WiFi events in order, then passes each one to the notifier
+ *        task, so subscriber callbacks never delay a transition.
+ */
+void WiFiManager::eventDispatcherTask(void* param) {
+  WiFiManager* manager = static_cast<WiFiManager*>(param);
+  WiFiManagerEvent event;
+  while (manager->taskCheckpoint(WiFiTaskId::DISPATCHER)) {
+    if (!manager->takeEvent(manager->_events, event)) continue;
+    if (event.type >= WiFiManagerEventType::COUNT) continue;  // Wake-up
+    manager->handleEvent(event);
+    manager->queueEvent(manager->_notifications, event);
+  }
+  manager->taskExit(WiFiTaskId::DISPATCHER);
+}
+
+/**
+ * @brief Delivers handled events and status changes to the subscribers.
+ */
+void WiFiManager::notifierTask(void* param) {
+  WiFiManager* manager = static_cast<WiFiManager*>(param);
+  WiFiManagerEvent event;
+  while (manager->taskCheckpoint(WiFiTaskId::NOTIFIER)) {
+    if (!manager->takeEvent(manager->_notifications, event)) continue;
+    if (event.type >= WiFiManagerEventType::COUNT) continue;  // Wake-up
+    manager->publishEvent(event);
+  }
+  manager->taskExit(WiFiTaskId::NOTIFIER);
+}
+
+void WiFiManager::handleEvent(const WiFiManagerEvent& event) {
+  switch (event.type) {
+    case WiFiManagerEventType::GOT_IP:
+      ALOO_LOGI(TAG, "Got IP %s on SSID %s", IPAddress(event.ip).toString().c_str(), WiFi.SSID().c_str());
+      if (_leaseDhcp.load() == LeaseDhcp::HANDOVER && (stateBit(safeGetStatus()) & ONLINE_STATE_BITS)) {
+        // esp_netif's DHCP took over on a live link; only the lease changed.
+        _leaseDhcp = LeaseDhcp::OFF;
+        takeMutex(_credentialsMutex, WiFiMutexId::CREDENTIALS);
+        recordLease();
+        markStorageDirty(false);
+        xSemaphoreGive(_credentialsMutex);
+        break;
       }
+      // Scheduled before the status changes, so the connection manager sees
+      // the deadline when it starts its online wait.
+      if (_dualMode && _portalActive) {
+        _portalCloseAt = millis() + _portalGraceMs;
+        _portalCloseScheduled = _portalGraceMs != 0;
+      }
+      // A disconnect that never produced its event must not swallow the next one.
+      _expectingDisconnect = false;
+      updateStatus(WiFiStatus::CONNECTED);
+      saveLastCredentials(_currentSsid, _currentPassword);
+      _recoveryRetries = 0;
+      // Online on the cached address: let DHCP renew it in the background so
+      // the lease cannot outlive the server's grant.
+      if (_usingStaticLease) startLeaseRenewal();
+      if (_dualMode && _portalActive) {
+        ALOO_LOGI(TAG, "Keeping the portal up on channel %u.", WiFi.channel());
+        break;
+      }
+      stopAPMode();
+      // Modem sleep only takes effect once the softAP is down.
+      applyStationPowerSave();
       break;
 
-    case ARDUINO_EVENT_WIFI_STA_DISCONNECTED: {
-      uint8_t reason = info.wifi_sta_disconnected.reason;
-      Serial.printf("WiFiManager Callback: Disconnected from STA (reason %d)\n", reason);
-      if (reason == WIFI_REASON_AUTH_FAIL || reason == WIFI_REASON_AUTH_EXPIRE) {
-        Serial.println("WiFiManager Callback: Authentication failed. Disabling auto-reconnect.");
-        // WiFi.setAutoReconnect(false);
+    case WiFiManagerEventType::DISCONNECTED:
+      ALOO_LOGI(TAG, "Disconnected from STA (reason %d)", event.reason);
+      _metrics.disconnects[WiFiMetricsSnapshot::disconnectReasonSlot(event.reason)].increment();
+      _metrics.disconnectClasses[(size_t)classifyDisconnect(event.reason)].increment();
+      if (event.attempt != _attemptId) {
+        // The end of a link an earlier attempt owned, reported after the
+        // current attempt started.
+        ALOO_LOGD(TAG, "Ignoring the disconnect of attempt %u.", (unsigned)event.attempt);
+        _expectingDisconnect = false;
+        break;
       }
-      // Notify the connection manager immediately so that waiting attempts wake up.
-      if (_instance->_connectionManagerTaskHandle) {
-          xTaskNotifyGive(_instance->_connectionManagerTaskHandle);
+      _lastDisconnectReason = event.reason;
+      _leaseDhcp = LeaseDhcp::OFF;
+      // Flag the failure so that waiting attempts wake up. A failed attempt
+      // is handled by attemptConnection(); only a link lost while online
+      // needs a recovery here.
+      xEventGroupSetBits(_stateEvents, EVT_CONNECT_FAILED);
+      if (_expectingDisconnect.exchange(false)) {
+        ALOO_LOGD(TAG, "Disconnect was requested by the manager.");
+      } else if (stateBit(safeGetStatus()) & ONLINE_STATE_BITS) {
+        recoverFromDisconnect(event.reason);
       }
-      if (_instance->safeGetStatus() != WiFiStatus::AP_MODE_ACTIVE) {
-        if (_instance->_autoLaunchAP) {
-          Serial.println("WiFiManager: Switching to AP mode.");
-          _instance->ensureAPModeActive();
-        } else {
-          _instance->updateStatus(WiFiStatus::DISCONNECTED);
-        }
+      break;
+
+    case WiFiManagerEventType::STA_CONNECTED:
+      ALOO_LOGD(TAG, "STA Connected (channel %u)", event.channel);
+      break;
+    case WiFiManagerEventType::AP_CLIENT_CONNECTED:
+      ALOO_LOGD(TAG, "AP STA Connected");
+      _portalClients = WiFi.softAPgetStationNum();
+      if (_portalActive && _runServerOnSeparateCore) resumeTask(WiFiTaskId::SERVER);
+      break;
+    case WiFiManagerEventType::AP_CLIENT_DISCONNECTED:
+      ALOO_LOGD(TAG, "AP STA Disconnected");
+      _portalClients = WiFi.softAPgetStationNum();
+      if (_portalClients == 0) _portalIdleSince = millis();
+      break;
+    case WiFiManagerEventType::SCAN_DONE:
+      ALOO_LOGD(TAG, "Scan Done");
+      // Notify the scanning task that the scan is complete.
+      if (scanWorker()) {
+        xTaskNotifyGive(scanWorker());
       }
       break;
-    }
-    case ARDUINO_EVENT_WIFI_STA_CONNECTED:
-      Serial.println("WiFiManager Callback: STA Connected");
+    default:
       break;
-    case ARDUINO_EVENT_WIFI_AP_STACONNECTED:
-      Serial.println("WiFiManager Callback: AP STA Connected");
+  }
+}
+
+/**
+ * @brief Applies the configured recovery for a link lost while online.
+ *
+ * Every strategy except PORTAL leaves the reconnect to the connection
+ * manager, which tries the cached BSSID first when fast reconnect is on.
+ */
+void WiFiManager::recoverFromDisconnect(uint8_t reason) {
+  WiFiDisconnectClass cls = classifyDisconnect(reason);
+  takeMutex(_connectionMutex, WiFiMutexId::CONNECTION);
+  WiFiRecovery recovery = _recovery[(size_t)cls];
+  WiFiRetryPolicy policy = _retryPolicy;
+  xSemaphoreGive(_connectionMutex);
+  _metrics.recoveries[(size_t)recovery].increment();
+
+  switch (recovery) {
+    case WiFiRecovery::NONE:
       break;
-    case ARDUINO_EVENT_WIFI_AP_STADISCONNECTED:
-      Serial.println("WiFiManager Callback: AP STA Disconnected");
+    case WiFiRecovery::BACKOFF:
+      _recoveryDelayMs = computeBackoff(policy.initialBackoffMs, policy.maxBackoffMs, _recoveryRetries++);
+      updateStatus(WiFiStatus::DISCONNECTED);
       break;
-    case ARDUINO_EVENT_WIFI_AP_STAIPASSIGNED:
-      Serial.println("WiFiManager Callback: AP STA IP Assigned");
+    case WiFiRecovery::MARK_BAD:
+      recordConnectFailure(_currentSsid, reason);
+      updateStatus(WiFiStatus::DISCONNECTED);
       break;
-    case ARDUINO_EVENT_WIFI_SCAN_DONE:
-      Serial.println("WiFiManager Callback: Scan Done");
-      // Notify scan task that scan is complete.
-      if (_instance->_scanTaskHandle) {
-          xTaskNotifyGive(_instance->_scanTaskHandle);
+    case WiFiRecovery::PORTAL:
+      if (_autoLaunchAP) {
+        ALOO_LOGI(TAG, "Switching to AP mode.");
+        ensureAPModeActive();
+        break;
       }
+      updateStatus(WiFiStatus::DISCONNECTED);
       break;
+    case WiFiRecovery::REASSOCIATE:
     default:
+      updateStatus(WiFiStatus::DISCONNECTED);
       break;
   }
 }
+
+/**
+ * @brief Drops the station link on the manager's own behalf. A live link is
+ *        flagged first, so its DISCONNECTED event skips the recovery; without
+ *        a link no event follows and nothing is flagged.
+ */
+void WiFiManager::disconnectStation(bool wifiOff, bool eraseAp) {
+  if (stateBit(safeGetStatus()) & ONLINE_STATE_BITS) _expectingDisconnect = true;
+  WiFi.disconnect(wifiOff, eraseAp);
+}
+
+void WiFiManager::publishEvent(const WiFiManagerEvent& event) {
+  uint32_t bit = wifiManagerEventMask(event.type);
+  takeMutex(_subscribersMutex, WiFiMutexId::SUBSCRIBERS);
+  for (Subscriber& subscriber : _subscribers) {
+    if (subscriber.callback && (subscriber.mask & bit)) subscriber.callback(event);
+  }
+  // Free slots unsubscribed from within a callback.
+  for (Subscriber& subscriber : _subscribers) {
+    if (subscriber.callback && !subscriber.mask) subscriber.callback = nullptr;
+  }
+  xSemaphoreGive(_subscribersMutex);
+}
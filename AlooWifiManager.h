@@ -4,13 +4,119 @@
 #include <Arduino.h>
 #include <WiFi.h>
 #include <WebServer.h>
-#include <DNSServer.h>
 #include <Preferences.h>
-#include <vector>
+#include <atomic>
+#include <functional>
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
 #include "freertos/semphr.h"
 #include "freertos/timers.h"
+#include "freertos/event_groups.h"
+#include "freertos/queue.h"
+#include "AlooMetrics.h"
+#include "AlooReachability.h"
+#include "AlooCaptiveDns.h"
+#ifdef ALOO_WM_ASYNC_SERVER
+#include <ESPAsyncWebServer.h>
+#endif
+
+class AlooJsonWriter;
+
+// Upper bound on networks listed by /wifinetworks.
+#ifndef ALOO_WM_MAX_NETWORKS
+#define ALOO_WM_MAX_NETWORKS 64
+#endif
+
+// RSSI change (dB) that counts as an update of a scanned network; smaller
+// swings between scans are not reported to the portal.
+#ifndef ALOO_WM_RSSI_UPDATE_DB
+#define ALOO_WM_RSSI_UPDATE_DB 4
+#endif
+
+// Largest network diff pushed as one server-sent event (async backend); a
+// bigger diff is announced as a resync instead.
+#ifndef ALOO_WM_NETWORK_EVENT_SIZE
+#define ALOO_WM_NETWORK_EVENT_SIZE 1024
+#endif
+
+// Earliest time() accepted as wall-clock time (2023-11-14). Until SNTP (or an
+// external RTC) sets the clock, time() runs on the ESP32's RTC timer, which
+// only a power-on reset clears; a lease stamped on that clock is trusted only
+// while RTC memory shows the timer kept running since.
+#ifndef ALOO_WM_MIN_VALID_EPOCH
+#define ALOO_WM_MIN_VALID_EPOCH 1700000000UL
+#endif
+
+// Disconnect reason slots: codes 0..63 map directly, 200..231 (ESP-IDF
+// specific reasons) map to 64..95.
+#define ALOO_WM_DISCONNECT_REASON_SLOTS 96
+
+// Task stack sizes in bytes. Tune them against the high-water marks reported
+// as aloo_task_stack_free_bytes on /metrics.
+#ifndef ALOO_WM_MANAGER_STACK_SIZE
+#define ALOO_WM_MANAGER_STACK_SIZE 8192
+#endif
+#ifndef ALOO_WM_SERVER_STACK_SIZE
+#define ALOO_WM_SERVER_STACK_SIZE 4096
+#endif
+#ifndef ALOO_WM_MONITOR_STACK_SIZE
+#define ALOO_WM_MONITOR_STACK_SIZE 4096
+#endif
+#ifndef ALOO_WM_SCAN_STACK_SIZE
+#define ALOO_WM_SCAN_STACK_SIZE 4096
+#endif
+#ifndef ALOO_WM_DISPATCHER_STACK_SIZE
+#define ALOO_WM_DISPATCHER_STACK_SIZE 4096
+#endif
+#ifndef ALOO_WM_PERSIST_STACK_SIZE
+#define ALOO_WM_PERSIST_STACK_SIZE 4096
+#endif
+#ifndef ALOO_WM_DNS_STACK_SIZE
+#define ALOO_WM_DNS_STACK_SIZE 3072
+#endif
+#ifndef ALOO_WM_NOTIFIER_STACK_SIZE
+#define ALOO_WM_NOTIFIER_STACK_SIZE 4096
+#endif
+
+// Write-behind delays for the stored record. Credential changes are written
+// after the short delay so a burst of edits costs one write; connection
+// statistics, the fast reconnect cache and the lease only ride along, or are
+// written after the long delay at the latest.
+#ifndef ALOO_WM_PERSIST_DELAY_MS
+#define ALOO_WM_PERSIST_DELAY_MS 2000
+#endif
+#ifndef ALOO_WM_PERSIST_STATS_DELAY_MS
+#define ALOO_WM_PERSIST_STATS_DELAY_MS 1800000
+#endif
+
+// WiFi/IP events buffered between the system event task and the manager's
+// event task, events buffered for the subscribers' notifier task, and the
+// number of subscribe() slots.
+#ifndef ALOO_WM_EVENT_QUEUE_LENGTH
+#define ALOO_WM_EVENT_QUEUE_LENGTH 16
+#endif
+#ifndef ALOO_WM_NOTIFY_QUEUE_LENGTH
+#define ALOO_WM_NOTIFY_QUEUE_LENGTH 16
+#endif
+#ifndef ALOO_WM_MAX_SUBSCRIBERS
+#define ALOO_WM_MAX_SUBSCRIBERS 4
+#endif
+
+// Define ALOO_WM_STATIC_ALLOCATION to keep every task stack, kernel object and
+// the portal server inside the WiFiManager object instead of on the heap. The
+// manager must then have static storage duration (a global), as it grows by
+// the task stacks.
+
+// Consecutive authentication failures after which a known network is left
+// out of reconnect rounds until it connects again or gets a new password.
+#ifndef ALOO_WM_AUTH_FAILURE_LIMIT
+#define ALOO_WM_AUTH_FAILURE_LIMIT 3
+#endif
+
+// Number of networks remembered in the credential table.
+#ifndef ALOO_WM_MAX_CREDENTIALS
+#define ALOO_WM_MAX_CREDENTIALS 8
+#endif
 
 //========================================================================
 // WiFi Status Enumeration
@@ -24,12 +130,257 @@ enum class WiFiStatus {
   NO_INTERNET         // Connected to WiFi but no internet access
 };
 
+//========================================================================
+// Portal Server Backend
+//========================================================================
+enum class WiFiServerBackend {
+  SYNC,   // WebServer polled by the server task (or processWebServer())
+  ASYNC   // Event-driven ESPAsyncWebServer; requires building with ALOO_WM_ASYNC_SERVER
+};
+
 //========================================================================
 // WiFiNetwork Struct
 //========================================================================
+// One scanned BSSID, stored inline so scan pools need no heap.
 struct WiFiNetwork {
-  String ssid;
-  int32_t rssi;
+  char ssid[33];      // NUL-terminated; empty for a hidden network
+  uint8_t bssid[6];
+  uint8_t channel;
+  uint8_t auth;       // wifi_auth_mode_t
+  int8_t rssi;        // dBm
+};
+
+//========================================================================
+// Scan Options
+//========================================================================
+struct WiFiScanOptions {
+  bool passive = false;         // Listen for beacons instead of sending probe requests
+  bool showHidden = false;      // Include networks with a hidden SSID
+  uint32_t msPerChannel = 300;  // Dwell time per channel
+  uint8_t channel = 0;          // Scan a single channel (0 = all channels)
+  bool incremental = false;     // Sweep channel by channel, publishing results after each one
+};
+
+//========================================================================
+// Portal Asset
+//========================================================================
+// A file served by the captive portal from flash. Bundles are produced by
+// tools/embed_portal_assets.py; either body may be null, but not both.
+struct WiFiPortalAsset {
+  const char* path;         // Request URI, e.g. "/style.css"
+  const char* contentType;
+  const uint8_t* data;      // Identity-encoded body (PROGMEM)
+  size_t length;
+  const uint8_t* gzipData;  // gzip-encoded body (PROGMEM)
+  size_t gzipLength;
+  const char* etag;         // Quoted strong ETag, or null
+  uint32_t maxAge;          // Cache-Control max-age in seconds (0 = always revalidate)
+};
+
+//========================================================================
+// Retry Policy
+//========================================================================
+struct WiFiRetryPolicy {
+  uint8_t pendingAttempts = 3;        // Attempts for credentials submitted via the portal
+  uint8_t storedAttempts = 1;         // Attempts per known network in each reconnect round
+  uint32_t initialBackoffMs = 500;    // Backoff before the second attempt
+  uint32_t maxBackoffMs = 30000;      // Cap for a single backoff
+  float multiplier = 2.0f;            // Backoff growth factor per retry
+  bool fullJitter = true;             // Sleep uniformly in [0, backoff] to desynchronize a fleet
+  uint32_t roundRetryMs = 0;          // Delay before retrying all known networks again (0 = wait for the portal)
+  uint32_t maxRoundRetryMs = 300000;  // Cap for the growing delay between rounds
+  uint8_t attemptTimeoutFactor = 3;   // First attempt on a known network times out after this many times
+                                      // its average connect time (0 = always the full connect timeout)
+  uint32_t minAttemptTimeoutMs = 4000; // Floor for that history-based timeout
+  bool skipUnseen = true;             // Skip known networks missing from a fresh scan (set false for hidden SSIDs)
+};
+
+//========================================================================
+// Disconnect Classification and Recovery
+//========================================================================
+enum class WiFiDisconnectClass : uint8_t {
+  TRANSIENT,  // Beacon loss, deauth by a rebooting AP, roaming: the AP is most likely still there
+  AUTH,       // Wrong password or failed handshake
+  NOT_FOUND,  // The AP is gone (powered off or out of range)
+  AP_FULL,    // The AP refused the association (table full, busy)
+  LOCAL,      // Association left (reason 8): the application, a config change, or an AP shutting down
+  OTHER,
+  COUNT
+};
+
+enum class WiFiRecovery : uint8_t {
+  NONE,         // Leave the state alone; the link stays down until something else reconnects it
+  REASSOCIATE,  // Reconnect at once, through the fast reconnect path when possible
+  BACKOFF,      // Reconnect after the retry policy's backoff, growing while it keeps failing
+  MARK_BAD,     // Count an authentication failure against the network, then reconnect
+  PORTAL,       // Open the portal (or go DISCONNECTED without autoLaunchAP)
+  COUNT
+};
+
+//========================================================================
+// Connection Attempt Report
+//========================================================================
+struct WiFiConnectAttempt {
+  const char* ssid;
+  const char* source;     // "pending" or "stored"
+  uint8_t attempt;        // 1-based attempt number within the budget
+  uint32_t durationMs;    // Time from WiFi.begin() to GOT_IP, failure or timeout
+  uint32_t backoffMs;     // Backoff slept before this attempt
+  bool fast;              // Directed fast-connect attempt
+  bool success;
+  uint8_t reason;         // wifi_err_reason_t of the failure (0 = success or timeout)
+  uint32_t timeoutMs;     // Time the attempt was allowed
+};
+
+//========================================================================
+// Manager Events
+//========================================================================
+enum class WiFiManagerEventType : uint8_t {
+  STA_CONNECTED,          // Associated with an AP, no address yet
+  GOT_IP,                 // Station has an IPv4 address
+  DISCONNECTED,           // Station link lost or attempt failed
+  STATUS_CHANGED,         // The manager's WiFiStatus moved
+  SCAN_DONE,
+  AP_CLIENT_CONNECTED,    // A client joined the portal AP
+  AP_CLIENT_DISCONNECTED,
+  COUNT
+};
+
+constexpr uint32_t wifiManagerEventMask(WiFiManagerEventType type) {
+  return 1u << static_cast<uint8_t>(type);
+}
+
+// Fixed-size record queued from the WiFi event callback; fields not listed
+// for an event type are zero.
+struct WiFiManagerEvent {
+  WiFiManagerEventType type;
+  uint32_t timestampMs;   // millis() when the event was queued
+  WiFiStatus status;      // STATUS_CHANGED: new status
+  WiFiStatus previous;    // STATUS_CHANGED: old status
+  uint8_t reason;         // DISCONNECTED: wifi_err_reason_t
+  uint32_t attempt;       // DISCONNECTED: id of the connect attempt that owned the link
+  uint8_t channel;        // STA_CONNECTED
+  uint32_t ip;            // GOT_IP: station address (IPAddress(ip))
+  uint8_t mac[6];         // STA_CONNECTED: BSSID; AP_CLIENT_*: client MAC
+};
+
+//========================================================================
+// Power Profiles
+//========================================================================
+enum class WiFiPowerProfile : uint8_t {
+  PERFORMANCE,  // Modem sleep off, base cadences, portal always polled
+  BALANCED,     // Default: modem sleep between DTIM beacons, idle portal parked
+  LOW_POWER     // Maximum modem sleep with a long listen interval, slow housekeeping
+};
+
+struct WiFiPowerSettings {
+  wifi_ps_type_t sleep = WIFI_PS_MIN_MODEM;  // Station modem sleep; not available while the softAP runs
+  uint16_t listenInterval = 0;               // Beacons between wake-ups under WIFI_PS_MAX_MODEM (0 = IDF default, 3)
+  uint8_t cadenceScale = 1;                  // Multiplier for the probe intervals and the scan cache lifetime
+  uint32_t portalIdleMs = 60000;             // Park the portal server after this long without AP clients (0 = never)
+};
+
+// Radio states timed by the manager, see WiFiMetricsSnapshot::radioStateMs.
+enum class WiFiRadioState : uint8_t {
+  IDLE,         // Station not associated and not connecting
+  CONNECTING,
+  ACTIVE,       // Associated, modem sleep off
+  MODEM_SLEEP,  // Associated, modem sleep on
+  AP,           // softAP up (the radio stays awake)
+  SCAN,
+  COUNT
+};
+
+//========================================================================
+// Metrics
+//========================================================================
+// Portal routes with their own request-latency histogram.
+enum class WiFiHttpRoute : uint8_t {
+  PORTAL,     // Embedded or registered portal files
+  NETWORKS,   // /wifinetworks
+  STATUS,     // /status
+  SUBMIT,     // /submit
+  CAPTIVE,    // OS connectivity checks and foreign hosts redirected to the portal
+  METRICS,    // /metrics
+  NOT_FOUND,
+  COUNT
+};
+
+// Operating systems recognised by their captive portal probe, see AlooCaptiveProbes.h.
+enum class WiFiProbeOs : uint8_t {
+  APPLE, ANDROID, CHROMEOS, WINDOWS, FIREFOX,
+  OTHER,      // Unknown probes and foreign hosts
+  COUNT
+};
+
+// Internal mutexes whose acquisition wait is measured.
+enum class WiFiMutexId : uint8_t {
+  STATUS, PENDING, CONNECTION, CONNECTING, WIFI, NETWORKS, CREDENTIALS, SUBSCRIBERS, STORAGE, COUNT
+};
+
+// Manager tasks reported with their stack high-water mark.
+enum class WiFiTaskId : uint8_t {
+  CONNECTION_MANAGER, SERVER, MONITOR, SCAN, DISPATCHER, PERSIST, DNS, NOTIFIER, COUNT
+};
+
+// Placement of one manager task, see WiFiManager::setTaskConfig().
+struct WiFiTaskConfig {
+  static constexpr int BEGIN_CORE = -1;  // The core passed to begin() (serverCore or managerCore)
+  UBaseType_t priority;
+  int core;                              // 0, 1, tskNO_AFFINITY or BEGIN_CORE
+  uint32_t stackSize;                    // Bytes; capped at ALOO_WM_*_STACK_SIZE with ALOO_WM_STATIC_ALLOCATION
+};
+
+// Runtime view of one manager task, see WiFiManager::getTaskStats().
+struct WiFiTaskStats {
+  bool running;                          // false: not started, or folded into the monitor (shared worker)
+  UBaseType_t priority;                  // Current priority
+  int core;                              // Core the task runs on, or tskNO_AFFINITY
+  uint32_t stackSize;                    // Bytes
+  uint32_t stackFreeMin;                 // Minimum free stack seen, in bytes
+  uint16_t cpuPermille;                  // Share of one core over the window, in 0.1 %
+};
+
+struct WiFiTaskStatsSnapshot {
+  WiFiTaskStats tasks[(size_t)WiFiTaskId::COUNT];
+  bool cpuAvailable;                     // false unless FreeRTOS run-time stats are compiled in
+  uint32_t windowMs;                     // Time since the previous getTaskStats() call
+};
+
+/**
+ * @brief Point-in-time copy of the manager's metrics, see WiFiManager::getMetrics().
+ *        About 1.7 KB, so avoid placing it on a small task stack.
+ */
+struct WiFiMetricsSnapshot {
+  uint32_t connectAttempts;
+  uint32_t connectFailures;
+  uint32_t eventsCoalesced;                    // Events merged into a newer one of the same type (queue full)
+  uint32_t storageWrites;                      // Stored record written to flash
+  uint32_t storageWritesSkipped;               // Flushes that found the record unchanged
+  uint32_t storageWriteFailures;
+  AlooHistogram::Snapshot connectDurationMs;   // WiFi.begin() to GOT_IP or failure, per attempt
+  AlooHistogram::Snapshot scanDurationMs;
+  AlooHistogram::Snapshot probeLatencyMs;      // Fastest successful probe per reachability round
+  AlooHistogram::Snapshot httpDurationUs[(size_t)WiFiHttpRoute::COUNT];
+  AlooHistogram::Snapshot mutexWaitUs[(size_t)WiFiMutexId::COUNT];
+  uint32_t disconnects[ALOO_WM_DISCONNECT_REASON_SLOTS];  // Indexed by disconnectReasonSlot()
+  uint32_t disconnectClasses[(size_t)WiFiDisconnectClass::COUNT];
+  uint32_t recoveries[(size_t)WiFiRecovery::COUNT];       // Recovery taken for a link lost while online
+  uint32_t stackHighWater[(size_t)WiFiTaskId::COUNT];     // Minimum free stack in bytes (0 = not running)
+  uint64_t radioStateMs[(size_t)WiFiRadioState::COUNT];   // Time spent in each radio state since construction
+  WiFiCaptiveDnsStats dns;                                 // Captive DNS responder
+  uint32_t captiveProbes[(size_t)WiFiProbeOs::COUNT];     // Requests redirected to the portal, by OS
+
+  // Maps a wifi_err_reason_t to its slot in disconnects[]; unknown codes share slot 0.
+  static uint8_t disconnectReasonSlot(uint8_t reason) {
+    if (reason < 64) return reason;
+    if (reason >= 200 && reason < 232) return (uint8_t)(reason - 136);
+    return 0;
+  }
+  static uint8_t disconnectReasonForSlot(uint8_t slot) {
+    return slot < 64 ? slot : (uint8_t)(slot + 136);
+  }
+  uint32_t disconnectCount(uint8_t reason) const { return disconnects[disconnectReasonSlot(reason)]; }
 };
 
 //========================================================================
@@ -42,7 +393,7 @@ public:
    * @param apSsid SSID for the configuration access point.
    * @param apPassword Password for the configuration AP (empty string for open network).
    * @param autoLaunchAP When true, automatically launch AP mode after a failed connection attempt.
-   * @param reconnectionAttempts Number of reconnection attempts before giving up.
+   * @param reconnectionAttempts Attempts per known network before giving up (see WiFiRetryPolicy::storedAttempts).
    */
   WiFiManager(const String& apSsid = "ESP32-Config", 
               const String& apPassword = "", 
@@ -54,16 +405,32 @@ public:
    * @brief Starts the asynchronous WiFi management and web server.
    *
    * @param runServerOnSeparateCore Run web server in a separate FreeRTOS task.
-   * @param serverCore CPU core for web server task.
-   * @param managerCore CPU core for connection manager and monitor tasks.
-   * @param managerTaskDelay Delay (in ms) between iterations in the connection manager task loop.
+   * @param serverCore CPU core for the web server and DNS tasks, unless set by setTaskConfig().
+   * @param managerCore CPU core for the other manager tasks, unless set by setTaskConfig().
+   * @param managerTaskDelay Unused; the connection manager sleeps on state events instead of polling.
    * @param serverTaskDelay Delay (in ms) between iterations in the server task loop.
-   * @param monitorTaskDelay Delay (in ms) between iterations in the monitor task loop.
-   * @param scanTaskDelay Delay (in ms) between iterations in the scan task loop.
+   * @param monitorTaskDelay Shortest interval (in ms) between internet checks while connected;
+   *                         it grows while the connection is stable, see setReachabilityConfig().
+   * @param scanTaskDelay Scan cache lifetime (in ms); older results are refreshed on the next request.
+   * @param serverBackend HTTP server used by the portal. ASYNC serves concurrent clients
+   *                      without polling; it falls back to SYNC when not compiled in.
    */
   void begin(bool runServerOnSeparateCore = true, int serverCore = 1, int managerCore = 1,
              uint32_t managerTaskDelay = 500, uint32_t serverTaskDelay = 10,
-             uint32_t monitorTaskDelay = 5000, uint32_t scanTaskDelay = 15000);
+             uint32_t monitorTaskDelay = 5000, uint32_t scanTaskDelay = 15000,
+             WiFiServerBackend serverBackend = WiFiServerBackend::SYNC);
+
+  /**
+   * @brief Stops the portal and the manager tasks; begin() starts them again.
+   *
+   * Each task is asked to stop and exits at its next safe point, so none is
+   * deleted while it holds a lock or is inside a request. Blocking waits are
+   * woken, so the usual cost is one scan or internet check in flight.
+   * @param timeoutMs Upper bound on the whole shutdown. A task that has not
+   *                  acknowledged by then is deleted anyway.
+   * @return false if a task had to be deleted without acknowledging.
+   */
+  bool end(uint32_t timeoutMs = 5000);
 
   /**
    * @brief Returns the current WiFi connection status.
@@ -72,6 +439,7 @@ public:
 
   /**
    * @brief Processes web server client requests (if not running on a separate core).
+   *        Nothing to do with the ASYNC backend; captive DNS has its own task.
    */
   void processWebServer();
 
@@ -98,16 +466,263 @@ public:
    */
   bool tryConnect(const String &ssid, const String &password);
 
+  /**
+   * @brief Configures directed fast reconnect for the last successful network.
+   *
+   * When enabled, the first attempt with stored credentials skips the channel
+   * scan by targeting the cached BSSID/channel, and reuses the cached DHCP lease
+   * as a static configuration while it is younger than leaseLifetime. The lease
+   * age is known from wall-clock time (SNTP or an external RTC), or without it
+   * across any reset that keeps the RTC timer running (watchdog, panic,
+   * brownout, deep sleep); after a power-on reset without wall-clock time the
+   * age is unknown and DHCP is used. Once the station is online on the cached
+   * address, the DHCP client is started next to it and renews the lease in
+   * the background; the address is never cleared while the link is up.
+   * @param enabled Enable or disable the fast path (enabled by default).
+   * @param timeout Time (ms) allowed for the fast attempt before falling back
+   *                to a full scan and DHCP.
+   * @param leaseLifetime Seconds a cached DHCP lease may be reused (0 = never reuse
+   *                      the lease). Keep it below the DHCP server's lease time.
+   */
+  void setFastReconnect(bool enabled, unsigned long timeout = 3000, uint32_t leaseLifetime = 3600);
+
+  /**
+   * @brief Keeps the station and the portal up together.
+   *
+   * In dual mode, opening the portal no longer drops the station, the softAP
+   * starts on the station's (or the cached) channel so it does not hop when
+   * the station associates, and after GOT_IP the portal keeps serving
+   * /status for graceMs. Modem sleep starts when the portal closes.
+   * @param enabled Enable dual mode (disabled by default).
+   * @param graceMs Time (ms) the portal stays up after the station connects
+   *                (0 = keep it up until end() or forceAPMode()).
+   */
+  void setDualMode(bool enabled, uint32_t graceMs = 60000);
+
+  /**
+   * @brief Stores credentials in the known-network table without connecting.
+   *        When the table is full, the lowest-ranked entry is evicted.
+   */
+  bool addCredentials(const String &ssid, const String &password);
+
+  /**
+   * @brief Removes a network from the known-network table.
+   * @return true if the SSID was found and removed.
+   */
+  bool removeCredentials(const String &ssid);
+
+  /**
+   * @brief Returns the number of networks in the known-network table.
+   */
+  size_t getStoredNetworkCount();
+
+  /**
+   * @brief Writes pending credential and connection-state changes to flash now
+   *        instead of after the write-behind delay, e.g. before a restart or
+   *        deep sleep. end() flushes as well.
+   * @return false if the write failed; the changes stay pending.
+   */
+  bool flushStorage();
+
+  /**
+   * @brief Replaces the retry policy used by the connection manager.
+   */
+  void setRetryPolicy(const WiFiRetryPolicy& policy);
+
+  /**
+   * @brief Returns a copy of the current retry policy.
+   */
+  WiFiRetryPolicy getRetryPolicy();
+
+  /**
+   * @brief Registers a callback invoked after every connection attempt with its timing.
+   *        Runs on the connection manager task; keep it short.
+   */
+  typedef std::function<void(const WiFiConnectAttempt&)> ConnectAttemptCallback;
+  void onConnectAttempt(ConnectAttemptCallback callback);
+
+  /**
+   * @brief Subscribes to manager events, so applications need no WiFi.onEvent()
+   *        handler of their own.
+   *
+   * Callbacks run on the manager's notifier task, in event order, after the
+   * event task has acted on the event (a GOT_IP subscriber already sees the
+   * status as CONNECTED). A slow callback delays later callbacks, never the
+   * manager's own transitions. They may call unsubscribe().
+   * @param mask Event types to deliver, OR-ed wifiManagerEventMask() values.
+   * @return Subscription id for unsubscribe(), or -1 if all slots are taken.
+   */
+  typedef std::function<void(const WiFiManagerEvent&)> EventCallback;
+  int subscribe(EventCallback callback, uint32_t mask = 0xFFFFFFFF);
+  void unsubscribe(int id);
+
+  /**
+   * @brief Tunes the internet reachability checks (hysteresis, interval
+   *        adaptation, round timeout). See WiFiReachabilityConfig.
+   */
+  void setReachabilityConfig(const WiFiReachabilityConfig& config);
+
+  /**
+   * @brief Replaces the probe targets checked in every round, e.g. to point
+   *        them at a server on the local uplink. Strings must outlive the manager.
+   */
+  void setReachabilityTargets(const WiFiProbeTarget* targets, size_t count);
+
+  /**
+   * @brief Filtered reachability state and rolling-window statistics.
+   */
+  WiFiReachabilityStats getReachability();
+
+  /**
+   * @brief Applies one of the built-in power profiles, see powerProfile().
+   */
+  void setPowerProfile(WiFiPowerProfile profile);
+
+  /**
+   * @brief Applies custom power settings. Modem sleep is set at once; the
+   *        listen interval is written before the next connect attempt.
+   */
+  void setPowerSettings(const WiFiPowerSettings& settings);
+  WiFiPowerSettings getPowerSettings();
+
+  /**
+   * @brief Sets how the manager reacts when the link drops while online.
+   *        Disconnects during a connection attempt are handled by the attempt.
+   *        Defaults: TRANSIENT reassociates, AUTH marks the network, NOT_FOUND
+   *        and AP_FULL back off, LOCAL reassociates and OTHER opens the portal.
+   *        Disconnects the manager causes itself never trigger a recovery.
+   */
+  void setRecovery(WiFiDisconnectClass cls, WiFiRecovery recovery);
+
+  /**
+   * @brief Maps a wifi_err_reason_t to its class.
+   */
+  static WiFiDisconnectClass classifyDisconnect(uint8_t reason);
+
+  /**
+   * @brief Settings behind a built-in profile, e.g. as a base for setPowerSettings().
+   */
+  static WiFiPowerSettings powerProfile(WiFiPowerProfile profile);
+
+  /**
+   * @brief Requests a WiFi scan unless the cached results are younger than the cache TTL.
+   *        Requests made while a scan is running are served by that scan.
+   * @param force Scan even if the cache is still fresh.
+   * @return true if a scan is queued or running, false if the cache was fresh.
+   */
+  bool requestScan(bool force = false);
+
+  /**
+   * @brief Blocks until no scan is queued or running.
+   * @return false on timeout.
+   */
+  bool waitForScan(uint32_t timeoutMs);
+
+  /**
+   * @brief Sets scan mode options (passive, per-channel, incremental).
+   */
+  void setScanOptions(const WiFiScanOptions& options);
+
+  /**
+   * @brief Sets how long (in ms) scan results are served from the cache.
+   */
+  void setScanCacheTtl(uint32_t ttlMs);
+
+  /**
+   * @brief Serves an application asset bundle from flash. Assets override the
+   *        embedded portal files with the same path. The array must outlive the manager.
+   */
+  void registerPortalAssets(const WiFiPortalAsset* assets, size_t count);
+
+  /**
+   * @brief Serves the portal from a filesystem directory (e.g. LittleFS)
+   *        instead of the embedded files. Pass nullptr to revert.
+   * @param root Directory holding index.html and friends; "<file>.gz" variants are preferred.
+   * @param cacheControl Cache-Control header sent with every file.
+   */
+  void setPortalFilesystem(fs::FS* fs, const char* root = "/portal",
+                           const char* cacheControl = "max-age=86400");
+
+  /**
+   * @brief Copies the current metrics (also served at /metrics in Prometheus format).
+   */
+  void getMetrics(WiFiMetricsSnapshot& out);
+
+  /**
+   * @brief Sets the priority, core and stack size of a manager task.
+   *
+   * Applies the next time the task is created: at begin() for the tasks it
+   * starts, when the portal first starts for the server and DNS tasks, and
+   * after end() for all of them.
+   */
+  void setTaskConfig(WiFiTaskId id, const WiFiTaskConfig& config);
+  WiFiTaskConfig getTaskConfig(WiFiTaskId id) const;
+
+  /**
+   * @brief Runs the scan work on the monitor task instead of a task of its own.
+   *
+   * Both jobs are already driven by the internet check timer and by scan
+   * requests, so one task can serve them in turn; this saves the scan task's
+   * stack and TCB. A reachability round then waits for a running scan.
+   * @return false if called while the manager tasks run (before begin() or
+   *         after end() only).
+   */
+  bool setSharedWorker(bool enabled);
+
+  /**
+   * @brief Copies each manager task's priority, core, stack use and CPU share.
+   *
+   * CPU shares cover the time since the previous call and need FreeRTOS
+   * run-time stats (CONFIG_FREERTOS_GENERATE_RUN_TIME_STATS); without them
+   * cpuAvailable is false. Calls should be less than an hour apart, since
+   * the run-time counter is 32 bits wide.
+   */
+  void getTaskStats(WiFiTaskStatsSnapshot& out);
+
 private:
+  // Lets the host tests in test/host reach the backoff, transition and event
+  // queue internals without widening the public API.
+  friend struct WiFiManagerTestAccess;
+
   //========================================================================
   // Private Members (Configuration, State, and Tasks)
   //========================================================================
   String _apSsid;
   String _apPassword;
 
-  WiFiStatus _status;
+  // Current state. Readers load it lock-free; writers serialize on _statusMutex
+  // so the transition check and the event-group update happen as one step.
+  std::atomic<WiFiStatus> _status;
   SemaphoreHandle_t _statusMutex;
 
+  // Mirrors _status as one bit per state plus the EVT_* flags below, so tasks
+  // can block until a state of interest is reached instead of polling.
+  EventGroupHandle_t _stateEvents;
+
+  // Task supervisor handshake: run request, parked and exited bits per task
+  // (see taskRunBit() and friends).
+  EventGroupHandle_t _taskEvents;
+
+  // A queue plus one latch per event type. An event that finds the queue full
+  // is merged into its type's latch instead of being lost; latches are taken
+  // once the queue has drained, so they never overtake a queued event.
+  struct EventChannel {
+    QueueHandle_t queue;
+    WiFiManagerEvent latched[(size_t)WiFiManagerEventType::COUNT];
+    uint32_t latchedMask;
+  };
+  // WiFi events queued by wifiEventHandler() and handled on the event task,
+  // which then passes them on to the notifier task for the subscribers.
+  EventChannel _events;
+  EventChannel _notifications;
+  portMUX_TYPE _eventLock;
+  struct Subscriber {
+    EventCallback callback;
+    uint32_t mask;  // 0 marks a slot unsubscribed from within a callback
+  };
+  Subscriber _subscribers[ALOO_WM_MAX_SUBSCRIBERS];
+  SemaphoreHandle_t _subscribersMutex;
+
   // Credential management for pending credentials submitted via captive portal
   String _pendingSsid;
   String _pendingPassword;
@@ -116,24 +731,88 @@ private:
 
   // Web server and DNS components
   WebServer* _server;
-  DNSServer _dnsServer;
+  AlooCaptiveDns _captiveDns;               // Served by the DNS task while the portal is up
   bool _runServerOnSeparateCore;
+  WiFiServerBackend _serverBackend;
+  bool _portalActive;                       // softAP and portal server are up
+  bool _dualMode;                           // See setDualMode()
+  uint32_t _portalGraceMs;                  // Portal lifetime after GOT_IP in dual mode (0 = permanent)
+  std::atomic<bool> _portalCloseScheduled;  // Set on GOT_IP, carried out by the connection manager
+  std::atomic<uint32_t> _portalCloseAt;     // millis() deadline of the scheduled close
+  bool _serverRoutesRegistered;             // WebServer is kept across AP cycles, routes added once
+  char _captiveLocation[24];                // "http://<AP IP>/", set when the portal starts
+  char _captiveResponse[192];               // Complete 302 response to _captiveLocation
+  size_t _captiveResponseLength;
+#ifdef ALOO_WM_ASYNC_SERVER
+  // Created on the first AP cycle and kept; routes are registered once and the
+  // listener is started/stopped with the portal.
+  AsyncWebServer* _asyncServer;
+  bool _asyncRoutesRegistered;
+  AsyncEventSource* _networkEvents;         // Owned by _asyncServer
+  uint32_t _pushedGeneration;               // Scan generation last pushed to _networkEvents (scan task)
+#endif
 
   // Task handles and core assignments
   TaskHandle_t _connectionManagerTaskHandle;  // Persistent connection manager task
   TaskHandle_t _serverTaskHandle;
   TaskHandle_t _monitorTaskHandle;
   TaskHandle_t _scanTaskHandle;
+  TaskHandle_t _dispatcherTaskHandle;
+  TaskHandle_t _persistTaskHandle;
+  TaskHandle_t _dnsTaskHandle;
+  TaskHandle_t _notifierTaskHandle;
   int _serverCore;
   int _managerCore;
+  WiFiTaskConfig _taskConfig[(size_t)WiFiTaskId::COUNT];   // Requested, see setTaskConfig()
+  WiFiTaskConfig _taskApplied[(size_t)WiFiTaskId::COUNT];  // Resolved core and stack of the running tasks
+  bool _sharedWorker;                       // Monitor task also serves scan requests
+
+  // CPU share window of getTaskStats() (guarded by _taskStatsLock)
+  portMUX_TYPE _taskStatsLock;
+  uint32_t _taskRunTime[(size_t)WiFiTaskId::COUNT];
+  uint32_t _runTimeTotal;
+  uint32_t _taskStatsAt;                    // millis() of the previous call
 
   // Persistent storage (using Preferences)
   Preferences _preferences;
   static const char PREF_NAMESPACE[];  // Defined in cpp
+  static const char PREF_STATE_KEY[];    // Defined in cpp
+  // Keys of the old one-key-per-field layout, read once for migration.
   static const char PREF_SSID_KEY[];     // Defined in cpp
   static const char PREF_PASS_KEY[];     // Defined in cpp
+  static const char PREF_BSSID_KEY[];    // Defined in cpp
+  static const char PREF_CHANNEL_KEY[];  // Defined in cpp
+  static const char PREF_LEASE_KEY[];    // Defined in cpp
+
+  // DHCP lease of the last connection, reused as a static IP config on fast reconnect.
+  struct IpLease {
+    uint32_t ip;
+    uint32_t gateway;
+    uint32_t subnet;
+    uint32_t dns;
+    uint32_t obtainedAt;  // time() when DHCP granted the lease (wall clock or RTC timer, 0 = unknown)
+  };
+
+  // Fast reconnect cache for the last AP (loaded alongside the stored credentials)
+  bool _fastReconnect;
+  unsigned long _fastConnectTimeout;
+  uint32_t _leaseLifetime;
+  String _fastConnectSsid;                  // SSID the cache belongs to (empty = no cache)
+  uint8_t _fastConnectBssid[6];
+  uint8_t _fastConnectChannel;
+  IpLease _lease;
+  bool _usingStaticLease;                   // Current attempt runs on the cached lease
+  bool _fastCacheStale;                     // Fast attempt failed this session (not persisted)
+  // DHCP client next to the cached address, see startLeaseRenewal().
+  enum class LeaseDhcp : uint8_t {
+    OFF,
+    RENEWING,   // Started, not bound yet
+    BOUND,      // Bound to the cached address; lwIP renews it
+    HANDOVER    // Address moved; esp_netif's own DHCP client took over
+  };
+  std::atomic<LeaseDhcp> _leaseDhcp;
 
-  // Mutex to protect simultaneous connection attempts
+  // Mutex guarding the retry policy shared with the connection manager
   SemaphoreHandle_t _connectionMutex;
 
   // Mutex for WiFi operations (new addition)
@@ -142,10 +821,50 @@ private:
   // Connection timeout (milliseconds)
   unsigned long _connectTimeout;
 
-  // Cached WiFi networks (for /wifinetworks endpoint)
-  std::vector<WiFiNetwork> _cachedNetworks;
+  // Scan cache keyed on BSSID (guarded by _networksMutex). Every add, update
+  // and removal stamps the entry with the next generation, and removed
+  // entries stay as tombstones, so /wifinetworks?since=<generation> can
+  // answer with just the changes.
+  struct ScanEntry {
+    WiFiNetwork net;
+    bool present;                           // false: tombstone
+    uint32_t generation;                    // Generation of the last change (0 = free slot)
+    uint32_t lastSeen;                      // millis() of the last scan that reported it
+  };
+  // Snapshot of the scan cache taken by handleWifiNetworks() so the response
+  // is streamed without holding _networksMutex or allocating.
+  struct NetworkSnapshot {
+    WiFiNetwork net;
+    bool present;
+  };
+  // The scan tables run to well over 10 KB with the default limits, more than
+  // a loop task's stack, so they live outside the object: on the heap from
+  // the constructor, or in _scanBuffersStorage with ALOO_WM_STATIC_ALLOCATION.
+  struct ScanBuffers {
+    ScanEntry table[ALOO_WM_MAX_NETWORKS];
+    // Result of the last completed scan, grouped by SSID with each SSID's
+    // strongest BSSID first. The scan task fills _scanStaging without a lock
+    // and publishes it by swapping the two pointers under _networksMutex.
+    WiFiNetwork pool[2][ALOO_WM_MAX_NETWORKS];
+    NetworkSnapshot snapshot[ALOO_WM_MAX_NETWORKS];
+#ifdef ALOO_WM_ASYNC_SERVER
+    char networkEvent[ALOO_WM_NETWORK_EVENT_SIZE];  // Diff pushed to _networkEvents (scan task)
+#endif
+  };
+  ScanBuffers* _scanBuffers;
+  ScanBuffers* createScanBuffers();
+  uint32_t _scanGeneration;
+  uint32_t _scanHorizon;                    // Deltas from before this generation are incomplete
+  WiFiNetwork* _scanResults;                // Guarded by _networksMutex
+  size_t _scanResultCount;
+  WiFiNetwork* _scanStaging;                // Scan task only
   SemaphoreHandle_t _networksMutex;
 
+  // Demand-driven scanning (guarded by _networksMutex)
+  WiFiScanOptions _scanOptions;
+  uint32_t _scanCacheTtl;
+  unsigned long _lastScanAt;                // millis() of the last completed scan (0 = never)
+
   //========================================================================
   // Endpoints and Polling Constants
   //========================================================================
@@ -157,7 +876,8 @@ private:
   // Event-based Enhancements
   //========================================================================
   static WiFiManager* _instance;          // Singleton instance for event callbacks
-  TimerHandle_t _internetCheckTimer;        // Timer to periodically check internet access
+  TimerHandle_t _internetCheckTimer;        // One-shot, re-armed by the monitor with the prober's next interval
+  AlooReachability _reachability;
   bool _isConnecting;                       // Flag to indicate ongoing connection attempt
   SemaphoreHandle_t _connectingMutex;       // Mutex to protect _isConnecting
 
@@ -165,9 +885,138 @@ private:
   bool _autoLaunchAP;                       // Whether to automatically launch AP after failed connection
   int _reconnectionAttempts;                // Number of reconnection attempts before giving up
 
+  // Retry policy (guarded by _connectionMutex) and attempt reporting
+  WiFiRetryPolicy _retryPolicy;
+  ConnectAttemptCallback _attemptCallback;
+
+  //========================================================================
+  // Power Management
+  //========================================================================
+  WiFiPowerSettings _powerSettings;         // Guarded by _connectionMutex
+  std::atomic<uint32_t> _portalIdleMs;      // Copy of _powerSettings.portalIdleMs for the server loop
+  std::atomic<uint8_t> _portalClients;      // Stations associated with the softAP
+  std::atomic<uint32_t> _portalIdleSince;   // millis() when the last client left or the portal opened
+
+  // Radio state time accounting (guarded by _radioLock)
+  portMUX_TYPE _radioLock;
+  WiFiRadioState _radioState;
+  uint32_t _radioStateSince;                // millis() when _radioState was entered
+  uint64_t _radioStateMs[(size_t)WiFiRadioState::COUNT];
+  std::atomic<bool> _radioScanning;
+  std::atomic<bool> _modemSleep;            // Station modem sleep requested
+
+  void applyPowerSettings();
+  void applyStationPowerSave();
+  void applyListenInterval(uint16_t listenInterval);
+  uint32_t scanCacheTtl();
+  uint8_t portalChannel();
+  void accountRadioState();
+  WiFiRadioState currentRadioState();
+
   // New members to store current credentials for saving on successful connection
   String _currentSsid;
   String _currentPassword;
+  unsigned long _connectStartedAt;          // millis() when the current attempt started
+  std::atomic<uint8_t> _lastDisconnectReason;  // Reason of the last STA disconnect, read after EVT_CONNECT_FAILED
+  uint8_t _lastAttemptReason;               // Failure reason of the last attempt (0 = timeout); manager task only
+
+  // Recovery per disconnect class (guarded by _connectionMutex). A BACKOFF
+  // recovery hands its delay to the connection manager.
+  WiFiRecovery _recovery[(size_t)WiFiDisconnectClass::COUNT];
+  std::atomic<uint32_t> _recoveryDelayMs;
+  uint32_t _recoveryRetries;                // BACKOFF recoveries since the last GOT_IP (event task only)
+  // Set by disconnectStation() when the manager drops a live link itself, so
+  // the resulting DISCONNECTED event is not taken for a lost link.
+  std::atomic<bool> _expectingDisconnect;
+  // Each connect attempt gets a new id; DISCONNECTED events carry the id of
+  // the attempt whose link they end, so a late one from the previous link is
+  // not taken for the current attempt's failure. _linkPending is set while
+  // the driver still owes a DISCONNECTED for the link it was given.
+  std::atomic<uint32_t> _attemptId;
+  std::atomic<bool> _linkPending;
+  void recoverFromDisconnect(uint8_t reason);
+  void disconnectStation(bool wifiOff, bool eraseAp = false);
+
+  //========================================================================
+  // Known-Network Credential Table
+  //========================================================================
+  struct CredentialEntry {
+    char ssid[33];
+    char password[65];
+    uint16_t successCount;
+    uint16_t failCount;
+    uint8_t authFailures;     // Consecutive auth failures (fills former padding; layout unchanged)
+    uint32_t lastConnected;   // Table sequence number of the last success (0 = never)
+    uint16_t avgConnectMs;    // Moving average time from attempt start to GOT_IP
+  };
+  struct CredentialTable {
+    uint8_t version;
+    uint8_t count;
+    uint32_t sequence;        // Logical clock, bumped on every successful connection
+    CredentialEntry entries[ALOO_WM_MAX_CREDENTIALS];
+  };
+  static const char PREF_TABLE_KEY[];    // Defined in cpp (old layout)
+  static constexpr uint8_t CREDENTIAL_TABLE_VERSION = 1;
+  CredentialTable _credentials;
+  bool _credentialsLoaded;
+  SemaphoreHandle_t _credentialsMutex;
+
+  // Last successful network, served from RAM once loaded.
+  char _lastSsid[33];
+  char _lastPassword[65];
+
+  //========================================================================
+  // Persistent Record (write-behind)
+  //========================================================================
+  // Everything stored in flash, as one blob under PREF_STATE_KEY. The fields
+  // between generation and crc are the payload compared to skip no-op writes.
+  struct PersistentRecord {
+    uint16_t version;
+    uint16_t size;            // sizeof(PersistentRecord) when written
+    uint32_t generation;      // Bumped on every write
+    char lastSsid[33];
+    char lastPassword[65];
+    uint8_t lastBssid[6];
+    uint8_t lastChannel;      // 0 = no fast reconnect cache
+    IpLease lease;
+    CredentialTable credentials;
+    uint32_t crc;             // CRC-32 of all fields above
+  };
+  static constexpr uint16_t PERSISTENT_RECORD_VERSION = 1;
+  PersistentRecord _storedRecord;           // Image of the record in flash (guarded by _storageMutex once loaded)
+  bool _storageDirty;                       // RAM differs from flash, or may (guarded by _credentialsMutex)
+  TickType_t _flushDueAt;                   // Tick count at which the persist task writes
+  SemaphoreHandle_t _storageMutex;          // Serializes flushes; taken before _credentialsMutex
+
+  //========================================================================
+  // Metrics Registry
+  //========================================================================
+  // Updated lock-free on the hot paths, read by getMetrics() and /metrics.
+  struct Metrics {
+    AlooCounter connectAttempts;
+    AlooCounter connectFailures;
+    AlooCounter eventsCoalesced;
+    AlooCounter storageWrites;
+    AlooCounter storageWritesSkipped;
+    AlooCounter storageWriteFailures;
+    AlooHistogram connectDurationMs;
+    AlooHistogram scanDurationMs;
+    AlooHistogram probeLatencyMs;
+    AlooHistogram httpDurationUs[(size_t)WiFiHttpRoute::COUNT];
+    AlooHistogram mutexWaitUs[(size_t)WiFiMutexId::COUNT];
+    AlooCounter disconnects[ALOO_WM_DISCONNECT_REASON_SLOTS];
+    AlooCounter disconnectClasses[(size_t)WiFiDisconnectClass::COUNT];
+    AlooCounter recoveries[(size_t)WiFiRecovery::COUNT];
+    AlooCounter captiveProbes[(size_t)WiFiProbeOs::COUNT];
+  };
+  Metrics _metrics;
+  static const char METRICS_ENDPOINT[];  // Defined in cpp
+  static const char NETWORK_EVENTS_ENDPOINT[];
+
+  AlooHistogram& routeMetric(WiFiHttpRoute route) { return _metrics.httpDurationUs[(size_t)route]; }
+  BaseType_t takeMutex(SemaphoreHandle_t mutex, WiFiMutexId id);
+  TaskHandle_t taskHandle(WiFiTaskId id) const;
+  void writeMetrics(AlooPrometheusWriter& out);
 
   //========================================================================
   // Task Frequency Parameters (in milliseconds)
@@ -175,34 +1024,155 @@ private:
   uint32_t _managerTaskDelay;
   uint32_t _serverTaskDelay;
   uint32_t _monitorTaskDelay;
-  uint32_t _scanTaskDelay;
+
+  //========================================================================
+  // State Machine Event Bits
+  //========================================================================
+  // Bits 0..5 mirror WiFiStatus (see stateBit()); the flags start above them.
+  static constexpr EventBits_t EVT_CREDENTIALS_PENDING = (1 << 6);  // New credentials submitted
+  static constexpr EventBits_t EVT_STATE_CHANGED       = (1 << 7);  // Any accepted transition
+  static constexpr EventBits_t EVT_CONNECT_FAILED      = (1 << 8);  // STA disconnected during an attempt
+  static constexpr EventBits_t EVT_SCAN_REQUESTED      = (1 << 9);  // Scan wanted by a reader
+  static constexpr EventBits_t EVT_SCAN_IDLE           = (1 << 10); // No scan queued or running
+  static constexpr EventBits_t EVT_SHUTDOWN            = (1 << 11); // end() in progress; every task wait includes it
+  static constexpr EventBits_t EVT_MONITOR_DUE         = (1 << 12); // Reachability round wanted
+  static constexpr EventBits_t EVT_LINK_DOWN           = (1 << 13); // A DISCONNECTED left the system event task
+
+  static constexpr EventBits_t stateBit(WiFiStatus status) {
+    return (EventBits_t)1 << static_cast<uint8_t>(status);
+  }
+  static constexpr EventBits_t ALL_STATE_BITS = 0x3F;
+  static constexpr EventBits_t ONLINE_STATE_BITS = (1 << static_cast<uint8_t>(WiFiStatus::CONNECTED)) |
+                                                   (1 << static_cast<uint8_t>(WiFiStatus::NO_INTERNET));
+  static constexpr EventBits_t OFFLINE_STATE_BITS = ALL_STATE_BITS & ~ONLINE_STATE_BITS;
+
+  //========================================================================
+  // Task Supervisor Event Bits (_taskEvents)
+  //========================================================================
+  // Run is set by the supervisor while the task should work, parked and
+  // exited are the task's acknowledgements. 24 usable bits allow 8 tasks.
+  static constexpr EventBits_t taskRunBit(WiFiTaskId id) {
+    return (EventBits_t)1 << static_cast<uint8_t>(id);
+  }
+  static constexpr EventBits_t taskParkedBit(WiFiTaskId id) {
+    return (EventBits_t)1 << (8 + static_cast<uint8_t>(id));
+  }
+  static constexpr EventBits_t taskExitedBit(WiFiTaskId id) {
+    return (EventBits_t)1 << (16 + static_cast<uint8_t>(id));
+  }
+  static constexpr EventBits_t ALL_TASK_RUN_BITS = (1 << static_cast<uint8_t>(WiFiTaskId::COUNT)) - 1;
+
+#ifdef ALOO_WM_STATIC_ALLOCATION
+  //========================================================================
+  // Static Allocation Storage
+  //========================================================================
+  StaticSemaphore_t _mutexStorage[(size_t)WiFiMutexId::COUNT];
+  StaticEventGroup_t _stateEventsStorage;
+  StaticEventGroup_t _taskEventsStorage;
+  StaticTimer_t _internetCheckTimerStorage;
+  StaticTask_t _taskStorage[(size_t)WiFiTaskId::COUNT];
+  StackType_t _managerStack[ALOO_WM_MANAGER_STACK_SIZE / sizeof(StackType_t)];
+  StackType_t _serverStack[ALOO_WM_SERVER_STACK_SIZE / sizeof(StackType_t)];
+  StackType_t _monitorStack[ALOO_WM_MONITOR_STACK_SIZE / sizeof(StackType_t)];
+  StackType_t _scanStack[ALOO_WM_SCAN_STACK_SIZE / sizeof(StackType_t)];
+  StackType_t _dispatcherStack[ALOO_WM_DISPATCHER_STACK_SIZE / sizeof(StackType_t)];
+  StackType_t _persistStack[ALOO_WM_PERSIST_STACK_SIZE / sizeof(StackType_t)];
+  StackType_t _dnsStack[ALOO_WM_DNS_STACK_SIZE / sizeof(StackType_t)];
+  StackType_t _notifierStack[ALOO_WM_NOTIFIER_STACK_SIZE / sizeof(StackType_t)];
+  StaticQueue_t _eventQueueStorage;
+  uint8_t _eventQueueBuffer[ALOO_WM_EVENT_QUEUE_LENGTH * sizeof(WiFiManagerEvent)];
+  StaticQueue_t _notifyQueueStorage;
+  uint8_t _notifyQueueBuffer[ALOO_WM_NOTIFY_QUEUE_LENGTH * sizeof(WiFiManagerEvent)];
+  alignas(WebServer) uint8_t _serverStorage[sizeof(WebServer)];
+  ScanBuffers _scanBuffersStorage;
+#ifdef ALOO_WM_ASYNC_SERVER
+  alignas(AsyncWebServer) uint8_t _asyncServerStorage[sizeof(AsyncWebServer)];
+#endif
+#endif
+
+  //========================================================================
+  // Kernel Object Allocation (heap or static storage)
+  //========================================================================
+  SemaphoreHandle_t createMutex(WiFiMutexId id);
+  bool createTask(WiFiTaskId id, TaskFunction_t function);
+  void createInternetCheckTimer();
+  static void internetCheckTimerCallback(TimerHandle_t timer);
+  WebServer* createWebServer();
+  void destroyWebServer();
+
+  //========================================================================
+  // Task Supervisor
+  //========================================================================
+  // Workers call taskCheckpoint() at points where they hold no lock and are
+  // outside any request; that is the only place they park or exit.
+  bool startTask(WiFiTaskId id, TaskFunction_t function);
+  void resumeTask(WiFiTaskId id);
+  bool parkTask(WiFiTaskId id, uint32_t timeoutMs);
+  bool stopTasks(uint32_t timeoutMs);
+  bool taskCheckpoint(WiFiTaskId id);
+  void taskExit(WiFiTaskId id);
+  bool shutdownRequested() const;
+  TaskHandle_t* taskHandleSlot(WiFiTaskId id);
+  int taskCore(WiFiTaskId id) const;
+  TaskHandle_t scanWorker() const;
 
   //========================================================================
   // Private Helper Functions for Shared Variables and Operations
   //========================================================================
-  void updateStatus(WiFiStatus newStatus);
+  bool updateStatus(WiFiStatus newStatus);
+  static bool isTransitionAllowed(WiFiStatus from, WiFiStatus to);
   WiFiStatus safeGetStatus();
   void setPendingCredentials(const String& ssid, const String& password);
   bool fetchPendingCredentials(String &ssid, String &password);
+  bool startConnection(const String &ssid, const String &password, bool allowFast);
+  bool isLeaseValid() const;
+  void recordLease();
+  void stampLease();
+  void startLeaseRenewal();
+  void checkLeaseRenewal();
   bool resetWiFi();
   //========================================================================
   // Web Server Helpers (Default Embedded Web Files)
   //========================================================================
   void setupDefaultEndpoints();
+  void servePortalAsset(const WiFiPortalAsset& asset);
+
+  // Application-provided portal files (see registerPortalAssets/setPortalFilesystem)
+  const WiFiPortalAsset* _userAssets;
+  size_t _userAssetCount;
+  fs::FS* _portalFs;
+  String _portalFsRoot;
+  String _portalFsCacheControl;
 
   //========================================================================
   // Credential Storage Helpers
   //========================================================================
   bool loadLastCredentials(String &ssid, String &password);
   bool saveLastCredentials(const String &ssid, const String &password);
+  void ensureCredentialTableLoaded();
+  bool readLegacyRecord(PersistentRecord& record);
+  void buildPersistentRecord(PersistentRecord& record);
+  void applyPersistentRecord(const PersistentRecord& record);
+  void markStorageDirty(bool credentialsChanged);
+  static void persistTask(void* param);
+  int findCredential(const String &ssid) const;
+  CredentialEntry* upsertCredential(const String &ssid, const String &password);
+  int32_t scoreCredential(const CredentialEntry &entry, int32_t rssi) const;
+  size_t rankCredentials(CredentialEntry* out, int32_t* rssi, bool& scanned);
+  size_t scheduleCandidates(CredentialEntry* out, uint32_t* timeouts);
+  void recordConnectFailure(const String &ssid, uint8_t reason);
 
   //========================================================================
   // AP Mode and Captive Portal Functions
   //========================================================================
   void startAPMode();
   void stopAPMode();
+  class CaptiveProbeHandler;
   void setupCaptivePortal();
-  void handleRedirect();
+  void buildCaptiveResponse(const IPAddress& ip);
+  static bool matchCaptiveProbe(const String& path);
+  static WiFiProbeOs captiveProbeOs(const String& host, const String& path);
+  void handleRedirect(WiFiProbeOs os);
   bool isIp(const String& str);
 
   //========================================================================
@@ -210,15 +1180,50 @@ private:
   //========================================================================
   void handleSubmitCredentials();
   void handleWifiNetworks(); // Returns cached WiFi networks as JSON
+  void handleStatus();       // Returns the current status as JSON
+  void handleMetrics();      // Returns the metrics in Prometheus text format
+  size_t snapshotNetworks(uint32_t since, uint32_t& generation, bool& full);
+  void writeNetworksJson(AlooJsonWriter& json, size_t count, bool scanning, uint32_t generation, bool full);
+  void writeStatusJson(AlooJsonWriter& json);
+
+#ifdef ALOO_WM_ASYNC_SERVER
+  //========================================================================
+  // Asynchronous Web Server Backend
+  //========================================================================
+  void startAsyncServer();
+  void setupAsyncEndpoints();
+  void servePortalAsset(AsyncWebServerRequest* request, const WiFiPortalAsset& asset);
+  class AsyncCaptiveProbeHandler;
+  void handleRedirect(AsyncWebServerRequest* request, WiFiProbeOs os);
+  void handleSubmitCredentials(AsyncWebServerRequest* request);
+  void handleWifiNetworks(AsyncWebServerRequest* request);
+  void handleStatus(AsyncWebServerRequest* request);
+  void handleMetrics(AsyncWebServerRequest* request);
+#endif
 
   //========================================================================
   // Task Functions
   //========================================================================
   static void connectionManagerTask(void* param);
+  bool attemptConnection(const String &ssid, const String &password, const char* type, uint8_t budget,
+                         uint32_t firstTimeoutMs = 0);
+  static bool isCandidateFatal(uint8_t reason);
+  uint32_t computeBackoff(uint32_t initialMs, uint32_t maxMs, uint32_t retryIndex);
+  void reportAttempt(const String &ssid, const char* type, uint8_t attempt, uint32_t durationMs,
+                     uint32_t backoffMs, bool fast, bool success, uint8_t reason, uint32_t timeoutMs);
   static void serverTask(void* param);
+  static void dnsTask(void* param);
   static void monitorTask(void* param);
   static void scanTask(void* param);
-  bool hasInternetAccess();
+  void runScan();
+  void runReachabilityRound();
+  TickType_t scanIdleWait();
+  void performScan();
+  bool applyScanResults(const WiFiNetwork* results, size_t count, uint8_t channel);
+  uint8_t scannedChannel(const String& ssid);
+  void pushNetworkChanges();
+  bool hasNetworkListeners() const;
+  bool scanChannel(const WiFiScanOptions& options, uint8_t channel, size_t& count);
   void ensureAPModeActive();
 
   //========================================================================
@@ -227,9 +1232,17 @@ private:
   const char* wifiStatusToString(WiFiStatus status);
 
   //========================================================================
-  // Event-based WiFi Event Handler
+  // Event-based WiFi Event Handler and Dispatcher
   //========================================================================
   static void wifiEventHandler(WiFiEvent_t event, WiFiEventInfo_t info);
+  bool postEvent(EventChannel& channel, WiFiManagerEvent& event);
+  bool queueEvent(EventChannel& channel, const WiFiManagerEvent& event);
+  bool takeEvent(EventChannel& channel, WiFiManagerEvent& event);
+  bool takeLatchedEvent(EventChannel& channel, WiFiManagerEvent& event);
+  static void eventDispatcherTask(void* param);
+  static void notifierTask(void* param);
+  void handleEvent(const WiFiManagerEvent& event);
+  void publishEvent(const WiFiManagerEvent& event);
 };
 
 #endif // ALOO_WIFI_MANAGER_H
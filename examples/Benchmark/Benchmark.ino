@@ -0,0 +1,120 @@
+/*
+ * AlooWifiManager benchmark sketch.
+ *
+ * Measures the latency of the manager's task machinery on real hardware:
+ *   - time-to-connect  (begin() -> CONNECTED, served by connectionManagerTask)
+ *   - time-to-portal   (begin()/forceAPMode() -> AP_MODE_ACTIVE)
+ *   - time-to-scan     (portal up -> first non-empty /wifinetworks, scanTask)
+ *
+ * /status throughput (serverTask) is measured from an external client with
+ * tools/bench_status.py: requests issued over loopback from this CPU would
+ * compete with the server task and mostly time its poll delay. The sketch
+ * prints the URL to load once the portal is up.
+ *
+ * Every result is printed as a single "BENCH <key>=<value>" line so a CI job
+ * attached to a bench board can scrape the serial log and compare runs.
+ */
+#include <Arduino.h>
+#include "AlooWifiManager.h"
+
+static const uint32_t STATUS_WAIT_TIMEOUT_MS = 60000;
+static const uint32_t SCAN_WAIT_TIMEOUT_MS = 30000;
+
+WiFiManager wifiManager("ESP32-Bench", "", true);
+
+static void report(const char* key, long value) {
+  Serial.printf("BENCH %s=%ld\n", key, value);
+}
+
+/**
+ * @brief Polls the manager until it reaches one of the two given states.
+ * @return The reached state, or the last observed state on timeout.
+ */
+static WiFiStatus waitForStatus(WiFiStatus a, WiFiStatus b, uint32_t timeoutMs) {
+  uint32_t start = millis();
+  WiFiStatus status = wifiManager.getStatus();
+  while (status != a && status != b && millis() - start < timeoutMs) {
+    delay(5);
+    status = wifiManager.getStatus();
+  }
+  return status;
+}
+
+/**
+ * @brief Issues a single HTTP/1.1 GET against the portal and reads the reply.
+ * @return true when the server answered with 200.
+ */
+static bool httpGet(const IPAddress& ip, const char* path, String* body) {
+  WiFiClient client;
+  if (!client.connect(ip, 80, 1000)) return false;
+  client.printf("GET %s HTTP/1.1\r\nHost: %s\r\nConnection: close\r\n\r\n",
+                path, ip.toString().c_str());
+
+  String response;
+  uint32_t start = millis();
+  while ((client.connected() || client.available()) && millis() - start < 2000) {
+    while (client.available()) {
+      response += (char)client.read();
+    }
+    delay(1);
+  }
+  client.stop();
+
+  bool ok = response.startsWith("HTTP/1.1 200");
+  if (ok && body) {
+    int split = response.indexOf("\r\n\r\n");
+    *body = split >= 0 ? response.substring(split + 4) : String();
+  }
+  return ok;
+}
+
+static void benchmarkScan() {
+  IPAddress ip = WiFi.softAPIP();
+  uint32_t start = millis();
+  String body;
+  while (millis() - start < SCAN_WAIT_TIMEOUT_MS) {
+    if (httpGet(ip, "/wifinetworks", &body) && body.indexOf("\"ssid\"") >= 0) {
+      report("time_to_scan_ms", millis() - start);
+      return;
+    }
+    delay(50);
+  }
+  report("time_to_scan_ms", -1);
+}
+
+void setup() {
+  Serial.begin(115200);
+  delay(500);
+  Serial.println("BENCH start");
+
+  uint32_t t0 = millis();
+  wifiManager.begin(true, 1, 1);
+  WiFiStatus status = waitForStatus(WiFiStatus::CONNECTED, WiFiStatus::AP_MODE_ACTIVE,
+                                    STATUS_WAIT_TIMEOUT_MS);
+
+  if (status == WiFiStatus::CONNECTED) {
+    report("time_to_connect_ms", millis() - t0);
+    // Measure the STA -> portal transition from a connected state as well.
+    uint32_t t1 = millis();
+    wifiManager.forceAPMode();
+    status = waitForStatus(WiFiStatus::AP_MODE_ACTIVE, WiFiStatus::AP_MODE_ACTIVE,
+                           STATUS_WAIT_TIMEOUT_MS);
+    report("time_to_portal_forced_ms",
+           status == WiFiStatus::AP_MODE_ACTIVE ? (long)(millis() - t1) : -1);
+  } else if (status == WiFiStatus::AP_MODE_ACTIVE) {
+    report("time_to_connect_ms", -1);
+    report("time_to_portal_ms", millis() - t0);
+  } else {
+    Serial.println("BENCH error=no_connect_or_portal");
+    return;
+  }
+
+  benchmarkScan();
+  // The portal stays up for tools/bench_status.py on a host joined to the AP.
+  Serial.printf("BENCH status_url=http://%s/status\n", WiFi.softAPIP().toString().c_str());
+  Serial.println("BENCH done");
+}
+
+void loop() {
+  delay(1000);
+}
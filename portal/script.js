@@ -0,0 +1,82 @@
+function togglePassword() {
+  var x = document.getElementById('password');
+  if (x.type === 'password') { x.type = 'text'; } else { x.type = 'password'; }
+}
+
+// Scan results keyed by BSSID, kept in step with the device's scan generation.
+var networks = {};
+var generation = 0;
+var pollTimer = null;
+
+function applyDiff(data) {
+  if (data.full) { networks = {}; }
+  (data.networks || []).forEach(function(net) { networks[net.bssid] = net; });
+  (data.removed || []).forEach(function(bssid) { delete networks[bssid]; });
+  generation = data.generation;
+  renderNetworks();
+}
+
+function renderNetworks() {
+  // One row per SSID, showing its strongest access point.
+  var bySsid = {};
+  Object.keys(networks).forEach(function(bssid) {
+    var net = networks[bssid];
+    if (!bySsid[net.ssid] || net.rssi > bySsid[net.ssid].rssi) { bySsid[net.ssid] = net; }
+  });
+  var list = Object.keys(bySsid).map(function(ssid) { return bySsid[ssid]; });
+  list.sort(function(a, b) { return b.rssi - a.rssi; });
+
+  var networksDiv = document.getElementById('networks');
+  if (list.length === 0) {
+    networksDiv.innerHTML = '<p>No networks found. Please refresh.</p>';
+    return;
+  }
+  var ul = document.createElement('ul');
+  list.forEach(function(net) {
+    var li = document.createElement('li');
+    li.textContent = net.ssid + ' (' + net.rssi + ' dBm)';
+    li.onclick = function() {
+      document.getElementById('ssid').value = net.ssid;
+      document.getElementById('password').focus();
+    };
+    ul.appendChild(li);
+  });
+  networksDiv.innerHTML = '';
+  networksDiv.appendChild(ul);
+}
+
+function fetchNetworks(poll) {
+  fetch('/wifinetworks?since=' + generation)
+    .then(response => response.json())
+    .then(data => {
+      applyDiff(data);
+      if (data.scanning) { schedulePoll(1500); } else if (poll) { schedulePoll(10000); }
+    })
+    .catch(err => {
+      console.error('Error fetching networks: ', err);
+      if (poll) { schedulePoll(10000); }
+    });
+}
+
+function schedulePoll(ms) {
+  clearTimeout(pollTimer);
+  pollTimer = setTimeout(function() { fetchNetworks(true); }, ms);
+}
+
+function watchNetworks() {
+  fetchNetworks(false);
+  if (!window.EventSource) { schedulePoll(10000); return; }
+  // The async backend pushes diffs as scans land; the sync backend has no
+  // event stream, so the first error falls back to polling.
+  var source = new EventSource('/networkevents');
+  source.addEventListener('networks', function(e) {
+    var data = JSON.parse(e.data);
+    if (data.resync || data.since !== generation) { fetchNetworks(false); } else { applyDiff(data); }
+  });
+  source.onerror = function() {
+    source.close();
+    schedulePoll(10000);
+  };
+}
+
+if(document.getElementById('networks')) { window.onload = watchNetworks; }
@@ -0,0 +1,72 @@
+#ifndef ALOO_TEST_H
+#define ALOO_TEST_H
+
+//========================================================================
+// Host Test Harness
+//========================================================================
+// One executable per test file. TEST() registers a case, the CHECK macros
+// record a failure and carry on, and ALOO_TEST_MAIN() runs every case and
+// returns non-zero if any check failed, which is all ctest looks at.
+
+#include <Arduino.h>
+#include <cstdio>
+
+struct AlooTestCase {
+  const char* name;
+  void (*run)();
+  AlooTestCase* next;
+};
+
+inline AlooTestCase*& alooTestList() {
+  static AlooTestCase* head = nullptr;
+  return head;
+}
+
+inline int& alooTestFailures() {
+  static int failures = 0;
+  return failures;
+}
+
+struct AlooTestRegistrar {
+  AlooTestRegistrar(AlooTestCase& test) {
+    AlooTestCase** tail = &alooTestList();
+    while (*tail) tail = &(*tail)->next;
+    *tail = &test;
+  }
+};
+
+#define TEST(name)                                                            \
+  static void name();                                                         \
+  static AlooTestCase name##Case = { #name, name, nullptr };                  \
+  static AlooTestRegistrar name##Registrar(name##Case);                       \
+  static void name()
+
+#define CHECK(condition)                                                      \
+  do {                                                                        \
+    if (!(condition)) {                                                       \
+      fprintf(stderr, "%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #condition); \
+      alooTestFailures()++;                                                   \
+    }                                                                         \
+  } while (0)
+
+#define CHECK_EQ(expected, actual)                                            \
+  do {                                                                        \
+    long long e_ = (long long)(expected), a_ = (long long)(actual);           \
+    if (e_ != a_) {                                                           \
+      fprintf(stderr, "%s:%d: CHECK_EQ(%s, %s) failed: %lld != %lld\n",       \
+              __FILE__, __LINE__, #expected, #actual, e_, a_);                \
+      alooTestFailures()++;                                                   \
+    }                                                                         \
+  } while (0)
+
+#define ALOO_TEST_MAIN()                                                      \
+  int main() {                                                                \
+    for (AlooTestCase* test = alooTestList(); test; test = test->next) {      \
+      int before = alooTestFailures();                                        \
+      test->run();                                                            \
+      printf("[%s] %s\n", alooTestFailures() == before ? "PASS" : "FAIL", test->name); \
+    }                                                                         \
+    return alooTestFailures() ? 1 : 0;                                        \
+  }
+
+#endif // ALOO_TEST_H
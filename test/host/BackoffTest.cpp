@@ -0,0 +1,70 @@
+// computeBackoff(): exponential growth, the cap, and full jitter bounds.
+
+#include "AlooTest.h"
+#include "WiFiManagerTestAccess.h"
+
+static WiFiRetryPolicy fixedPolicy(float multiplier) {
+  WiFiRetryPolicy policy;
+  policy.multiplier = multiplier;
+  policy.fullJitter = false;
+  return policy;
+}
+
+TEST(DoublesUntilTheCap) {
+  WiFiManager manager;
+  manager.setRetryPolicy(fixedPolicy(2.0f));
+  CHECK_EQ(500, WiFiManagerTestAccess::computeBackoff(manager, 500, 30000, 0));
+  CHECK_EQ(1000, WiFiManagerTestAccess::computeBackoff(manager, 500, 30000, 1));
+  CHECK_EQ(2000, WiFiManagerTestAccess::computeBackoff(manager, 500, 30000, 2));
+  CHECK_EQ(16000, WiFiManagerTestAccess::computeBackoff(manager, 500, 30000, 5));
+  CHECK_EQ(30000, WiFiManagerTestAccess::computeBackoff(manager, 500, 30000, 6));
+  CHECK_EQ(30000, WiFiManagerTestAccess::computeBackoff(manager, 500, 30000, 1000));
+}
+
+TEST(InitialAboveTheCapIsCapped) {
+  WiFiManager manager;
+  manager.setRetryPolicy(fixedPolicy(2.0f));
+  CHECK_EQ(1000, WiFiManagerTestAccess::computeBackoff(manager, 5000, 1000, 0));
+  CHECK_EQ(1000, WiFiManagerTestAccess::computeBackoff(manager, 5000, 1000, 3));
+}
+
+TEST(FractionalMultiplier) {
+  WiFiManager manager;
+  manager.setRetryPolicy(fixedPolicy(1.5f));
+  CHECK_EQ(750, WiFiManagerTestAccess::computeBackoff(manager, 500, 30000, 1));
+  CHECK_EQ(1125, WiFiManagerTestAccess::computeBackoff(manager, 500, 30000, 2));
+}
+
+TEST(MultiplierBelowOneIsClamped) {
+  WiFiManager manager;
+  manager.setRetryPolicy(fixedPolicy(0.5f));
+  CHECK_EQ(500, WiFiManagerTestAccess::computeBackoff(manager, 500, 30000, 4));
+}
+
+TEST(FullJitterStaysWithinTheBackoff) {
+  WiFiManager manager;
+  WiFiRetryPolicy policy = fixedPolicy(2.0f);
+  policy.fullJitter = true;
+  manager.setRetryPolicy(policy);
+  uint32_t low = UINT32_MAX;
+  uint32_t high = 0;
+  for (int i = 0; i < 2000; i++) {
+    uint32_t backoff = WiFiManagerTestAccess::computeBackoff(manager, 500, 30000, 3);
+    low = min(low, backoff);
+    high = max(high, backoff);
+  }
+  CHECK(high <= 4000);
+  // Spread over the whole range, not clustered at the top like "equal jitter".
+  CHECK(low < 1000);
+  CHECK(high > 3000);
+}
+
+TEST(ZeroBackoffHasNoJitter) {
+  WiFiManager manager;
+  WiFiRetryPolicy policy = fixedPolicy(2.0f);
+  policy.fullJitter = true;
+  manager.setRetryPolicy(policy);
+  CHECK_EQ(0, WiFiManagerTestAccess::computeBackoff(manager, 0, 30000, 5));
+}
+
+ALOO_TEST_MAIN()
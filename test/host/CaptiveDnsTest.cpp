@@ -0,0 +1,184 @@
+// AlooCaptiveDns answers over loopback: A gets the portal address, AAAA and
+// HTTPS an empty NOERROR, other types NXDOMAIN, other opcodes NOTIMP, and
+// malformed packets nothing at all.
+
+#include "AlooTest.h"
+#include "AlooCaptiveDns.h"
+#include "AlooReachability.h"
+#include <lwip/sockets.h>
+#include <string>
+
+static const IPAddress PORTAL_IP(192, 168, 4, 1);
+
+// A captive responder on a free loopback port and a client socket aimed at it.
+class DnsFixture {
+public:
+  DnsFixture() : _client(-1), _port(0) {
+    for (int tries = 0; tries < 5 && !dns.isRunning(); tries++) {
+      _port = freePort();
+      dns.start(PORTAL_IP, _port);
+    }
+    _client = socket(AF_INET, SOCK_DGRAM, 0);
+    struct timeval timeout = { 0, 200000 };
+    setsockopt(_client, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+  }
+  ~DnsFixture() { close(_client); }
+
+  bool ready() const { return dns.isRunning() && _client >= 0; }
+
+  void send(const std::string& packet) {
+    struct sockaddr_in to = {};
+    to.sin_family = AF_INET;
+    to.sin_port = htons(_port);
+    to.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    sendto(_client, packet.data(), packet.size(), 0, (struct sockaddr*)&to, sizeof(to));
+  }
+
+  // Empty if no answer arrived.
+  std::string receive() {
+    char buf[512];
+    ssize_t n = recv(_client, buf, sizeof(buf), 0);
+    return n > 0 ? std::string(buf, (size_t)n) : std::string();
+  }
+
+  std::string exchange(const std::string& packet) {
+    send(packet);
+    dns.serve(100);
+    return receive();
+  }
+
+  AlooCaptiveDns dns;
+
+private:
+  int _client;
+  uint16_t _port;
+
+  static uint16_t freePort() {
+    int fd = socket(AF_INET, SOCK_DGRAM, 0);
+    struct sockaddr_in local = {};
+    local.sin_family = AF_INET;
+    local.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    bind(fd, (struct sockaddr*)&local, sizeof(local));
+    socklen_t length = sizeof(local);
+    getsockname(fd, (struct sockaddr*)&local, &length);
+    close(fd);
+    return ntohs(local.sin_port);
+  }
+};
+
+static std::string query(uint16_t id, const char* host, uint16_t qtype) {
+  uint8_t buf[300];
+  size_t length = buildDnsQuery(buf, sizeof(buf), id, host);
+  std::string packet((const char*)buf, length);
+  packet[length - 4] = (char)(qtype >> 8);
+  packet[length - 3] = (char)qtype;
+  return packet;
+}
+
+static uint8_t byteAt(const std::string& packet, size_t i) {
+  return i < packet.size() ? (uint8_t)packet[i] : 0;
+}
+
+static uint16_t count(const std::string& packet, size_t offset) {
+  return (uint16_t)((byteAt(packet, offset) << 8) | byteAt(packet, offset + 1));
+}
+
+TEST(AQueryGetsThePortalAddress) {
+  DnsFixture fixture;
+  CHECK(fixture.ready());
+  std::string request = query(0x1234, "connectivitycheck.gstatic.com", 1);
+  std::string answer = fixture.exchange(request);
+  CHECK_EQ(request.size() + 16, answer.size());
+  CHECK_EQ(0x85, byteAt(answer, 2));  // QR, AA, RD echoed
+  CHECK_EQ(0x80, byteAt(answer, 3));  // RA, NOERROR
+  CHECK_EQ(1, count(answer, 4));
+  CHECK_EQ(1, count(answer, 6));
+  uint32_t address = 0;
+  CHECK_EQ(1, parseDnsResponse((const uint8_t*)answer.data(), answer.size(), 0x1234, address));
+  CHECK_EQ((uint32_t)PORTAL_IP, address);
+  // TTL of the answer record.
+  size_t ttl = request.size() + 6;
+  CHECK_EQ(ALOO_DNS_TTL, (byteAt(answer, ttl) << 24) | (byteAt(answer, ttl + 1) << 16) |
+                         (byteAt(answer, ttl + 2) << 8) | byteAt(answer, ttl + 3));
+  CHECK_EQ(1, fixture.dns.stats().queries[(size_t)WiFiDnsQueryType::A]);
+}
+
+TEST(AaaaQueryIsAnsweredEmpty) {
+  DnsFixture fixture;
+  std::string request = query(7, "example.com", 28);
+  std::string answer = fixture.exchange(request);
+  CHECK_EQ(request.size(), answer.size());
+  CHECK_EQ(0x80, byteAt(answer, 3));  // NOERROR
+  CHECK_EQ(0, count(answer, 6));
+  CHECK_EQ(1, fixture.dns.stats().queries[(size_t)WiFiDnsQueryType::AAAA]);
+}
+
+TEST(HttpsQueryIsAnsweredEmpty) {
+  DnsFixture fixture;
+  std::string answer = fixture.exchange(query(8, "example.com", 65));
+  CHECK_EQ(0x80, byteAt(answer, 3));
+  CHECK_EQ(0, count(answer, 6));
+  CHECK_EQ(1, fixture.dns.stats().queries[(size_t)WiFiDnsQueryType::HTTPS]);
+}
+
+TEST(OtherQueryTypeGetsNxdomain) {
+  DnsFixture fixture;
+  std::string answer = fixture.exchange(query(9, "example.com", 16));  // TXT
+  CHECK_EQ(0x83, byteAt(answer, 3));
+  CHECK_EQ(0, count(answer, 6));
+  uint32_t address = 0;
+  CHECK_EQ(-1, parseDnsResponse((const uint8_t*)answer.data(), answer.size(), 9, address));
+  CHECK_EQ(1, fixture.dns.stats().queries[(size_t)WiFiDnsQueryType::OTHER]);
+}
+
+TEST(OtherOpcodeGetsNotimpHeaderOnly) {
+  DnsFixture fixture;
+  std::string request = query(10, "example.com", 1);
+  request[2] = (char)(2 << 3);  // STATUS
+  std::string answer = fixture.exchange(request);
+  CHECK_EQ(12, answer.size());
+  CHECK_EQ(0x84 | (2 << 3), byteAt(answer, 2));
+  CHECK_EQ(0x84, byteAt(answer, 3));
+  CHECK_EQ(0, count(answer, 4));
+}
+
+TEST(EdnsRecordIsNotEchoed) {
+  DnsFixture fixture;
+  std::string request = query(11, "example.com", 1);
+  request[11] = 1;  // ARCOUNT
+  const char opt[] = { 0, 0, 41, 0x10, 0, 0, 0, 0, 0, 0, 0 };
+  request.append(opt, sizeof(opt));
+  std::string answer = fixture.exchange(request);
+  CHECK_EQ(request.size() - sizeof(opt) + 16, answer.size());
+  CHECK_EQ(0, count(answer, 10));
+}
+
+TEST(MalformedPacketsAreDropped) {
+  DnsFixture fixture;
+  std::string truncated = query(12, "example.com", 1);
+  truncated.resize(truncated.size() - 2);
+  std::string response = query(13, "example.com", 1);
+  response[2] = (char)0x80;
+  std::string compressed = query(14, "example.com", 1);
+  compressed[12] = (char)0xC0;
+  std::string twoQuestions = query(15, "example.com", 1);
+  twoQuestions[5] = 2;
+  const std::string packets[] = { std::string(5, '\0'), truncated, response, compressed, twoQuestions };
+  for (const std::string& packet : packets) fixture.send(packet);
+  CHECK_EQ(0, fixture.dns.serve(100));
+  CHECK(fixture.receive().empty());
+  CHECK_EQ(5, fixture.dns.stats().dropped);
+}
+
+TEST(BurstIsAnsweredInOneServe) {
+  DnsFixture fixture;
+  for (uint16_t id = 0; id < 8; id++) fixture.send(query(id, "example.com", 1));
+  CHECK_EQ(8, fixture.dns.serve(100));
+  for (uint16_t id = 0; id < 8; id++) {
+    std::string answer = fixture.receive();
+    uint32_t address = 0;
+    CHECK_EQ(1, parseDnsResponse((const uint8_t*)answer.data(), answer.size(), id, address));
+  }
+}
+
+ALOO_TEST_MAIN()
@@ -0,0 +1,110 @@
+// buildDnsQuery() and parseDnsResponse() from the reachability prober.
+
+#include "AlooTest.h"
+#include "AlooReachability.h"
+#include <string>
+
+// Response to query id for example.com with the given header bytes 2-3 and
+// answer records appended verbatim.
+static std::string response(uint16_t id, uint16_t answers, const std::string& records,
+                            uint8_t flags = 0x81, uint8_t rcode = 0x80) {
+  uint8_t buf[64];
+  size_t length = buildDnsQuery(buf, sizeof(buf), id, "example.com");
+  std::string packet((const char*)buf, length);
+  packet[2] = (char)flags;
+  packet[3] = (char)rcode;
+  packet[6] = (char)(answers >> 8);
+  packet[7] = (char)answers;
+  return packet + records;
+}
+
+// Answer record: name pointer to the question, type, class IN, TTL, data.
+static std::string record(uint16_t type, const std::string& data) {
+  std::string r = { (char)0xC0, 0x0C, (char)(type >> 8), (char)type, 0, 1, 0, 0, 0, 60 };
+  r += (char)(data.size() >> 8);
+  r += (char)data.size();
+  return r + data;
+}
+
+static int parse(const std::string& packet, uint16_t id, uint32_t& address) {
+  return parseDnsResponse((const uint8_t*)packet.data(), packet.size(), id, address);
+}
+
+static const std::string ADDRESS = { 93, (char)184, (char)216, 34 };
+
+TEST(QueryEncodesLabels) {
+  uint8_t buf[64];
+  size_t length = buildDnsQuery(buf, sizeof(buf), 0xBEEF, "www.example.com");
+  const uint8_t expected[] = {
+    0xBE, 0xEF, 0x01, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    3, 'w', 'w', 'w', 7, 'e', 'x', 'a', 'm', 'p', 'l', 'e', 3, 'c', 'o', 'm', 0,
+    0x00, 0x01, 0x00, 0x01
+  };
+  CHECK_EQ(sizeof(expected), length);
+  CHECK(memcmp(buf, expected, sizeof(expected)) == 0);
+}
+
+TEST(QueryRejectsBadNames) {
+  uint8_t buf[300];
+  CHECK_EQ(0, buildDnsQuery(buf, sizeof(buf), 1, ""));
+  CHECK_EQ(0, buildDnsQuery(buf, sizeof(buf), 1, "a..b"));
+  std::string longLabel(64, 'a');
+  CHECK_EQ(0, buildDnsQuery(buf, sizeof(buf), 1, longLabel.c_str()));
+  CHECK_EQ(0, buildDnsQuery(buf, 20, 1, "example.com"));
+}
+
+TEST(FindsTheARecord) {
+  uint32_t address = 0;
+  CHECK_EQ(1, parse(response(42, 1, record(1, ADDRESS)), 42, address));
+  CHECK(memcmp(&address, ADDRESS.data(), 4) == 0);
+}
+
+TEST(SkipsRecordsBeforeTheARecord) {
+  std::string cname = record(5, std::string("\x03" "cdn\xC0\x0C", 6));
+  uint32_t address = 0;
+  CHECK_EQ(1, parse(response(42, 2, cname + record(1, ADDRESS)), 42, address));
+  CHECK(memcmp(&address, ADDRESS.data(), 4) == 0);
+}
+
+TEST(IgnoresAnswersToOtherQueries) {
+  uint32_t address = 0;
+  CHECK_EQ(0, parse(response(42, 1, record(1, ADDRESS)), 43, address));
+  // QR clear: a query, not a response.
+  CHECK_EQ(0, parse(response(42, 1, record(1, ADDRESS), 0x01), 42, address));
+  CHECK_EQ(0, parse(std::string(11, '\0'), 0, address));
+}
+
+TEST(FailsOnErrorCodes) {
+  uint32_t address = 0;
+  CHECK_EQ(-1, parse(response(42, 0, std::string(), 0x81, 0x83), 42, address));  // NXDOMAIN
+  CHECK_EQ(-1, parse(response(42, 0, std::string(), 0x81, 0x82), 42, address));  // SERVFAIL
+}
+
+TEST(FailsWithoutAnARecord) {
+  uint32_t address = 0;
+  CHECK_EQ(-1, parse(response(42, 0, std::string()), 42, address));
+  std::string aaaa = record(28, std::string(16, '\x01'));
+  CHECK_EQ(-1, parse(response(42, 1, aaaa), 42, address));
+  // Type A with the wrong length is not an IPv4 address.
+  CHECK_EQ(-1, parse(response(42, 1, record(1, ADDRESS + "x")), 42, address));
+}
+
+TEST(FailsOnTruncatedPackets) {
+  std::string full = response(42, 1, record(1, ADDRESS));
+  uint32_t address = 0;
+  // Every cut inside the question or answer fails cleanly.
+  for (size_t length = 12; length < full.size(); length++) {
+    if (parse(full.substr(0, length), 42, address) != -1) {
+      fprintf(stderr, "length %zu\n", length);
+      CHECK(false);
+    }
+  }
+}
+
+TEST(FailsOnAnswerCountBeyondThePacket) {
+  uint32_t address = 0;
+  std::string aaaa = record(28, std::string(16, '\x01'));
+  CHECK_EQ(-1, parse(response(42, 3, aaaa), 42, address));
+}
+
+ALOO_TEST_MAIN()
@@ -0,0 +1,140 @@
+// queueEvent()/takeEvent(): an overflowing queue latches events per type,
+// merges repeats, and hands latches out oldest first after the queue.
+
+#include "AlooTest.h"
+#include "WiFiManagerTestAccess.h"
+
+static WiFiManagerEvent makeEvent(WiFiManagerEventType type, uint32_t timestampMs) {
+  WiFiManagerEvent event = {};
+  event.type = type;
+  event.timestampMs = timestampMs;
+  return event;
+}
+
+static WiFiManagerEvent statusEvent(WiFiStatus previous, WiFiStatus status, uint32_t timestampMs) {
+  WiFiManagerEvent event = makeEvent(WiFiManagerEventType::STATUS_CHANGED, timestampMs);
+  event.previous = previous;
+  event.status = status;
+  return event;
+}
+
+// Takes the next real event, skipping wake-up records.
+static bool next(WiFiManager& manager, WiFiManagerEvent& event) {
+  while (WiFiManagerTestAccess::takeEvent(manager, event)) {
+    if (event.type < WiFiManagerEventType::COUNT) return true;
+  }
+  return false;
+}
+
+static void fillQueue(WiFiManager& manager) {
+  for (uint32_t i = 0; i < ALOO_WM_EVENT_QUEUE_LENGTH; i++) {
+    CHECK(WiFiManagerTestAccess::queueEvent(manager, makeEvent(WiFiManagerEventType::SCAN_DONE, i)));
+  }
+}
+
+static uint32_t coalesced(WiFiManager& manager) {
+  WiFiMetricsSnapshot metrics;
+  manager.getMetrics(metrics);
+  return metrics.eventsCoalesced;
+}
+
+TEST(QueuedEventsKeepTheirOrder) {
+  WiFiManager manager;
+  CHECK(WiFiManagerTestAccess::queueEvent(manager, makeEvent(WiFiManagerEventType::STA_CONNECTED, 1)));
+  CHECK(WiFiManagerTestAccess::queueEvent(manager, makeEvent(WiFiManagerEventType::GOT_IP, 2)));
+  WiFiManagerEvent event;
+  CHECK(next(manager, event) && event.type == WiFiManagerEventType::STA_CONNECTED);
+  CHECK(next(manager, event) && event.type == WiFiManagerEventType::GOT_IP);
+  CHECK(!next(manager, event));
+}
+
+TEST(LatchedEventsFollowTheQueue) {
+  WiFiManager manager;
+  fillQueue(manager);
+  CHECK(!WiFiManagerTestAccess::queueEvent(manager, makeEvent(WiFiManagerEventType::GOT_IP, 100)));
+  WiFiManagerEvent event;
+  for (uint32_t i = 0; i < ALOO_WM_EVENT_QUEUE_LENGTH; i++) {
+    CHECK(next(manager, event));
+    CHECK(event.type == WiFiManagerEventType::SCAN_DONE);
+    CHECK_EQ(i, event.timestampMs);
+  }
+  CHECK(next(manager, event) && event.type == WiFiManagerEventType::GOT_IP);
+  CHECK(!next(manager, event));
+}
+
+TEST(LatchedEventsAreTakenOldestFirst) {
+  WiFiManager manager;
+  fillQueue(manager);
+  CHECK(!WiFiManagerTestAccess::queueEvent(manager, makeEvent(WiFiManagerEventType::DISCONNECTED, 200)));
+  CHECK(!WiFiManagerTestAccess::queueEvent(manager, makeEvent(WiFiManagerEventType::STA_CONNECTED, 300)));
+  CHECK(!WiFiManagerTestAccess::queueEvent(manager, makeEvent(WiFiManagerEventType::GOT_IP, 400)));
+  WiFiManagerEvent event;
+  for (uint32_t i = 0; i < ALOO_WM_EVENT_QUEUE_LENGTH; i++) CHECK(next(manager, event));
+  // Type order is STA_CONNECTED, GOT_IP, DISCONNECTED; time order wins.
+  CHECK(next(manager, event) && event.type == WiFiManagerEventType::DISCONNECTED);
+  CHECK(next(manager, event) && event.type == WiFiManagerEventType::STA_CONNECTED);
+  CHECK(next(manager, event) && event.type == WiFiManagerEventType::GOT_IP);
+  CHECK(!next(manager, event));
+}
+
+TEST(NewEventsLatchBehindALatchedOne) {
+  WiFiManager manager;
+  fillQueue(manager);
+  CHECK(!WiFiManagerTestAccess::queueEvent(manager, makeEvent(WiFiManagerEventType::DISCONNECTED, 200)));
+  WiFiManagerEvent event;
+  CHECK(next(manager, event));  // Frees a queue slot
+  // Queueing now would overtake the latched DISCONNECTED.
+  CHECK(!WiFiManagerTestAccess::queueEvent(manager, makeEvent(WiFiManagerEventType::STA_CONNECTED, 300)));
+  for (uint32_t i = 1; i < ALOO_WM_EVENT_QUEUE_LENGTH; i++) CHECK(next(manager, event));
+  CHECK(next(manager, event) && event.type == WiFiManagerEventType::DISCONNECTED);
+  CHECK(next(manager, event) && event.type == WiFiManagerEventType::STA_CONNECTED);
+}
+
+TEST(RepeatsMergeIntoTheNewest) {
+  WiFiManager manager;
+  fillQueue(manager);
+  uint32_t before = coalesced(manager);
+  WiFiManagerEvent first = makeEvent(WiFiManagerEventType::DISCONNECTED, 200);
+  first.reason = 2;
+  WiFiManagerEvent second = makeEvent(WiFiManagerEventType::DISCONNECTED, 300);
+  second.reason = 201;
+  CHECK(!WiFiManagerTestAccess::queueEvent(manager, first));
+  CHECK(!WiFiManagerTestAccess::queueEvent(manager, second));
+  CHECK_EQ(before + 1, coalesced(manager));
+  WiFiManagerEvent event;
+  for (uint32_t i = 0; i < ALOO_WM_EVENT_QUEUE_LENGTH; i++) CHECK(next(manager, event));
+  CHECK(next(manager, event) && event.type == WiFiManagerEventType::DISCONNECTED);
+  CHECK_EQ(201, event.reason);
+  CHECK_EQ(300, event.timestampMs);
+  CHECK(!next(manager, event));
+}
+
+TEST(MergedStatusChangeKeepsTheFirstPrevious) {
+  WiFiManager manager;
+  fillQueue(manager);
+  CHECK(!WiFiManagerTestAccess::queueEvent(
+      manager, statusEvent(WiFiStatus::CONNECTED, WiFiStatus::DISCONNECTED, 200)));
+  CHECK(!WiFiManagerTestAccess::queueEvent(
+      manager, statusEvent(WiFiStatus::DISCONNECTED, WiFiStatus::TRYING_TO_CONNECT, 300)));
+  CHECK(!WiFiManagerTestAccess::queueEvent(
+      manager, statusEvent(WiFiStatus::TRYING_TO_CONNECT, WiFiStatus::AP_MODE_ACTIVE, 400)));
+  WiFiManagerEvent event;
+  for (uint32_t i = 0; i < ALOO_WM_EVENT_QUEUE_LENGTH; i++) CHECK(next(manager, event));
+  CHECK(next(manager, event) && event.type == WiFiManagerEventType::STATUS_CHANGED);
+  CHECK(event.previous == WiFiStatus::CONNECTED);
+  CHECK(event.status == WiFiStatus::AP_MODE_ACTIVE);
+  CHECK(!next(manager, event));
+}
+
+TEST(TimestampOrderSurvivesWraparound) {
+  WiFiManager manager;
+  fillQueue(manager);
+  CHECK(!WiFiManagerTestAccess::queueEvent(manager, makeEvent(WiFiManagerEventType::GOT_IP, 0xFFFFFFF0u)));
+  CHECK(!WiFiManagerTestAccess::queueEvent(manager, makeEvent(WiFiManagerEventType::STA_CONNECTED, 0x10)));
+  WiFiManagerEvent event;
+  for (uint32_t i = 0; i < ALOO_WM_EVENT_QUEUE_LENGTH; i++) CHECK(next(manager, event));
+  CHECK(next(manager, event) && event.type == WiFiManagerEventType::GOT_IP);
+  CHECK(next(manager, event) && event.type == WiFiManagerEventType::STA_CONNECTED);
+}
+
+ALOO_TEST_MAIN()
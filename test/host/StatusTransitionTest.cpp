@@ -0,0 +1,73 @@
+// The status transition table and updateStatus() around it.
+
+#include "AlooTest.h"
+#include "WiFiManagerTestAccess.h"
+
+static const WiFiStatus ALL_STATES[] = {
+  WiFiStatus::INITIALIZING, WiFiStatus::TRYING_TO_CONNECT, WiFiStatus::AP_MODE_ACTIVE,
+  WiFiStatus::CONNECTED, WiFiStatus::DISCONNECTED, WiFiStatus::NO_INTERNET
+};
+
+static bool isLinkState(WiFiStatus status) {
+  return status == WiFiStatus::TRYING_TO_CONNECT || status == WiFiStatus::AP_MODE_ACTIVE ||
+         status == WiFiStatus::CONNECTED || status == WiFiStatus::DISCONNECTED;
+}
+
+TEST(TableMatchesTheDocumentedRules) {
+  for (WiFiStatus from : ALL_STATES) {
+    for (WiFiStatus to : ALL_STATES) {
+      // Every state may move to a link state; NO_INTERNET only follows CONNECTED.
+      bool expected = isLinkState(to) || (from == WiFiStatus::CONNECTED && to == WiFiStatus::NO_INTERNET);
+      if (WiFiManagerTestAccess::isTransitionAllowed(from, to) != expected) {
+        fprintf(stderr, "transition %d -> %d\n", (int)from, (int)to);
+        CHECK(false);
+      }
+    }
+  }
+}
+
+TEST(InitializingIsNeverReentered) {
+  for (WiFiStatus from : ALL_STATES) {
+    CHECK(!WiFiManagerTestAccess::isTransitionAllowed(from, WiFiStatus::INITIALIZING));
+  }
+}
+
+TEST(AcceptedTransitionMovesStatusAndBits) {
+  WiFiManager manager;
+  CHECK(manager.getStatus() == WiFiStatus::INITIALIZING);
+  CHECK_EQ(WiFiManagerTestAccess::stateBit(WiFiStatus::INITIALIZING), WiFiManagerTestAccess::stateBits(manager));
+  CHECK(WiFiManagerTestAccess::updateStatus(manager, WiFiStatus::CONNECTED));
+  CHECK(WiFiManagerTestAccess::updateStatus(manager, WiFiStatus::NO_INTERNET));
+  CHECK(manager.getStatus() == WiFiStatus::NO_INTERNET);
+  CHECK_EQ(WiFiManagerTestAccess::stateBit(WiFiStatus::NO_INTERNET), WiFiManagerTestAccess::stateBits(manager));
+}
+
+TEST(RejectedTransitionLeavesStatusAndBits) {
+  WiFiManager manager;
+  CHECK(WiFiManagerTestAccess::updateStatus(manager, WiFiStatus::DISCONNECTED));
+  // A late internet probe must not report NO_INTERNET on a dropped link.
+  CHECK(!WiFiManagerTestAccess::updateStatus(manager, WiFiStatus::NO_INTERNET));
+  CHECK(manager.getStatus() == WiFiStatus::DISCONNECTED);
+  CHECK_EQ(WiFiManagerTestAccess::stateBit(WiFiStatus::DISCONNECTED), WiFiManagerTestAccess::stateBits(manager));
+}
+
+TEST(SameStatusIsANoOp) {
+  WiFiManager manager;
+  CHECK(WiFiManagerTestAccess::updateStatus(manager, WiFiStatus::CONNECTED));
+  WiFiManagerEvent event;
+  while (WiFiManagerTestAccess::takeNotification(manager, event)) {}
+  CHECK(WiFiManagerTestAccess::updateStatus(manager, WiFiStatus::CONNECTED));
+  CHECK(!WiFiManagerTestAccess::takeNotification(manager, event));
+}
+
+TEST(TransitionPublishesStatusChanged) {
+  WiFiManager manager;
+  CHECK(WiFiManagerTestAccess::updateStatus(manager, WiFiStatus::TRYING_TO_CONNECT));
+  WiFiManagerEvent event;
+  CHECK(WiFiManagerTestAccess::takeNotification(manager, event));
+  CHECK(event.type == WiFiManagerEventType::STATUS_CHANGED);
+  CHECK(event.previous == WiFiStatus::INITIALIZING);
+  CHECK(event.status == WiFiStatus::TRYING_TO_CONNECT);
+}
+
+ALOO_TEST_MAIN()
@@ -0,0 +1,252 @@
+// The single stored record: CRC and version checks on load, and migration
+// from the older one-key-per-field layout.
+
+#include "AlooTest.h"
+#include "WiFiManagerTestAccess.h"
+#include <Preferences.h>
+#include <string>
+
+typedef WiFiManagerTestAccess Access;
+
+static const char NAMESPACE[] = "wifimanager";
+static const char STATE_KEY[] = "state";
+static const char* const LEGACY_KEYS[] = {
+  "last_ssid", "last_pass", "last_bssid", "last_chan", "last_lease", "cred_table"
+};
+
+// Reference CRC-32 (IEEE 802.3), independent of the library's.
+static uint32_t crc32(const uint8_t* data, size_t length) {
+  uint32_t crc = 0xFFFFFFFF;
+  for (size_t i = 0; i < length; i++) {
+    crc ^= data[i];
+    for (int bit = 0; bit < 8; bit++) crc = (crc & 1) ? (crc >> 1) ^ 0xEDB88320 : crc >> 1;
+  }
+  return ~crc;
+}
+
+static std::string readRecord() {
+  Preferences preferences;
+  std::string blob;
+  if (!preferences.begin(NAMESPACE, true)) return blob;
+  blob.resize(preferences.getBytesLength(STATE_KEY));
+  if (!blob.empty()) preferences.getBytes(STATE_KEY, &blob[0], blob.size());
+  preferences.end();
+  return blob;
+}
+
+static void writeRecord(const std::string& blob) {
+  Preferences preferences;
+  preferences.begin(NAMESPACE, false);
+  preferences.putBytes(STATE_KEY, blob.data(), blob.size());
+  preferences.end();
+}
+
+static uint32_t storedCrc(const std::string& blob) {
+  uint32_t crc;
+  memcpy(&crc, blob.data() + Access::RECORD_CRC_OFFSET, sizeof(crc));
+  return crc;
+}
+
+static void sealRecord(std::string& blob) {
+  uint32_t crc = crc32((const uint8_t*)blob.data(), Access::RECORD_CRC_OFFSET);
+  memcpy(&blob[Access::RECORD_CRC_OFFSET], &crc, sizeof(crc));
+}
+
+static bool hasKey(const char* key) {
+  Preferences preferences;
+  if (!preferences.begin(NAMESPACE, true)) return false;
+  bool found = preferences.isKey(key);
+  preferences.end();
+  return found;
+}
+
+static void writeLegacyNetwork(const char* ssid, const char* password) {
+  Preferences preferences;
+  preferences.begin(NAMESPACE, false);
+  preferences.putString("last_ssid", ssid);
+  preferences.putString("last_pass", password);
+  const uint8_t bssid[6] = { 0x02, 0x11, 0x22, 0x33, 0x44, 0x55 };
+  preferences.putBytes("last_bssid", bssid, sizeof(bssid));
+  preferences.putUChar("last_chan", 6);
+  preferences.end();
+}
+
+// Stores home/secret123 as a valid record and returns it.
+static std::string storeValidRecord() {
+  hostPreferencesErase();
+  {
+    WiFiManager manager;
+    CHECK(manager.addCredentials("home", "secret123"));
+    CHECK(manager.flushStorage());
+  }
+  return readRecord();
+}
+
+TEST(WrittenRecordCarriesVersionSizeAndCrc) {
+  std::string blob = storeValidRecord();
+  CHECK_EQ(Access::RECORD_SIZE, blob.size());
+  if (blob.size() != Access::RECORD_SIZE) return;
+  uint16_t version, size;
+  memcpy(&version, blob.data(), sizeof(version));
+  memcpy(&size, blob.data() + sizeof(version), sizeof(size));
+  CHECK_EQ(Access::RECORD_VERSION, version);
+  CHECK_EQ(Access::RECORD_SIZE, size);
+  CHECK_EQ(crc32((const uint8_t*)blob.data(), Access::RECORD_CRC_OFFSET), storedCrc(blob));
+}
+
+TEST(ValidRecordIsLoaded) {
+  storeValidRecord();
+  WiFiManager manager;
+  CHECK_EQ(1, manager.getStoredNetworkCount());
+}
+
+TEST(UnchangedStateIsNotRewritten) {
+  std::string before = storeValidRecord();
+  {
+    WiFiManager manager;
+    // Same credentials again: dirty, but the record would be identical.
+    CHECK(manager.addCredentials("home", "secret123"));
+    CHECK(manager.flushStorage());
+    WiFiMetricsSnapshot metrics;
+    manager.getMetrics(metrics);
+    CHECK_EQ(0, metrics.storageWrites);
+    CHECK_EQ(1, metrics.storageWritesSkipped);
+  }
+  CHECK(readRecord() == before);
+}
+
+TEST(EachWriteBumpsTheGeneration) {
+  std::string first = storeValidRecord();
+  {
+    WiFiManager manager;
+    CHECK(manager.addCredentials("office", "hunter22"));
+    CHECK(manager.flushStorage());
+  }
+  std::string second = readRecord();
+  uint32_t a, b;
+  memcpy(&a, first.data() + Access::RECORD_GENERATION_OFFSET, sizeof(a));
+  memcpy(&b, second.data() + Access::RECORD_GENERATION_OFFSET, sizeof(b));
+  CHECK_EQ(a + 1, b);
+  CHECK_EQ(crc32((const uint8_t*)second.data(), Access::RECORD_CRC_OFFSET), storedCrc(second));
+}
+
+TEST(CorruptRecordIsIgnored) {
+  std::string blob = storeValidRecord();
+  blob[Access::RECORD_SSID_OFFSET] ^= 0x01;  // "home" -> "iome", CRC left stale
+  writeRecord(blob);
+  WiFiManager manager;
+  CHECK_EQ(0, manager.getStoredNetworkCount());
+  String ssid, password;
+  CHECK(!Access::loadLastCredentials(manager, ssid, password));
+}
+
+TEST(CorruptCrcIsIgnored) {
+  std::string blob = storeValidRecord();
+  blob[Access::RECORD_CRC_OFFSET] ^= 0x80;
+  writeRecord(blob);
+  WiFiManager manager;
+  CHECK_EQ(0, manager.getStoredNetworkCount());
+}
+
+TEST(OtherVersionIsIgnored) {
+  std::string blob = storeValidRecord();
+  uint16_t version = Access::RECORD_VERSION + 1;
+  memcpy(&blob[0], &version, sizeof(version));
+  sealRecord(blob);
+  writeRecord(blob);
+  WiFiManager manager;
+  CHECK_EQ(0, manager.getStoredNetworkCount());
+}
+
+TEST(TruncatedRecordIsIgnored) {
+  std::string blob = storeValidRecord();
+  writeRecord(blob.substr(0, blob.size() - 8));
+  WiFiManager manager;
+  CHECK_EQ(0, manager.getStoredNetworkCount());
+}
+
+TEST(LegacyNetworkIsMigrated) {
+  hostPreferencesErase();
+  writeLegacyNetwork("home", "secret123");
+  {
+    WiFiManager manager;
+    String ssid, password;
+    CHECK(Access::loadLastCredentials(manager, ssid, password));
+    CHECK(ssid == "home");
+    CHECK(password == "secret123");
+    // The single-network layout seeds the known-network table.
+    CHECK_EQ(1, manager.getStoredNetworkCount());
+    CHECK(manager.flushStorage());
+  }
+  CHECK(hasKey(STATE_KEY));
+  for (const char* key : LEGACY_KEYS) {
+    if (hasKey(key)) {
+      fprintf(stderr, "legacy key %s left behind\n", key);
+      CHECK(false);
+    }
+  }
+
+  // Reloaded from the record alone.
+  WiFiManager manager;
+  String ssid, password;
+  CHECK(Access::loadLastCredentials(manager, ssid, password));
+  CHECK(ssid == "home");
+  CHECK(password == "secret123");
+  CHECK_EQ(1, manager.getStoredNetworkCount());
+}
+
+TEST(LegacyTableIsMigrated) {
+  hostPreferencesErase();
+  writeLegacyNetwork("home", "secret123");
+  Access::CredentialTable table;
+  memset(&table, 0, sizeof(table));
+  table.version = Access::CREDENTIAL_TABLE_VERSION;
+  table.count = 2;
+  strlcpy(table.entries[0].ssid, "home", sizeof(table.entries[0].ssid));
+  strlcpy(table.entries[0].password, "secret123", sizeof(table.entries[0].password));
+  strlcpy(table.entries[1].ssid, "office", sizeof(table.entries[1].ssid));
+  strlcpy(table.entries[1].password, "hunter22", sizeof(table.entries[1].password));
+  {
+    Preferences preferences;
+    preferences.begin(NAMESPACE, false);
+    preferences.putBytes("cred_table", &table, sizeof(table));
+    preferences.end();
+  }
+  {
+    WiFiManager manager;
+    CHECK_EQ(2, manager.getStoredNetworkCount());
+  }
+  // The destructor's flush wrote the record and dropped the table key.
+  CHECK(!hasKey("cred_table"));
+  WiFiManager manager;
+  CHECK_EQ(2, manager.getStoredNetworkCount());
+}
+
+TEST(LegacyTableOfAnotherVersionIsDropped) {
+  hostPreferencesErase();
+  Access::CredentialTable table;
+  memset(&table, 0, sizeof(table));
+  table.version = Access::CREDENTIAL_TABLE_VERSION + 1;
+  table.count = 1;
+  strlcpy(table.entries[0].ssid, "office", sizeof(table.entries[0].ssid));
+  {
+    Preferences preferences;
+    preferences.begin(NAMESPACE, false);
+    preferences.putBytes("cred_table", &table, sizeof(table));
+    preferences.end();
+  }
+  WiFiManager manager;
+  CHECK_EQ(0, manager.getStoredNetworkCount());
+}
+
+TEST(EmptyFlashStartsEmpty) {
+  hostPreferencesErase();
+  {
+    WiFiManager manager;
+    CHECK_EQ(0, manager.getStoredNetworkCount());
+  }
+  // Nothing to migrate, so nothing is written.
+  CHECK(!hasKey(STATE_KEY));
+}
+
+ALOO_TEST_MAIN()
@@ -0,0 +1,65 @@
+#ifndef WIFI_MANAGER_TEST_ACCESS_H
+#define WIFI_MANAGER_TEST_ACCESS_H
+
+//========================================================================
+// WiFiManager Test Access
+//========================================================================
+// The private internals the host tests exercise directly; WiFiManager
+// declares this struct a friend.
+
+#include "AlooWifiManager.h"
+#include <cstddef>
+
+struct WiFiManagerTestAccess {
+  static uint32_t computeBackoff(WiFiManager& manager, uint32_t initialMs, uint32_t maxMs, uint32_t retryIndex) {
+    return manager.computeBackoff(initialMs, maxMs, retryIndex);
+  }
+
+  static bool isTransitionAllowed(WiFiStatus from, WiFiStatus to) {
+    return WiFiManager::isTransitionAllowed(from, to);
+  }
+
+  static bool updateStatus(WiFiManager& manager, WiFiStatus status) {
+    return manager.updateStatus(status);
+  }
+
+  static EventBits_t stateBits(WiFiManager& manager) {
+    return xEventGroupGetBits(manager._stateEvents) & WiFiManager::ALL_STATE_BITS;
+  }
+
+  static EventBits_t stateBit(WiFiStatus status) {
+    return WiFiManager::stateBit(status);
+  }
+
+  // The WiFi event channel; nothing consumes it on the host.
+  static bool queueEvent(WiFiManager& manager, const WiFiManagerEvent& event) {
+    return manager.queueEvent(manager._events, event);
+  }
+
+  // Non-blocking take: false once the queue and the latches are empty.
+  static bool takeEvent(WiFiManager& manager, WiFiManagerEvent& event) {
+    if (!uxQueueMessagesWaiting(manager._events.queue) && !manager._events.latchedMask) return false;
+    return manager.takeEvent(manager._events, event);
+  }
+
+  // The notification channel, fed by updateStatus().
+  static bool takeNotification(WiFiManager& manager, WiFiManagerEvent& event) {
+    if (!uxQueueMessagesWaiting(manager._notifications.queue) && !manager._notifications.latchedMask) return false;
+    return manager.takeEvent(manager._notifications, event);
+  }
+
+  static bool loadLastCredentials(WiFiManager& manager, String& ssid, String& password) {
+    return manager.loadLastCredentials(ssid, password);
+  }
+
+  // Storage layout, for writing legacy keys and inspecting the stored record.
+  typedef WiFiManager::CredentialTable CredentialTable;
+  static constexpr uint8_t CREDENTIAL_TABLE_VERSION = WiFiManager::CREDENTIAL_TABLE_VERSION;
+  static constexpr uint16_t RECORD_VERSION = WiFiManager::PERSISTENT_RECORD_VERSION;
+  static constexpr size_t RECORD_SIZE = sizeof(WiFiManager::PersistentRecord);
+  static constexpr size_t RECORD_GENERATION_OFFSET = offsetof(WiFiManager::PersistentRecord, generation);
+  static constexpr size_t RECORD_SSID_OFFSET = offsetof(WiFiManager::PersistentRecord, lastSsid);
+  static constexpr size_t RECORD_CRC_OFFSET = offsetof(WiFiManager::PersistentRecord, crc);
+};
+
+#endif // WIFI_MANAGER_TEST_ACCESS_H
@@ -0,0 +1,147 @@
+#ifndef ALOO_HOST_ARDUINO_H
+#define ALOO_HOST_ARDUINO_H
+
+//========================================================================
+// Host Arduino Shim
+//========================================================================
+// Just enough of the ESP32 Arduino core for the library to compile and run
+// on a Linux host: String, Print, IPAddress and the timing functions. Time
+// comes from the host's monotonic clock.
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <cstdio>
+#include <cstdlib>
+#include <cctype>
+#include <string>
+#include <algorithm>
+#include <time.h>
+
+using std::min;
+using std::max;
+
+#define PROGMEM
+#define PGM_P const char*
+#define F(x) (x)
+#define snprintf_P snprintf
+#define IRAM_ATTR
+typedef bool boolean;
+
+class String {
+public:
+  String() {}
+  String(const char* s) : _s(s ? s : "") {}
+  String(const std::string& s) : _s(s) {}
+  explicit String(int v) : _s(std::to_string(v)) {}
+  explicit String(unsigned v) : _s(std::to_string(v)) {}
+  explicit String(long v) : _s(std::to_string(v)) {}
+  explicit String(unsigned long v) : _s(std::to_string(v)) {}
+
+  const char* c_str() const { return _s.c_str(); }
+  unsigned int length() const { return (unsigned int)_s.size(); }
+  bool isEmpty() const { return _s.empty(); }
+  char operator[](unsigned int i) const { return i < _s.size() ? _s[i] : '\0'; }
+  int indexOf(char c) const { return find(_s.find(c)); }
+  int indexOf(const char* s) const { return find(_s.find(s)); }
+  String substring(unsigned int from) const { return from < _s.size() ? String(_s.substr(from)) : String(); }
+  String substring(unsigned int from, unsigned int to) const {
+    return from < to && from < _s.size() ? String(_s.substr(from, to - from)) : String();
+  }
+  bool startsWith(const String& prefix) const { return _s.compare(0, prefix._s.size(), prefix._s) == 0; }
+  bool equals(const String& other) const { return _s == other._s; }
+  bool equalsIgnoreCase(const String& other) const { return strcasecmp(c_str(), other.c_str()) == 0; }
+  void toLowerCase() { for (char& c : _s) c = (char)tolower((unsigned char)c); }
+  long toInt() const { return atol(_s.c_str()); }
+  void reserve(unsigned int size) { _s.reserve(size); }
+
+  String& operator+=(const String& other) { _s += other._s; return *this; }
+  String& operator+=(const char* other) { _s += other; return *this; }
+  String& operator+=(char c) { _s += c; return *this; }
+  bool operator==(const String& other) const { return _s == other._s; }
+  bool operator==(const char* other) const { return _s == (other ? other : ""); }
+  bool operator!=(const String& other) const { return _s != other._s; }
+  bool operator!=(const char* other) const { return !(*this == other); }
+
+private:
+  std::string _s;
+  static int find(size_t pos) { return pos == std::string::npos ? -1 : (int)pos; }
+};
+
+inline String operator+(const String& a, const String& b) { String s(a); s += b; return s; }
+inline String operator+(const String& a, const char* b) { String s(a); s += b; return s; }
+inline String operator+(const char* a, const String& b) { String s(a); s += b; return s; }
+
+class Print {
+public:
+  virtual ~Print() {}
+  virtual size_t write(uint8_t c) { return write(&c, 1); }
+  virtual size_t write(const uint8_t* buffer, size_t size) { (void)buffer; return size; }
+  size_t write(const char* s) { return write((const uint8_t*)s, strlen(s)); }
+  size_t write(const char* s, size_t size) { return write((const uint8_t*)s, size); }
+  size_t print(const char* s) { return write(s); }
+  size_t print(const String& s) { return write(s.c_str()); }
+  size_t println(const char* s = "") { return write(s) + write("\r\n"); }
+  size_t println(const String& s) { return println(s.c_str()); }
+  size_t printf(const char* format, ...) __attribute__((format(printf, 2, 3)));
+  virtual void flush() {}
+};
+
+class Stream : public Print {
+public:
+  virtual int available() { return 0; }
+  virtual int read() { return -1; }
+  void setTimeout(unsigned long timeout) { (void)timeout; }
+};
+
+// Writes to the host's stdout.
+class HardwareSerial : public Stream {
+public:
+  void begin(unsigned long baud) { (void)baud; }
+  using Print::write;
+  size_t write(const uint8_t* buffer, size_t size) override;
+  operator bool() const { return true; }
+};
+extern HardwareSerial Serial;
+
+class IPAddress {
+public:
+  IPAddress() : _address(0) {}
+  IPAddress(uint8_t a, uint8_t b, uint8_t c, uint8_t d) : _address(0) {
+    _bytes()[0] = a; _bytes()[1] = b; _bytes()[2] = c; _bytes()[3] = d;
+  }
+  IPAddress(uint32_t address) : _address(address) {}
+  operator uint32_t() const { return _address; }
+  uint8_t operator[](int i) const { return ((const uint8_t*)&_address)[i]; }
+  uint8_t& operator[](int i) { return _bytes()[i]; }
+  bool operator==(const IPAddress& other) const { return _address == other._address; }
+  bool operator!=(const IPAddress& other) const { return _address != other._address; }
+  String toString() const {
+    char buf[16];
+    snprintf(buf, sizeof(buf), "%u.%u.%u.%u", (*this)[0], (*this)[1], (*this)[2], (*this)[3]);
+    return String(buf);
+  }
+
+private:
+  uint32_t _address;  // Network byte order, as on the ESP32
+  uint8_t* _bytes() { return (uint8_t*)&_address; }
+};
+
+unsigned long millis();
+unsigned long micros();
+void delay(uint32_t ms);
+void yield();
+uint32_t esp_random();
+// glibc ships strlcpy from 2.38 on.
+#if defined(__GLIBC__) && (__GLIBC__ < 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ < 38))
+#define ALOO_HOST_STRLCPY
+extern "C" size_t strlcpy(char* dst, const char* src, size_t size);
+#endif
+
+#define constrain(amt, low, high) ((amt) < (low) ? (low) : ((amt) > (high) ? (high) : (amt)))
+inline bool isDigit(char c) { return c >= '0' && c <= '9'; }
+
+#include "freertos/FreeRTOS.h"
+#include "esp_arduino_version.h"
+
+#endif // ALOO_HOST_ARDUINO_H
@@ -0,0 +1,8 @@
+#ifndef ALOO_HOST_FS_H
+#define ALOO_HOST_FS_H
+
+namespace fs {
+class FS {};
+}  // namespace fs
+
+#endif // ALOO_HOST_FS_H
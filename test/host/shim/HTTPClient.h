@@ -0,0 +1,8 @@
+#ifndef ALOO_HOST_HTTPCLIENT_H
+#define ALOO_HOST_HTTPCLIENT_H
+
+#include <WiFi.h>
+
+#define HTTP_CODE_OK 200
+
+#endif // ALOO_HOST_HTTPCLIENT_H
@@ -0,0 +1,461 @@
+// Definitions behind the host shim headers. Kernel objects are built on the
+// standard library's threading primitives; time is the host's steady clock.
+
+#include <Arduino.h>
+#include <WiFi.h>
+#include <Preferences.h>
+#include <esp_netif.h>
+#include <esp_netif_net_stack.h>
+#include <lwip/dhcp.h>
+#include <lwip/tcpip.h>
+#include "freertos/task.h"
+#include "freertos/queue.h"
+#include "freertos/semphr.h"
+#include "freertos/event_groups.h"
+#include "freertos/timers.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <random>
+#include <stdarg.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+//--------------------------------------------------------------------------
+// Arduino Core
+//--------------------------------------------------------------------------
+
+HardwareSerial Serial;
+WiFiClass WiFi;
+
+namespace {
+
+const std::chrono::steady_clock::time_point bootTime = std::chrono::steady_clock::now();
+
+std::chrono::steady_clock::duration uptime() {
+  return std::chrono::steady_clock::now() - bootTime;
+}
+
+// Waits on cv for at most ticks (1 ms each) or forever, until done() holds.
+template <typename Predicate>
+bool waitTicks(std::condition_variable& cv, std::unique_lock<std::mutex>& lock, TickType_t ticks, Predicate done) {
+  if (ticks == portMAX_DELAY) {
+    cv.wait(lock, done);
+    return true;
+  }
+  return cv.wait_for(lock, std::chrono::milliseconds(ticks), done);
+}
+
+}  // namespace
+
+unsigned long millis() {
+  return (unsigned long)std::chrono::duration_cast<std::chrono::milliseconds>(uptime()).count();
+}
+
+unsigned long micros() {
+  return (unsigned long)std::chrono::duration_cast<std::chrono::microseconds>(uptime()).count();
+}
+
+void delay(uint32_t ms) {
+  std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+}
+
+void yield() {
+  std::this_thread::yield();
+}
+
+uint32_t esp_random() {
+  static std::mt19937 generator(std::random_device{}());
+  static std::mutex lock;
+  std::lock_guard<std::mutex> guard(lock);
+  return generator();
+}
+
+#ifdef ALOO_HOST_STRLCPY
+extern "C" size_t strlcpy(char* dst, const char* src, size_t size) {
+  size_t length = strlen(src);
+  if (size) {
+    size_t n = length < size - 1 ? length : size - 1;
+    memcpy(dst, src, n);
+    dst[n] = '\0';
+  }
+  return length;
+}
+#endif
+
+size_t Print::printf(const char* format, ...) {
+  char buf[256];
+  va_list args;
+  va_start(args, format);
+  int n = vsnprintf(buf, sizeof(buf), format, args);
+  va_end(args);
+  return n > 0 ? write((const uint8_t*)buf, min((size_t)n, sizeof(buf) - 1)) : 0;
+}
+
+size_t HardwareSerial::write(const uint8_t* buffer, size_t size) {
+  return fwrite(buffer, 1, size, stdout);
+}
+
+//--------------------------------------------------------------------------
+// Preferences
+//--------------------------------------------------------------------------
+
+namespace {
+
+enum class PrefType : uint8_t { U8, STR, BLOB };
+
+struct PrefEntry {
+  PrefType type;
+  std::string value;
+};
+
+std::mutex prefsLock;
+std::map<std::string, std::map<std::string, PrefEntry>> prefsStore;
+
+}  // namespace
+
+void hostPreferencesErase() {
+  std::lock_guard<std::mutex> guard(prefsLock);
+  prefsStore.clear();
+}
+
+bool Preferences::begin(const char* name, bool readOnly, const char* partition) {
+  (void)partition;
+  std::lock_guard<std::mutex> guard(prefsLock);
+  if (_open) return false;
+  // NVS will not open a missing namespace read-only.
+  if (readOnly && !prefsStore.count(name)) return false;
+  prefsStore[name];
+  _namespace = name;
+  _readOnly = readOnly;
+  _open = true;
+  return true;
+}
+
+void Preferences::end() {
+  _open = false;
+}
+
+bool Preferences::clear() {
+  std::lock_guard<std::mutex> guard(prefsLock);
+  if (!_open || _readOnly) return false;
+  prefsStore[_namespace.c_str()].clear();
+  return true;
+}
+
+bool Preferences::remove(const char* key) {
+  std::lock_guard<std::mutex> guard(prefsLock);
+  if (!_open || _readOnly) return false;
+  return prefsStore[_namespace.c_str()].erase(key) != 0;
+}
+
+bool Preferences::isKey(const char* key) {
+  std::lock_guard<std::mutex> guard(prefsLock);
+  return _open && prefsStore[_namespace.c_str()].count(key) != 0;
+}
+
+namespace {
+
+size_t putEntry(const String& ns, bool open, bool readOnly, const char* key, PrefType type, const void* value,
+                size_t length) {
+  std::lock_guard<std::mutex> guard(prefsLock);
+  if (!open || readOnly) return 0;
+  prefsStore[ns.c_str()][key] = PrefEntry{ type, std::string((const char*)value, length) };
+  return length;
+}
+
+const PrefEntry* findEntry(const String& ns, bool open, const char* key, PrefType type) {
+  if (!open) return nullptr;
+  std::map<std::string, PrefEntry>& keys = prefsStore[ns.c_str()];
+  std::map<std::string, PrefEntry>::const_iterator it = keys.find(key);
+  return it != keys.end() && it->second.type == type ? &it->second : nullptr;
+}
+
+}  // namespace
+
+size_t Preferences::putBytes(const char* key, const void* value, size_t length) {
+  return putEntry(_namespace, _open, _readOnly, key, PrefType::BLOB, value, length);
+}
+
+size_t Preferences::getBytes(const char* key, void* buffer, size_t length) {
+  std::lock_guard<std::mutex> guard(prefsLock);
+  const PrefEntry* entry = findEntry(_namespace, _open, key, PrefType::BLOB);
+  // As on the device, a blob larger than the buffer is not read at all.
+  if (!entry || entry->value.size() > length) return 0;
+  memcpy(buffer, entry->value.data(), entry->value.size());
+  return entry->value.size();
+}
+
+size_t Preferences::getBytesLength(const char* key) {
+  std::lock_guard<std::mutex> guard(prefsLock);
+  const PrefEntry* entry = findEntry(_namespace, _open, key, PrefType::BLOB);
+  return entry ? entry->value.size() : 0;
+}
+
+size_t Preferences::putString(const char* key, const String& value) {
+  return putEntry(_namespace, _open, _readOnly, key, PrefType::STR, value.c_str(), value.length());
+}
+
+String Preferences::getString(const char* key, const String& defaultValue) {
+  std::lock_guard<std::mutex> guard(prefsLock);
+  const PrefEntry* entry = findEntry(_namespace, _open, key, PrefType::STR);
+  return entry ? String(entry->value) : defaultValue;
+}
+
+size_t Preferences::putUChar(const char* key, uint8_t value) {
+  return putEntry(_namespace, _open, _readOnly, key, PrefType::U8, &value, 1);
+}
+
+uint8_t Preferences::getUChar(const char* key, uint8_t defaultValue) {
+  std::lock_guard<std::mutex> guard(prefsLock);
+  const PrefEntry* entry = findEntry(_namespace, _open, key, PrefType::U8);
+  return entry ? (uint8_t)entry->value[0] : defaultValue;
+}
+
+//--------------------------------------------------------------------------
+// FreeRTOS: Critical Sections and Tasks
+//--------------------------------------------------------------------------
+
+void vPortEnterCritical(portMUX_TYPE* mux) {
+  int unlocked = 0;
+  while (!__atomic_compare_exchange_n(&mux->owner, &unlocked, 1, false, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED)) {
+    unlocked = 0;
+    std::this_thread::yield();
+  }
+}
+
+void vPortExitCritical(portMUX_TYPE* mux) {
+  __atomic_store_n(&mux->owner, 0, __ATOMIC_RELEASE);
+}
+
+struct tskTaskControlBlock {
+  int reserved;
+};
+
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t function, const char* name, uint32_t stackDepth, void* param,
+                                   UBaseType_t priority, TaskHandle_t* handle, BaseType_t core) {
+  (void)function; (void)name; (void)stackDepth; (void)param; (void)priority; (void)core;
+  if (handle) *handle = nullptr;
+  return pdFAIL;
+}
+
+void vTaskDelete(TaskHandle_t task) { (void)task; }
+void vTaskSuspend(TaskHandle_t task) { (void)task; }
+void vTaskResume(TaskHandle_t task) { (void)task; }
+
+void vTaskDelay(TickType_t ticks) {
+  delay(ticks);
+}
+
+TickType_t xTaskGetTickCount() {
+  return (TickType_t)millis();
+}
+
+TaskHandle_t xTaskGetCurrentTaskHandle() {
+  thread_local tskTaskControlBlock self;
+  return &self;
+}
+
+UBaseType_t uxTaskGetStackHighWaterMark(TaskHandle_t task) { (void)task; return 0; }
+UBaseType_t uxTaskPriorityGet(TaskHandle_t task) { (void)task; return tskIDLE_PRIORITY; }
+void vTaskPrioritySet(TaskHandle_t task, UBaseType_t priority) { (void)task; (void)priority; }
+BaseType_t xTaskNotifyGive(TaskHandle_t task) { (void)task; return pdPASS; }
+BaseType_t xTaskNotifyStateClear(TaskHandle_t task) { (void)task; return pdFALSE; }
+
+BaseType_t xTaskNotifyWait(uint32_t clearOnEntry, uint32_t clearOnExit, uint32_t* value, TickType_t ticks) {
+  (void)clearOnEntry; (void)clearOnExit;
+  if (value) *value = 0;
+  if (ticks != portMAX_DELAY) vTaskDelay(ticks);
+  return pdFALSE;
+}
+
+uint32_t ulTaskNotifyTake(BaseType_t clearOnExit, TickType_t ticks) {
+  (void)clearOnExit;
+  if (ticks != portMAX_DELAY) vTaskDelay(ticks);
+  return 0;
+}
+
+//--------------------------------------------------------------------------
+// FreeRTOS: Queues and Semaphores
+//--------------------------------------------------------------------------
+
+struct QueueDefinition {
+  std::mutex lock;
+  std::condition_variable changed;
+  std::deque<std::vector<uint8_t>> items;
+  size_t length;
+  size_t itemSize;
+};
+
+QueueHandle_t xQueueCreate(UBaseType_t length, UBaseType_t itemSize) {
+  QueueDefinition* queue = new QueueDefinition();
+  queue->length = length;
+  queue->itemSize = itemSize;
+  return queue;
+}
+
+BaseType_t xQueueSend(QueueHandle_t queue, const void* item, TickType_t ticks) {
+  std::unique_lock<std::mutex> lock(queue->lock);
+  if (!waitTicks(queue->changed, lock, ticks, [queue]() { return queue->items.size() < queue->length; })) {
+    return pdFALSE;
+  }
+  const uint8_t* bytes = static_cast<const uint8_t*>(item);
+  queue->items.emplace_back(bytes, bytes + queue->itemSize);
+  queue->changed.notify_all();
+  return pdTRUE;
+}
+
+BaseType_t xQueueReceive(QueueHandle_t queue, void* item, TickType_t ticks) {
+  std::unique_lock<std::mutex> lock(queue->lock);
+  if (!waitTicks(queue->changed, lock, ticks, [queue]() { return !queue->items.empty(); })) return pdFALSE;
+  if (queue->itemSize) memcpy(item, queue->items.front().data(), queue->itemSize);
+  queue->items.pop_front();
+  queue->changed.notify_all();
+  return pdTRUE;
+}
+
+UBaseType_t uxQueueMessagesWaiting(QueueHandle_t queue) {
+  std::lock_guard<std::mutex> guard(queue->lock);
+  return (UBaseType_t)queue->items.size();
+}
+
+void vQueueDelete(QueueHandle_t queue) {
+  delete queue;
+}
+
+SemaphoreHandle_t xSemaphoreCreateMutex() {
+  SemaphoreHandle_t mutex = xQueueCreate(1, 0);
+  xQueueSend(mutex, nullptr, 0);
+  return mutex;
+}
+
+SemaphoreHandle_t xSemaphoreCreateBinary() {
+  return xQueueCreate(1, 0);
+}
+
+BaseType_t xSemaphoreTake(SemaphoreHandle_t semaphore, TickType_t ticks) {
+  return xQueueReceive(semaphore, nullptr, ticks);
+}
+
+BaseType_t xSemaphoreGive(SemaphoreHandle_t semaphore) {
+  return xQueueSend(semaphore, nullptr, 0);
+}
+
+void vSemaphoreDelete(SemaphoreHandle_t semaphore) {
+  vQueueDelete(semaphore);
+}
+
+//--------------------------------------------------------------------------
+// FreeRTOS: Event Groups and Timers
+//--------------------------------------------------------------------------
+
+struct EventGroupDef_t {
+  std::mutex lock;
+  std::condition_variable changed;
+  EventBits_t bits = 0;
+};
+
+EventGroupHandle_t xEventGroupCreate() {
+  return new EventGroupDef_t();
+}
+
+EventBits_t xEventGroupSetBits(EventGroupHandle_t group, EventBits_t bits) {
+  std::lock_guard<std::mutex> guard(group->lock);
+  group->bits |= bits;
+  group->changed.notify_all();
+  return group->bits;
+}
+
+EventBits_t xEventGroupClearBits(EventGroupHandle_t group, EventBits_t bits) {
+  std::lock_guard<std::mutex> guard(group->lock);
+  EventBits_t previous = group->bits;
+  group->bits &= ~bits;
+  return previous;
+}
+
+EventBits_t xEventGroupGetBits(EventGroupHandle_t group) {
+  std::lock_guard<std::mutex> guard(group->lock);
+  return group->bits;
+}
+
+EventBits_t xEventGroupWaitBits(EventGroupHandle_t group, EventBits_t bits, BaseType_t clearOnExit,
+                                BaseType_t waitForAll, TickType_t ticks) {
+  std::unique_lock<std::mutex> lock(group->lock);
+  bool met = waitTicks(group->changed, lock, ticks, [group, bits, waitForAll]() {
+    return waitForAll ? (group->bits & bits) == bits : (group->bits & bits) != 0;
+  });
+  EventBits_t result = group->bits;
+  if (met && clearOnExit) group->bits &= ~bits;
+  return result;
+}
+
+void vEventGroupDelete(EventGroupHandle_t group) {
+  delete group;
+}
+
+struct tmrTimerControl {
+  void* id;
+  bool active;
+};
+
+TimerHandle_t xTimerCreate(const char* name, TickType_t period, UBaseType_t autoReload, void* id,
+                           TimerCallbackFunction_t callback) {
+  (void)name; (void)period; (void)autoReload; (void)callback;
+  return new tmrTimerControl{ id, false };
+}
+
+BaseType_t xTimerStart(TimerHandle_t timer, TickType_t ticks) { (void)ticks; timer->active = true; return pdPASS; }
+BaseType_t xTimerStop(TimerHandle_t timer, TickType_t ticks) { (void)ticks; timer->active = false; return pdPASS; }
+BaseType_t xTimerReset(TimerHandle_t timer, TickType_t ticks) { return xTimerStart(timer, ticks); }
+
+BaseType_t xTimerChangePeriod(TimerHandle_t timer, TickType_t period, TickType_t ticks) {
+  (void)period;
+  return xTimerStart(timer, ticks);
+}
+
+BaseType_t xTimerDelete(TimerHandle_t timer, TickType_t ticks) {
+  (void)ticks;
+  delete timer;
+  return pdPASS;
+}
+
+BaseType_t xTimerIsTimerActive(TimerHandle_t timer) { return timer->active ? pdTRUE : pdFALSE; }
+void* pvTimerGetTimerID(TimerHandle_t timer) { return timer->id; }
+
+//--------------------------------------------------------------------------
+// ESP-IDF and lwIP
+//--------------------------------------------------------------------------
+
+esp_err_t esp_wifi_init(const wifi_init_config_t* config) { (void)config; return ESP_OK; }
+esp_err_t esp_wifi_deinit() { return ESP_OK; }
+esp_err_t esp_wifi_stop() { return ESP_OK; }
+esp_err_t esp_wifi_connect() { return ESP_OK; }
+esp_err_t esp_wifi_set_storage(wifi_storage_t storage) { (void)storage; return ESP_OK; }
+
+esp_err_t esp_wifi_get_config(wifi_interface_t interface, wifi_config_t* config) {
+  (void)interface;
+  memset(config, 0, sizeof(*config));
+  return ESP_OK;
+}
+
+esp_err_t esp_wifi_set_config(wifi_interface_t interface, wifi_config_t* config) {
+  (void)interface; (void)config;
+  return ESP_OK;
+}
+
+esp_netif_t* esp_netif_get_handle_from_ifkey(const char* key) { (void)key; return nullptr; }
+void* esp_netif_get_netif_impl(esp_netif_t* netif) { (void)netif; return nullptr; }
+
+err_t dhcp_start(struct netif* netif) { (void)netif; return ERR_IF; }
+uint8_t dhcp_supplied_address(const struct netif* netif) { (void)netif; return 0; }
+const ip4_addr_t* netif_ip4_addr(const struct netif* netif) { return &netif->ip_addr; }
+const ip4_addr_t* netif_ip4_netmask(const struct netif* netif) { return &netif->netmask; }
+const ip4_addr_t* netif_ip4_gw(const struct netif* netif) { return &netif->gw; }
+
+err_t tcpip_api_call(tcpip_api_call_fn fn, struct tcpip_api_call_data* call) {
+  return fn(call);
+}
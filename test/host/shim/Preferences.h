@@ -0,0 +1,39 @@
+#ifndef ALOO_HOST_PREFERENCES_H
+#define ALOO_HOST_PREFERENCES_H
+
+//========================================================================
+// Host Preferences Shim
+//========================================================================
+// NVS stand-in: namespaces of typed keys held in process memory and shared
+// by every Preferences instance, so a second WiFiManager sees what the
+// first one wrote, as after a reboot.
+
+#include <Arduino.h>
+
+class Preferences {
+public:
+  bool begin(const char* name, bool readOnly = false, const char* partition = nullptr);
+  void end();
+
+  bool clear();
+  bool remove(const char* key);
+  bool isKey(const char* key);
+
+  size_t putBytes(const char* key, const void* value, size_t length);
+  size_t getBytes(const char* key, void* buffer, size_t length);
+  size_t getBytesLength(const char* key);
+  size_t putString(const char* key, const String& value);
+  String getString(const char* key, const String& defaultValue = String());
+  size_t putUChar(const char* key, uint8_t value);
+  uint8_t getUChar(const char* key, uint8_t defaultValue = 0);
+
+private:
+  String _namespace;
+  bool _open = false;
+  bool _readOnly = false;
+};
+
+// Erases every namespace, like a fresh flash.
+void hostPreferencesErase();
+
+#endif // ALOO_HOST_PREFERENCES_H
@@ -0,0 +1,72 @@
+#ifndef ALOO_HOST_WEBSERVER_H
+#define ALOO_HOST_WEBSERVER_H
+
+//========================================================================
+// Host WebServer Shim
+//========================================================================
+// Accepts routes and drops responses; the host tests do not serve HTTP.
+
+#include <WiFi.h>
+#include <FS.h>
+#include <functional>
+#include <vector>
+
+enum HTTPMethod { HTTP_ANY, HTTP_GET, HTTP_HEAD, HTTP_POST, HTTP_PUT, HTTP_PATCH, HTTP_DELETE, HTTP_OPTIONS };
+
+#define CONTENT_LENGTH_UNKNOWN ((size_t)-1)
+
+class WebServer;
+
+class RequestHandler {
+public:
+  virtual ~RequestHandler() {}
+  virtual bool canHandle(HTTPMethod method, String uri) { (void)method; (void)uri; return false; }
+  virtual bool handle(WebServer& server, HTTPMethod method, String uri) {
+    (void)server; (void)method; (void)uri;
+    return false;
+  }
+};
+
+class WebServer {
+public:
+  typedef std::function<void(void)> THandlerFunction;
+
+  explicit WebServer(int port = 80) { (void)port; }
+  ~WebServer() {
+    for (RequestHandler* handler : _handlers) delete handler;
+  }
+  void begin() {}
+  void stop() {}
+  void handleClient() {}
+
+  void on(const String& uri, THandlerFunction handler) { (void)uri; (void)handler; }
+  void on(const String& uri, HTTPMethod method, THandlerFunction handler) { (void)uri; (void)method; (void)handler; }
+  void addHandler(RequestHandler* handler) { _handlers.push_back(handler); }
+  void onNotFound(THandlerFunction handler) { (void)handler; }
+  void serveStatic(const char* uri, fs::FS& fs, const char* path, const char* cacheHeader = nullptr) {
+    (void)uri; (void)fs; (void)path; (void)cacheHeader;
+  }
+  void collectHeaders(const char* keys[], size_t count) { (void)keys; (void)count; }
+
+  String arg(const String& name) { (void)name; return String(); }
+  bool hasArg(const String& name) { (void)name; return false; }
+  String header(const String& name) { (void)name; return String(); }
+  String hostHeader() { return String(); }
+  WiFiClient& client() { return _client; }
+
+  void send(int code, const char* contentType = nullptr, const String& content = String()) {
+    (void)code; (void)contentType; (void)content;
+  }
+  void send_P(int code, PGM_P contentType, PGM_P content, size_t length) {
+    (void)code; (void)contentType; (void)content; (void)length;
+  }
+  void sendHeader(const String& name, const String& value, bool first = false) { (void)name; (void)value; (void)first; }
+  void setContentLength(size_t length) { (void)length; }
+  void sendContent(const char* content, size_t length) { (void)content; (void)length; }
+
+private:
+  std::vector<RequestHandler*> _handlers;  // Owned, as in the core
+  WiFiClient _client;
+};
+
+#endif // ALOO_HOST_WEBSERVER_H
@@ -0,0 +1,137 @@
+#ifndef ALOO_HOST_WIFI_H
+#define ALOO_HOST_WIFI_H
+
+//========================================================================
+// Host WiFi Shim
+//========================================================================
+// The Arduino WiFi API with no radio behind it: the station never
+// associates, scans find nothing and no event is ever raised. The tests feed
+// the manager's event paths directly instead.
+
+#include <Arduino.h>
+#include "esp_wifi.h"
+#include "esp_wifi_types.h"
+
+typedef enum {
+  ARDUINO_EVENT_WIFI_READY = 0,
+  ARDUINO_EVENT_WIFI_SCAN_DONE,
+  ARDUINO_EVENT_WIFI_STA_START,
+  ARDUINO_EVENT_WIFI_STA_STOP,
+  ARDUINO_EVENT_WIFI_STA_CONNECTED,
+  ARDUINO_EVENT_WIFI_STA_DISCONNECTED,
+  ARDUINO_EVENT_WIFI_STA_AUTHMODE_CHANGE,
+  ARDUINO_EVENT_WIFI_STA_GOT_IP,
+  ARDUINO_EVENT_WIFI_STA_GOT_IP6,
+  ARDUINO_EVENT_WIFI_STA_LOST_IP,
+  ARDUINO_EVENT_WIFI_AP_START,
+  ARDUINO_EVENT_WIFI_AP_STOP,
+  ARDUINO_EVENT_WIFI_AP_STACONNECTED,
+  ARDUINO_EVENT_WIFI_AP_STADISCONNECTED,
+  ARDUINO_EVENT_WIFI_AP_STAIPASSIGNED,
+  ARDUINO_EVENT_WIFI_AP_PROBEREQRECVED,
+  ARDUINO_EVENT_MAX
+} arduino_event_id_t;
+typedef arduino_event_id_t WiFiEvent_t;
+
+typedef union {
+  wifi_event_sta_scan_done_t wifi_scan_done;
+  wifi_event_sta_connected_t wifi_sta_connected;
+  wifi_event_sta_disconnected_t wifi_sta_disconnected;
+  ip_event_got_ip_t got_ip;
+  wifi_event_ap_staconnected_t wifi_ap_staconnected;
+  wifi_event_ap_staconnected_t wifi_ap_stadisconnected;
+} arduino_event_info_t;
+typedef arduino_event_info_t WiFiEventInfo_t;
+typedef void (*WiFiEventSysCb)(arduino_event_id_t event, arduino_event_info_t info);
+typedef size_t wifi_event_id_t;
+
+typedef enum {
+  WL_NO_SHIELD = 255,
+  WL_IDLE_STATUS = 0,
+  WL_NO_SSID_AVAIL,
+  WL_SCAN_COMPLETED,
+  WL_CONNECTED,
+  WL_CONNECT_FAILED,
+  WL_CONNECTION_LOST,
+  WL_DISCONNECTED
+} wl_status_t;
+
+#define WIFI_SCAN_RUNNING (-1)
+#define WIFI_SCAN_FAILED (-2)
+#define WIFI_AP WIFI_MODE_AP
+#define WIFI_STA WIFI_MODE_STA
+#define WIFI_AP_STA WIFI_MODE_APSTA
+#define WIFI_OFF WIFI_MODE_NULL
+
+class WiFiClient : public Stream {
+public:
+  using Print::write;
+  size_t write(const uint8_t* buffer, size_t size) override { (void)buffer; return size; }
+  void stop() {}
+  uint8_t connected() { return 0; }
+  operator bool() { return false; }
+};
+
+class WiFiClass {
+public:
+  wifi_event_id_t onEvent(WiFiEventSysCb callback, arduino_event_id_t event = ARDUINO_EVENT_MAX) {
+    (void)callback; (void)event;
+    return 0;
+  }
+  void removeEvent(wifi_event_id_t id) { (void)id; }
+
+  wl_status_t begin(const char* ssid, const char* passphrase = nullptr, int32_t channel = 0,
+                    const uint8_t* bssid = nullptr, bool connect = true) {
+    (void)ssid; (void)passphrase; (void)channel; (void)bssid; (void)connect;
+    return WL_DISCONNECTED;
+  }
+  bool config(IPAddress local, IPAddress gateway, IPAddress subnet, IPAddress dns1 = (uint32_t)0,
+              IPAddress dns2 = (uint32_t)0) {
+    (void)local; (void)gateway; (void)subnet; (void)dns1; (void)dns2;
+    return true;
+  }
+  bool disconnect(bool wifiOff = false, bool eraseAp = false) { (void)wifiOff; (void)eraseAp; return true; }
+  bool setAutoReconnect(bool enabled) { (void)enabled; return true; }
+  bool setAutoConnect(bool enabled) { (void)enabled; return true; }
+  void persistent(bool enabled) { (void)enabled; }
+  bool mode(wifi_mode_t mode) { _mode = mode; return true; }
+  wifi_mode_t getMode() { return _mode; }
+  bool enableAP(bool enabled) {
+    _mode = (wifi_mode_t)(enabled ? (_mode | WIFI_MODE_AP) : (_mode & ~WIFI_MODE_AP));
+    return true;
+  }
+  wl_status_t status() { return WL_DISCONNECTED; }
+  bool setSleep(wifi_ps_type_t type) { (void)type; return true; }
+
+  bool softAP(const char* ssid, const char* passphrase = nullptr, int channel = 1, int hidden = 0,
+              int maxConnections = 4, bool ftm = false) {
+    (void)ssid; (void)passphrase; (void)channel; (void)hidden; (void)maxConnections; (void)ftm;
+    return true;
+  }
+  bool softAPdisconnect(bool wifiOff = false) { (void)wifiOff; return true; }
+  uint8_t softAPgetStationNum() { return 0; }
+  IPAddress softAPIP() { return IPAddress(192, 168, 4, 1); }
+
+  String SSID() const { return String(); }
+  uint8_t* BSSID() { return nullptr; }
+  int32_t channel() { return 0; }
+  IPAddress localIP() { return IPAddress(); }
+  IPAddress gatewayIP() { return IPAddress(); }
+  IPAddress subnetMask() { return IPAddress(); }
+  IPAddress dnsIP(uint8_t index = 0) { (void)index; return IPAddress(); }
+
+  int16_t scanNetworks(bool async = false, bool showHidden = false, bool passive = false, uint32_t maxMsPerChannel = 300,
+                       uint8_t channel = 0, const char* ssid = nullptr, const uint8_t* bssid = nullptr) {
+    (void)async; (void)showHidden; (void)passive; (void)maxMsPerChannel; (void)channel; (void)ssid; (void)bssid;
+    return 0;
+  }
+  int16_t scanComplete() { return 0; }
+  void* getScanInfoByIndex(int index) { (void)index; return nullptr; }
+  void scanDelete() {}
+
+private:
+  wifi_mode_t _mode = WIFI_MODE_NULL;
+};
+extern WiFiClass WiFi;
+
+#endif // ALOO_HOST_WIFI_H
@@ -0,0 +1,11 @@
+#ifndef ALOO_HOST_ESP_ARDUINO_VERSION_H
+#define ALOO_HOST_ESP_ARDUINO_VERSION_H
+
+// The shim follows the 2.0.x core the library targets.
+#define ESP_ARDUINO_VERSION_VAL(major, minor, patch) (((major) << 16) | ((minor) << 8) | (patch))
+#define ESP_ARDUINO_VERSION_MAJOR 2
+#define ESP_ARDUINO_VERSION_MINOR 0
+#define ESP_ARDUINO_VERSION_PATCH 14
+#define ESP_ARDUINO_VERSION ESP_ARDUINO_VERSION_VAL(2, 0, 14)
+
+#endif // ALOO_HOST_ESP_ARDUINO_VERSION_H
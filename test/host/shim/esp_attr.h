@@ -0,0 +1,7 @@
+#ifndef ALOO_HOST_ESP_ATTR_H
+#define ALOO_HOST_ESP_ATTR_H
+
+// Host memory does not survive a restart, so RTC retention is plain RAM.
+#define RTC_NOINIT_ATTR
+
+#endif // ALOO_HOST_ESP_ATTR_H
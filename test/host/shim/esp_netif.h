@@ -0,0 +1,9 @@
+#ifndef ALOO_HOST_ESP_NETIF_H
+#define ALOO_HOST_ESP_NETIF_H
+
+typedef struct esp_netif_obj esp_netif_t;
+
+// No interface exists on the host: always nullptr.
+esp_netif_t* esp_netif_get_handle_from_ifkey(const char* key);
+
+#endif // ALOO_HOST_ESP_NETIF_H
@@ -0,0 +1,24 @@
+#ifndef ALOO_HOST_ESP_WIFI_H
+#define ALOO_HOST_ESP_WIFI_H
+
+#include "esp_wifi_types.h"
+
+typedef int esp_err_t;
+#define ESP_OK 0
+#define ESP_FAIL -1
+
+typedef struct {
+  int reserved;
+} wifi_init_config_t;
+#define WIFI_INIT_CONFIG_DEFAULT() wifi_init_config_t{0}
+
+// The driver calls succeed and change nothing; no radio exists on the host.
+esp_err_t esp_wifi_init(const wifi_init_config_t* config);
+esp_err_t esp_wifi_deinit();
+esp_err_t esp_wifi_stop();
+esp_err_t esp_wifi_connect();
+esp_err_t esp_wifi_set_storage(wifi_storage_t storage);
+esp_err_t esp_wifi_get_config(wifi_interface_t interface, wifi_config_t* config);
+esp_err_t esp_wifi_set_config(wifi_interface_t interface, wifi_config_t* config);
+
+#endif // ALOO_HOST_ESP_WIFI_H
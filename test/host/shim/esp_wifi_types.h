@@ -0,0 +1,36 @@
+#ifndef ALOO_HOST_ESP_WIFI_TYPES_H
+#define ALOO_HOST_ESP_WIFI_TYPES_H
+
+// ESP-IDF 4.4 WiFi types, trimmed to the fields the library reads.
+
+#include <cstdint>
+
+typedef enum { WIFI_MODE_NULL=0, WIFI_MODE_STA, WIFI_MODE_AP, WIFI_MODE_APSTA } wifi_mode_t;
+typedef enum { WIFI_IF_STA=0, WIFI_IF_AP } wifi_interface_t;
+typedef enum { WIFI_PS_NONE, WIFI_PS_MIN_MODEM, WIFI_PS_MAX_MODEM } wifi_ps_type_t;
+typedef enum { WIFI_AUTH_OPEN=0, WIFI_AUTH_WEP, WIFI_AUTH_WPA_PSK, WIFI_AUTH_WPA2_PSK, WIFI_AUTH_WPA_WPA2_PSK, WIFI_AUTH_WPA2_ENTERPRISE, WIFI_AUTH_WPA3_PSK, WIFI_AUTH_WPA2_WPA3_PSK, WIFI_AUTH_WAPI_PSK, WIFI_AUTH_MAX } wifi_auth_mode_t;
+typedef enum { WIFI_STORAGE_FLASH, WIFI_STORAGE_RAM } wifi_storage_t;
+typedef enum {
+  WIFI_REASON_UNSPECIFIED=1, WIFI_REASON_AUTH_EXPIRE=2, WIFI_REASON_AUTH_LEAVE=3, WIFI_REASON_ASSOC_EXPIRE=4,
+  WIFI_REASON_ASSOC_TOOMANY=5, WIFI_REASON_NOT_AUTHED=6, WIFI_REASON_NOT_ASSOCED=7, WIFI_REASON_ASSOC_LEAVE=8,
+  WIFI_REASON_ASSOC_NOT_AUTHED=9, WIFI_REASON_DISASSOC_PWRCAP_BAD=10, WIFI_REASON_DISASSOC_SUPCHAN_BAD=11,
+  WIFI_REASON_IE_INVALID=13, WIFI_REASON_MIC_FAILURE=14, WIFI_REASON_4WAY_HANDSHAKE_TIMEOUT=15,
+  WIFI_REASON_GROUP_KEY_UPDATE_TIMEOUT=16, WIFI_REASON_IE_IN_4WAY_DIFFERS=17, WIFI_REASON_GROUP_CIPHER_INVALID=18,
+  WIFI_REASON_PAIRWISE_CIPHER_INVALID=19, WIFI_REASON_AKMP_INVALID=20, WIFI_REASON_UNSUPP_RSN_IE_VERSION=21,
+  WIFI_REASON_INVALID_RSN_IE_CAP=22, WIFI_REASON_802_1X_AUTH_FAILED=23, WIFI_REASON_CIPHER_SUITE_REJECTED=24,
+  WIFI_REASON_BEACON_TIMEOUT=200, WIFI_REASON_NO_AP_FOUND=201, WIFI_REASON_AUTH_FAIL=202, WIFI_REASON_ASSOC_FAIL=203,
+  WIFI_REASON_HANDSHAKE_TIMEOUT=204, WIFI_REASON_CONNECTION_FAIL=205, WIFI_REASON_AP_TSF_RESET=206, WIFI_REASON_ROAMING=207
+} wifi_err_reason_t;
+typedef struct { uint8_t ssid[32]; uint8_t password[64]; uint8_t bssid_set; uint8_t bssid[6]; uint8_t channel; uint16_t listen_interval; } wifi_sta_config_t;
+typedef struct { uint8_t ssid[32]; uint8_t password[64]; uint8_t channel; } wifi_ap_config_t;
+typedef union { wifi_ap_config_t ap; wifi_sta_config_t sta; } wifi_config_t;
+typedef struct { uint8_t ssid[32]; uint8_t ssid_len; uint8_t bssid[6]; uint8_t reason; } wifi_event_sta_disconnected_t;
+typedef struct { uint8_t ssid[32]; uint8_t ssid_len; uint8_t bssid[6]; uint8_t channel; } wifi_event_sta_connected_t;
+typedef struct { uint32_t status; uint8_t number; } wifi_event_sta_scan_done_t;
+typedef struct { uint8_t mac[6]; } wifi_event_ap_staconnected_t;
+typedef struct { uint32_t addr; } esp_ip4_addr_t;
+typedef struct { esp_ip4_addr_t ip, netmask, gw; } esp_netif_ip_info_t;
+typedef struct { esp_netif_ip_info_t ip_info; bool ip_changed; } ip_event_got_ip_t;
+typedef struct { uint8_t bssid[6]; uint8_t ssid[33]; uint8_t primary; int second; int8_t rssi; wifi_auth_mode_t authmode; } wifi_ap_record_t;
+
+#endif // ALOO_HOST_ESP_WIFI_TYPES_H
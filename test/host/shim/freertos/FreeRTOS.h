@@ -0,0 +1,45 @@
+#ifndef ALOO_HOST_FREERTOS_H
+#define ALOO_HOST_FREERTOS_H
+
+//========================================================================
+// Host FreeRTOS Shim
+//========================================================================
+// The kernel objects the library creates (mutexes, queues, event groups,
+// timers) backed by std::mutex and std::condition_variable, with a 1 ms
+// tick. Tasks are not started on the host: the tests drive the manager's
+// internals directly, so the static allocation and run-time stats APIs are
+// left out as well.
+
+#include <cstdint>
+#include <cstddef>
+
+typedef int BaseType_t;
+typedef unsigned int UBaseType_t;
+typedef uint32_t TickType_t;
+typedef uint32_t StackType_t;
+
+#define pdTRUE 1
+#define pdFALSE 0
+#define pdPASS pdTRUE
+#define pdFAIL pdFALSE
+#define portMAX_DELAY ((TickType_t)0xFFFFFFFFUL)
+#define portTICK_PERIOD_MS 1
+#define pdMS_TO_TICKS(ms) ((TickType_t)(ms))
+#define tskNO_AFFINITY 0x7FFFFFFF
+#define tskIDLE_PRIORITY 0
+#define configMAX_PRIORITIES 25
+#define configUSE_TRACE_FACILITY 0
+#define configGENERATE_RUN_TIME_STATS 0
+#define portNUM_PROCESSORS 2
+
+// Spinlock taken by portENTER_CRITICAL(); never held across a blocking call.
+typedef struct {
+  volatile int owner;
+} portMUX_TYPE;
+#define portMUX_INITIALIZER_UNLOCKED {0}
+void vPortEnterCritical(portMUX_TYPE* mux);
+void vPortExitCritical(portMUX_TYPE* mux);
+#define portENTER_CRITICAL(mux) vPortEnterCritical(mux)
+#define portEXIT_CRITICAL(mux) vPortExitCritical(mux)
+
+#endif // ALOO_HOST_FREERTOS_H
@@ -0,0 +1,16 @@
+#ifndef ALOO_HOST_FREERTOS_SEMPHR_H
+#define ALOO_HOST_FREERTOS_SEMPHR_H
+
+#include "queue.h"
+
+// As in FreeRTOS, a semaphore is a queue of empty items: a mutex is created
+// holding its one item, a binary semaphore empty.
+typedef QueueHandle_t SemaphoreHandle_t;
+
+SemaphoreHandle_t xSemaphoreCreateMutex();
+SemaphoreHandle_t xSemaphoreCreateBinary();
+BaseType_t xSemaphoreTake(SemaphoreHandle_t semaphore, TickType_t ticks);
+BaseType_t xSemaphoreGive(SemaphoreHandle_t semaphore);
+void vSemaphoreDelete(SemaphoreHandle_t semaphore);
+
+#endif // ALOO_HOST_FREERTOS_SEMPHR_H
@@ -0,0 +1,10 @@
+#ifndef ALOO_HOST_LWIP_DHCP_H
+#define ALOO_HOST_LWIP_DHCP_H
+
+#include "lwip/err.h"
+#include "lwip/netif.h"
+
+err_t dhcp_start(struct netif* netif);
+uint8_t dhcp_supplied_address(const struct netif* netif);
+
+#endif // ALOO_HOST_LWIP_DHCP_H
@@ -0,0 +1,8 @@
+#ifndef ALOO_HOST_LWIP_ERR_H
+#define ALOO_HOST_LWIP_ERR_H
+
+typedef signed char err_t;
+#define ERR_OK 0
+#define ERR_IF -12
+
+#endif // ALOO_HOST_LWIP_ERR_H
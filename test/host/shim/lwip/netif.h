@@ -0,0 +1,20 @@
+#ifndef ALOO_HOST_LWIP_NETIF_H
+#define ALOO_HOST_LWIP_NETIF_H
+
+#include <cstdint>
+
+typedef struct {
+  uint32_t addr;
+} ip4_addr_t;
+
+struct netif {
+  ip4_addr_t ip_addr;
+  ip4_addr_t netmask;
+  ip4_addr_t gw;
+};
+
+const ip4_addr_t* netif_ip4_addr(const struct netif* netif);
+const ip4_addr_t* netif_ip4_netmask(const struct netif* netif);
+const ip4_addr_t* netif_ip4_gw(const struct netif* netif);
+
+#endif // ALOO_HOST_LWIP_NETIF_H
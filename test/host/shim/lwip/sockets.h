@@ -0,0 +1,14 @@
+#ifndef ALOO_HOST_LWIP_SOCKETS_H
+#define ALOO_HOST_LWIP_SOCKETS_H
+
+// lwIP's BSD socket API matches the host's, so the library's socket code
+// (captive DNS, reachability probes) runs against real host sockets.
+#include <sys/socket.h>
+#include <sys/select.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <errno.h>
+
+#endif // ALOO_HOST_LWIP_SOCKETS_H
@@ -0,0 +1,14 @@
+#ifndef ALOO_HOST_LWIP_TCPIP_H
+#define ALOO_HOST_LWIP_TCPIP_H
+
+#include "lwip/err.h"
+
+struct tcpip_api_call_data {
+  int reserved;
+};
+typedef err_t (*tcpip_api_call_fn)(struct tcpip_api_call_data* call);
+
+// Runs fn on the calling thread; the host has no tcpip thread.
+err_t tcpip_api_call(tcpip_api_call_fn fn, struct tcpip_api_call_data* call);
+
+#endif // ALOO_HOST_LWIP_TCPIP_H
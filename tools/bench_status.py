@@ -0,0 +1,100 @@
+#!/usr/bin/env python3
+"""Measures /status throughput of a device running examples/Benchmark.
+
+The sketch prints "BENCH status_url=<url>" once its portal is up. Join the
+bench AP from the host (or use the device's LAN address in dual mode) and
+run:
+
+    python3 tools/bench_status.py http://192.168.4.1/status [requests] [clients]
+
+Requests come from this host, so the numbers include the radio link and the
+server task's scheduling rather than a loopback round trip on the device's
+own CPU. Results are printed as "BENCH <key>=<value>" lines, in the same
+format as the sketch's serial output, so a CI job can merge both logs.
+"""
+import http.client
+import sys
+import threading
+import time
+from urllib.parse import urlsplit
+
+DEFAULT_REQUESTS = 200
+DEFAULT_CLIENTS = 1
+TIMEOUT_S = 2.0
+
+
+def fetch(host, port, path):
+    """Issues one GET on a fresh connection, like a browser polling /status."""
+    conn = http.client.HTTPConnection(host, port, timeout=TIMEOUT_S)
+    try:
+        conn.request("GET", path, headers={"Connection": "close"})
+        response = conn.getresponse()
+        response.read()
+        return response.status == 200
+    except (OSError, http.client.HTTPException):
+        return False
+    finally:
+        conn.close()
+
+
+def percentile(values, fraction):
+    if not values:
+        return 0
+    index = min(len(values) - 1, int(round(fraction * (len(values) - 1))))
+    return values[index]
+
+
+def main():
+    if len(sys.argv) < 2:
+        print(__doc__.strip())
+        return 2
+    url = urlsplit(sys.argv[1])
+    host, port, path = url.hostname, url.port or 80, url.path or "/status"
+    requests = int(sys.argv[2]) if len(sys.argv) > 2 else DEFAULT_REQUESTS
+    clients = max(1, int(sys.argv[3]) if len(sys.argv) > 3 else DEFAULT_CLIENTS)
+
+    latencies = []
+    failures = [0]
+    lock = threading.Lock()
+    remaining = [requests]
+
+    def worker():
+        while True:
+            with lock:
+                if remaining[0] == 0:
+                    return
+                remaining[0] -= 1
+            started = time.perf_counter()
+            ok = fetch(host, port, path)
+            elapsed_us = int((time.perf_counter() - started) * 1e6)
+            with lock:
+                if ok:
+                    latencies.append(elapsed_us)
+                else:
+                    failures[0] += 1
+
+    # The first request may wait for the server task to come up; keep it out of the timing.
+    fetch(host, port, path)
+    wall_started = time.perf_counter()
+    threads = [threading.Thread(target=worker) for _ in range(clients)]
+    for thread in threads:
+        thread.start()
+    for thread in threads:
+        thread.join()
+    wall_s = time.perf_counter() - wall_started
+
+    latencies.sort()
+    print("BENCH status_clients=%d" % clients)
+    print("BENCH status_requests=%d" % len(latencies))
+    print("BENCH status_failures=%d" % failures[0])
+    print("BENCH status_rps=%d" % (len(latencies) / wall_s if wall_s > 0 else 0))
+    if latencies:
+        print("BENCH status_latency_min_us=%d" % latencies[0])
+        print("BENCH status_latency_p50_us=%d" % percentile(latencies, 0.50))
+        print("BENCH status_latency_p95_us=%d" % percentile(latencies, 0.95))
+        print("BENCH status_latency_max_us=%d" % latencies[-1])
+    return 0 if latencies else 1
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,124 @@
+#!/usr/bin/env python3
+"""Embeds the captive portal files from portal/ into AlooPortalAssets.h.
+
+Each file is stored twice in PROGMEM: identity-encoded (for the rare client
+without gzip support) and gzip-compressed. Every asset gets a strong ETag
+derived from its content. Stylesheets and scripts are referenced from the
+HTML pages with their ETag as a version query, so they can be cached as
+immutable while the pages themselves are always revalidated.
+
+Run from the repository root after editing anything under portal/:
+
+    python3 tools/embed_portal_assets.py
+"""
+import gzip
+import hashlib
+import os
+import re
+import sys
+
+ROOT = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+SOURCE_DIR = os.path.join(ROOT, "portal")
+OUTPUT = os.path.join(ROOT, "AlooPortalAssets.h")
+
+CONTENT_TYPES = {
+    ".html": "text/html",
+    ".css": "text/css",
+    ".js": "application/javascript",
+    ".svg": "image/svg+xml",
+    ".png": "image/png",
+    ".ico": "image/x-icon",
+    ".json": "application/json",
+}
+
+# URIs served for a file, when they differ from "/<name>".
+ROUTES = {
+    "index.html": ["/", "/index.html"],
+    "connect.html": ["/connect"],
+}
+
+IMMUTABLE_MAX_AGE = 31536000  # One year; safe because references carry ?v=<etag>
+
+
+def identifier(name):
+    parts = re.split(r"[^0-9A-Za-z]+", name)
+    return "portal" + "".join(p[:1].upper() + p[1:] for p in parts if p)
+
+
+def etag(data):
+    return hashlib.sha256(data).hexdigest()[:16]
+
+
+def c_bytes(data):
+    lines = []
+    for i in range(0, len(data), 16):
+        lines.append("  " + ", ".join("0x%02x" % b for b in data[i:i + 16]) + ",")
+    return "\n".join(lines)
+
+
+def main():
+    files = sorted(f for f in os.listdir(SOURCE_DIR)
+                   if os.path.isfile(os.path.join(SOURCE_DIR, f)))
+    contents = {}
+    for name in files:
+        with open(os.path.join(SOURCE_DIR, name), "rb") as fp:
+            contents[name] = fp.read()
+
+    # Version the references to cacheable assets inside the pages.
+    versioned = [n for n in files if not n.endswith(".html")]
+    tags = {n: etag(contents[n]) for n in versioned}
+    for name in files:
+        if not name.endswith(".html"):
+            continue
+        text = contents[name].decode("utf-8")
+        for asset in versioned:
+            text = re.sub(r"(/%s)(['\"])" % re.escape(asset),
+                          r"\g<1>?v=%s\g<2>" % tags[asset], text)
+        contents[name] = text.encode("utf-8")
+
+    out = []
+    out.append("// Generated by tools/embed_portal_assets.py from portal/. Do not edit.")
+    out.append("#ifndef ALOO_PORTAL_ASSETS_H")
+    out.append("#define ALOO_PORTAL_ASSETS_H")
+    out.append("")
+    out.append('#include "AlooWifiManager.h"')
+    out.append("")
+
+    table = []
+    for name in files:
+        data = contents[name]
+        packed = gzip.compress(data, compresslevel=9, mtime=0)
+        ident = identifier(name)
+        ext = os.path.splitext(name)[1].lower()
+        content_type = CONTENT_TYPES.get(ext, "application/octet-stream")
+        max_age = 0 if ext == ".html" else IMMUTABLE_MAX_AGE
+        tag = etag(data)
+
+        out.append("// portal/%s (%d bytes, %d gzipped)" % (name, len(data), len(packed)))
+        out.append("static const uint8_t %s[] PROGMEM = {" % ident)
+        out.append(c_bytes(data))
+        out.append("};")
+        out.append("static const uint8_t %sGz[] PROGMEM = {" % ident)
+        out.append(c_bytes(packed))
+        out.append("};")
+        out.append("")
+
+        for route in ROUTES.get(name, ["/" + name]):
+            table.append('  { "%s", "%s", %s, sizeof(%s), %sGz, sizeof(%sGz), "\\"%s\\"", %d },'
+                         % (route, content_type, ident, ident, ident, ident, tag, max_age))
+
+    out.append("static const WiFiPortalAsset defaultPortalAssets[] = {")
+    out.extend(table)
+    out.append("};")
+    out.append("")
+    out.append("#endif // ALOO_PORTAL_ASSETS_H")
+    out.append("")
+
+    with open(OUTPUT, "w", newline="\n") as fp:
+        fp.write("\n".join(out))
+    print("Wrote %s (%d assets)" % (os.path.relpath(OUTPUT, ROOT), len(table)))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())